@@ -23,68 +23,76 @@
 // --- [모듈 연동 선언] ---
 typedef struct QuadNode QuadNode;
 extern QuadNode* create_quad_node(Rectangle boundary);
-extern void BuildQuadtreeFromBTree(BTreeNode* btree_node, QuadNode* quad_root);
+extern void BuildQuadtreeFromLiveTable(const LiveTable* live, QuadNode* quad_root);
 extern void DrawQuadtree(QuadNode* node);
 extern void FreeQuadtree(QuadNode* node);
 
 extern void SaveSystem(BTreeNode* root);
-extern void LoadSystem(BTreeNode** root);
+extern void LoadSystem(TmapEngine* engine, BTreeNode** root);
 
-extern TacticalTrack* create_track(int track_id, int threat_level);
+extern TacticalTrack* create_track(TmapEngine* engine, int track_id, int threat_level);
 extern void add_history_node(TacticalTrack* track, double lat, double lon, int timestamp);
 extern void intercept_track(TacticalTrack* track);
-extern void insert_track(BTreeNode** root, TacticalTrack* track);
-extern void free_btree(BTreeNode* node);
+extern void insert_track(TrackArena* arena, BTreeNode** root, TacticalTrack* track);
+extern void free_btree(TrackArena* arena, BTreeNode* node);
+extern void btree_cursor_first(BTreeCursor* cur, BTreeNode* root);
+extern TacticalTrack* btree_cursor_next(BTreeCursor* cur);
+extern void threat_index_add(ThreatIndex* idx, TacticalTrack* track);
+extern void threat_index_remove(ThreatIndex* idx, TacticalTrack* track);
+extern TacticalTrack* threat_index_top(const ThreatIndex* idx);
+extern void threat_index_free(ThreatIndex* idx, TrackArena* arena);
+extern void live_table_free(LiveTable* table);
+extern void tmap_arena_init(TrackArena* arena);
+extern void tmap_arena_release(TrackArena* arena);
 
 // 1. [렌더링] 궤적 그리기
 void DrawRadarTargets(BTreeNode* node) {
-    if (node == NULL) return;
-
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) DrawRadarTargets(node->children[i]);
-
-        TacticalTrack* target = node->tracks[i];
-        if (target != NULL && target->history_head != NULL) {
-            // 궤적(선)
-            HistoryNode* current = target->history_head;
-            while (current != NULL && current->next != NULL) {
-                Vector2 startPos = { (float)current->lon, (float)current->lat };
-                Vector2 endPos = { (float)current->next->lon, (float)current->next->lat };
-                Color trailColor = (target->status == TRACK_STATUS_DESTROYED) ? GRAY : Fade(GREEN, 0.5f);
-                if (target->threat_level >= 8 && target->status == TRACK_STATUS_ACTIVE) trailColor = Fade(RED, 0.5f);
-                DrawLineV(startPos, endPos, trailColor);
-                current = current->next;
-            }
-            // 표적(아이콘)
-            if (target->history_tail != NULL) {
-                float x = (float)target->history_tail->lon;
-                float y = (float)target->history_tail->lat;
-                if (target->status == TRACK_STATUS_DESTROYED) {
-                    DrawText("X", (int)x - 5, (int)y - 10, 20, GRAY);
-                } else if (target->threat_level >= 8) {
-                    DrawCircle((int)x, (int)y, 6, RED);
-                    DrawCircleLines((int)x, (int)y, 10, Fade(RED, 0.6f));
-                    DrawText(TextFormat("ID:%d", target->track_id), (int)x + 10, (int)y - 10, 10, RED);
-                } else {
-                    DrawCircle((int)x, (int)y, 4, LIME);
-                    DrawText(TextFormat("ID:%d", target->track_id), (int)x + 8, (int)y - 8, 10, LIME);
-                }
-            }
+    BTreeCursor cur;
+    btree_cursor_first(&cur, node);
+    TacticalTrack* target;
+    while ((target = btree_cursor_next(&cur)) != NULL) {
+        const HistoryPoint* last = history_last(target);
+        if (last == NULL) continue;
+
+        // 궤적(선): 블록 배열을 순서대로 훑으며 이전 점과 잇기
+        Color trailColor = (target->status == TRACK_STATUS_DESTROYED) ? GRAY : Fade(GREEN, 0.5f);
+        if (target->threat_level >= 8 && target->status == TRACK_STATUS_ACTIVE) trailColor = Fade(RED, 0.5f);
+        // (압축 블록의 점 포인터는 다음 호출까지만 유효하므로 직전 좌표는 값으로 보관)
+        HistoryIter it;
+        history_iter_begin(&it, target);
+        const HistoryPoint* curr = history_iter_next(&it);
+        Vector2 startPos = { (float)curr->lon, (float)curr->lat };
+        while ((curr = history_iter_next(&it)) != NULL) {
+            Vector2 endPos = { (float)curr->lon, (float)curr->lat };
+            DrawLineV(startPos, endPos, trailColor);
+            startPos = endPos;
+        }
+        // 표적(아이콘)
+        float x = (float)last->lon;
+        float y = (float)last->lat;
+        if (target->status == TRACK_STATUS_DESTROYED) {
+            DrawText("X", (int)x - 5, (int)y - 10, 20, GRAY);
+        } else if (target->threat_level >= 8) {
+            DrawCircle((int)x, (int)y, 6, RED);
+            DrawCircleLines((int)x, (int)y, 10, Fade(RED, 0.6f));
+            DrawText(TextFormat("ID:%d", target->track_id), (int)x + 10, (int)y - 10, 10, RED);
+        } else {
+            DrawCircle((int)x, (int)y, 4, LIME);
+            DrawText(TextFormat("ID:%d", target->track_id), (int)x + 8, (int)y - 8, 10, LIME);
         }
     }
-    if (!node->is_leaf) DrawRadarTargets(node->children[node->num_keys]);
 }
 
 // 2. [물리] 이동 범위 제한 (화면 크기에 맞춰 자동 조정)
 void UpdateTargetsPosition(BTreeNode* node, int current_time) {
-    if (node == NULL) return;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) UpdateTargetsPosition(node->children[i], current_time);
-
-        TacticalTrack* target = node->tracks[i];
-        if (target != NULL && target->status == TRACK_STATUS_ACTIVE && target->history_tail != NULL) {
-            double new_lon = target->history_tail->lon + (GetRandomValue(-10, 10) * 0.15);
-            double new_lat = target->history_tail->lat + (GetRandomValue(-10, 10) * 0.15);
+    BTreeCursor cur;
+    btree_cursor_first(&cur, node);
+    TacticalTrack* target;
+    while ((target = btree_cursor_next(&cur)) != NULL) {
+        const HistoryPoint* last = history_last(target);
+        if (target->status == TRACK_STATUS_ACTIVE && last != NULL) {
+            double new_lon = last->lon + (GetRandomValue(-10, 10) * 0.15);
+            double new_lat = last->lat + (GetRandomValue(-10, 10) * 0.15);
 
             // 넓어진 해상도에 맞춰 가두기
             if(new_lon < 50) new_lon = 50; 
@@ -96,24 +104,16 @@ void UpdateTargetsPosition(BTreeNode* node, int current_time) {
             add_history_node(target, new_lat, new_lon, current_time);
         }
     }
-    if (!node->is_leaf) UpdateTargetsPosition(node->children[node->num_keys], current_time);
 }
 
-// 3. [전술] 요격
-bool InterceptFirstHighThreat(BTreeNode* node) {
-    if (node == NULL) return false;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) {
-            if(InterceptFirstHighThreat(node->children[i])) return true;
-        }
-        TacticalTrack* target = node->tracks[i];
-        if (target != NULL && target->status == TRACK_STATUS_ACTIVE && target->threat_level >= 8) {
-            intercept_track(target);
-            return true; 
-        }
-    }
-    if (!node->is_leaf) return InterceptFirstHighThreat(node->children[node->num_keys]);
-    return false;
+// 3. [전술] 요격 (위협도 인덱스에서 가장 위협적인 활성 표적을 O(log N)으로 선택)
+bool InterceptFirstHighThreat(ThreatIndex* threats) {
+    TacticalTrack* target = threat_index_top(threats);
+    if (target == NULL || target->threat_level < 8) return false;
+
+    threat_index_remove(threats, target);
+    intercept_track(target);
+    return true;
 }
 
 // 4. [메인] GUI 실행
@@ -122,8 +122,18 @@ int RunRadarGUI(void) {
     SetTargetFPS(60);
     srand(time(NULL));
 
+    // 화면용 엔진 인스턴스 (표적/궤적 메모리와 실시간 표적 테이블 소유)
+    TmapEngine radar = {0};
+    tmap_arena_init(&radar.arena);
     BTreeNode* root = NULL;
-    LoadSystem(&root);
+    ThreatIndex threats = {0};
+    LoadSystem(&radar, &root);
+
+    // 복원된 활성 표적으로 위협도 인덱스 구성 (부팅 시 1회 순차 스캔)
+    BTreeCursor cur;
+    btree_cursor_first(&cur, root);
+    TacticalTrack* restored;
+    while ((restored = btree_cursor_next(&cur)) != NULL) threat_index_add(&threats, restored);
 
     int current_time = 0;
     int next_id = 1000;
@@ -133,16 +143,17 @@ int RunRadarGUI(void) {
         // [입력] 'A' 키: 표적 생성 (넓은 화면 전체 활용)
         if (IsKeyPressed(KEY_A)) {
             int threat = GetRandomValue(1, 10);
-            TacticalTrack* new_track = create_track(next_id++, threat);
+            TacticalTrack* new_track = create_track(&radar, next_id++, threat);
             
             // 생성 위치도 1920x1080 범위 내 랜덤
             double spawn_x = GetRandomValue(100, SCREEN_W - 100);
             double spawn_y = GetRandomValue(100, SCREEN_H - 100);
             add_history_node(new_track, spawn_y, spawn_x, current_time);
-            insert_track(&root, new_track);
+            insert_track(&radar.arena, &root, new_track);
+            threat_index_add(&threats, new_track);
         }
 
-        if (IsKeyPressed(KEY_K)) InterceptFirstHighThreat(root);
+        if (IsKeyPressed(KEY_K)) InterceptFirstHighThreat(&threats);
 
         // [물리] 업데이트
         current_time++;
@@ -150,7 +161,7 @@ int RunRadarGUI(void) {
 
         // [쿼드트리] 업데이트
         QuadNode* q_root = create_quad_node((Rectangle){0, 0, SCREEN_W, SCREEN_H});
-        BuildQuadtreeFromBTree(root, q_root);
+        BuildQuadtreeFromLiveTable(&radar.live, q_root);
 
         // [렌더링]
         BeginDrawing();
@@ -176,7 +187,10 @@ int RunRadarGUI(void) {
     }
 
     SaveSystem(root);
-    free_btree(root);
+    threat_index_free(&threats, &radar.arena);
+    free_btree(&radar.arena, root);
+    live_table_free(&radar.live);
+    tmap_arena_release(&radar.arena);
     CloseWindow();
     return 0;
 }
\ No newline at end of file
@@ -1,3 +1,6 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE             // transport.h의 recvmmsg
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +28,7 @@
 
 #include "raylib.h"
 #include "../common/packet.h"
+#include "../common/transport.h"
 
 // ============================================================================
 // [단계 2] 2560x1600 초고해상도 및 렌더링 밸런스 설정
@@ -57,6 +61,10 @@ typedef struct {
     Vector2 velocity;         
     float last_update_time;
     bool active;
+    // v2 차분 프레임의 기준 상태 (마지막 키프레임 값)
+    int32_t base_lat, base_lon, base_threat;   // [마이크로도], [마이크로도], 위협도
+    int base_epoch;                            // 기준 키프레임 번호
+    bool has_base;
 } TrackDisplay;
 
 TrackDisplay track_list[MAX_TARGETS];
@@ -149,6 +157,118 @@ void UpdateTrack(TargetPacket pkt) {
     }
 }
 
+// ============================================================================
+// [기능 3] 데이터그램 해석: v2 차분 프레임, v1 프레임(머리 + TargetPacket N개) 또는 예전 단일 패킷
+// ============================================================================
+unsigned int link_frames = 0;       // 받은 프레임 수
+unsigned int link_lost = 0;         // 순번이 비어 유실로 본 프레임 수
+unsigned int link_next_seq = 0;     // 다음에 올 것으로 기대하는 순번
+bool link_synced = false;           // 첫 프레임을 받아 순번 기준이 잡혔는지
+
+TrackDisplay* FindTrack(int id) {
+    for (int i = 0; i < MAX_TARGETS; i++) {
+        if (track_list[i].active && track_list[i].data.id == id) return &track_list[i];
+    }
+    return NULL;
+}
+
+// v2 레코드들 해석 (형식은 packet.h의 TrackDeltaHeader 설명). 레코드가 깨져 있으면 거기서 멈춤
+void DecodeDeltaRecords(const TrackDeltaHeader* hdr, const unsigned char* buf, int len) {
+    bool keyframe = (hdr->frame.flags & TRACK_FRAME_FLAG_KEYFRAME) != 0;
+    int pos = (int)sizeof(TrackDeltaHeader);
+    int32_t id = 0, lat = 0, lon = 0;
+    uint32_t u;
+    for (int r = 0; r < hdr->frame.count; r++) {
+        if (!packet_get_varint(buf, len, &pos, &u)) return;
+        id = (int32_t)((uint32_t)id + (uint32_t)packet_unzigzag(u));
+        uint8_t mask = TRACK_DELTA_LAT | TRACK_DELTA_LON | TRACK_DELTA_THREAT | TRACK_DELTA_STATUS;
+        if (!keyframe) {
+            if (pos >= len) return;
+            mask = buf[pos++];
+        }
+        int32_t f_lat = 0, f_lon = 0;
+        uint32_t threat = 0, status = 0;
+        if (mask & TRACK_DELTA_LAT) { if (!packet_get_varint(buf, len, &pos, &u)) return; f_lat = packet_unzigzag(u); }
+        if (mask & TRACK_DELTA_LON) { if (!packet_get_varint(buf, len, &pos, &u)) return; f_lon = packet_unzigzag(u); }
+        if ((mask & TRACK_DELTA_THREAT) && !packet_get_varint(buf, len, &pos, &threat)) return;
+        if (mask & TRACK_DELTA_STATUS) { if (pos >= len) return; status = buf[pos++]; }
+
+        TargetPacket pkt = { id, 0.0, 0.0, (int)threat, (int)status };
+        TrackDisplay* t = FindTrack(id);
+        if (keyframe) {
+            lat = (int32_t)((uint32_t)lat + (uint32_t)f_lat);
+            lon = (int32_t)((uint32_t)lon + (uint32_t)f_lon);
+            pkt.lat = lat / TRACK_COORD_SCALE; pkt.lon = lon / TRACK_COORD_SCALE;
+            UpdateTrack(pkt);
+            t = FindTrack(id);
+            if (t != NULL) {
+                t->base_lat = lat; t->base_lon = lon; t->base_threat = (int32_t)threat;
+                t->base_epoch = hdr->key_epoch; t->has_base = true;
+            }
+        } else if ((mask & TRACK_DELTA_STATUS) && status == 0) {
+            if (t != NULL) UpdateTrack(pkt);           // 요격: 화면에서 제거
+        } else if (mask & TRACK_DELTA_ABSOLUTE) {      // 키프레임 뒤에 생긴 표적
+            pkt.lat = f_lat / TRACK_COORD_SCALE; pkt.lon = f_lon / TRACK_COORD_SCALE;
+            UpdateTrack(pkt);
+            t = FindTrack(id);
+            if (t != NULL) t->has_base = false;
+        } else if (t != NULL && t->has_base && t->base_epoch == hdr->key_epoch) {
+            pkt.lat = (int32_t)((mask & TRACK_DELTA_LAT) ? (uint32_t)t->base_lat + (uint32_t)f_lat : (uint32_t)t->base_lat) / TRACK_COORD_SCALE;
+            pkt.lon = (int32_t)((mask & TRACK_DELTA_LON) ? (uint32_t)t->base_lon + (uint32_t)f_lon : (uint32_t)t->base_lon) / TRACK_COORD_SCALE;
+            pkt.threat_level = (mask & TRACK_DELTA_THREAT) ? (int)threat : t->base_threat;
+            pkt.status = 1;
+            UpdateTrack(pkt);
+        }
+        // 그 밖의 차분 (기준 상태가 없거나 다른 키프레임 기준)은 다음 키프레임까지 무시
+    }
+}
+
+void DecodeDatagram(const unsigned char* buf, int len) {
+    if (len == (int)sizeof(TargetPacket)) {        // 예전 서버 (--wire per-track)
+        TargetPacket pkt;
+        memcpy(&pkt, buf, sizeof(TargetPacket));
+        UpdateTrack(pkt);
+        return;
+    }
+    if (len < (int)sizeof(TrackFrameHeader)) return;
+
+    TrackFrameHeader hdr;
+    memcpy(&hdr, buf, sizeof(TrackFrameHeader));
+    if (hdr.magic != TRACK_FRAME_MAGIC) return;
+    if (hdr.version == TRACK_FRAME_VERSION) {
+        if (len != (int)(sizeof(TrackFrameHeader) + hdr.count * sizeof(TargetPacket))) return;    // 잘린 프레임은 버림
+    } else if (hdr.version != TRACK_FRAME_VERSION_DELTA || len < (int)sizeof(TrackDeltaHeader)) {
+        return;
+    }
+
+    if (link_synced && hdr.seq != link_next_seq) {
+        unsigned int gap = hdr.seq - link_next_seq;
+        if (gap < 0x80000000u) link_lost += gap;   // 순서가 뒤바뀐 늦은 프레임은 유실로 세지 않음
+        else return;
+    }
+    link_synced = true;
+    link_next_seq = hdr.seq + 1;
+    link_frames++;
+
+    if (hdr.version == TRACK_FRAME_VERSION_DELTA) {
+        TrackDeltaHeader delta;
+        memcpy(&delta, buf, sizeof(TrackDeltaHeader));
+        DecodeDeltaRecords(&delta, buf, len);
+        return;
+    }
+    for (int i = 0; i < hdr.count; i++) {
+        TargetPacket pkt;
+        memcpy(&pkt, buf + sizeof(TrackFrameHeader) + i * sizeof(TargetPacket), sizeof(TargetPacket));
+        UpdateTrack(pkt);
+    }
+}
+
+// 수신 대기열의 데이터그램마다 호출 (transport_drain)
+static void OnDatagram(const unsigned char* data, int len, const struct sockaddr_in* from, void* ctx) {
+    (void)from; (void)ctx;
+    DecodeDatagram(data, len);
+}
+
 // ============================================================================
 // 메인 GUI 렌더링 루프
 // ============================================================================
@@ -156,25 +276,13 @@ int main(void) {
     InitWindow(SCREEN_W, SCREEN_H, "T-MAP ULTIMATE C4I TERMINAL [GALAXY BOOK PRO MAX]");
     SetTargetFPS(60);
 
-    WSADATA wsa; WSAStartup(MAKEWORD(2, 2), &wsa);
-    SOCKET s = socket(AF_INET, SOCK_DGRAM, 0);
-    
-    // 수신용(9090) 포트 바인딩
-    struct sockaddr_in recv_addr;
-    memset(&recv_addr, 0, sizeof(recv_addr));
-    recv_addr.sin_family = AF_INET;
-    recv_addr.sin_port = htons(CLIENT_PORT);
-    recv_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    bind(s, (struct sockaddr*)&recv_addr, sizeof(recv_addr)); 
-
-    // 송신용(8080) 서버 주소
-    struct sockaddr_in server_addr;
-    memset(&server_addr, 0, sizeof(server_addr));
-    server_addr.sin_family = AF_INET; 
-    server_addr.sin_port = htons(SERVER_PORT); 
-    server_addr.sin_addr.s_addr = inet_addr("127.0.0.1"); 
-    
-    u_long mode = 1; ioctlsocket(s, FIONBIO, &mode); 
+    // 수신용(9090) 포트 바인딩, 송신 대상은 서버(8080)
+    transport_startup();
+    Transport link;
+    if (!transport_open(&link, NULL, CLIENT_PORT)) {
+        AddLog("> [ERROR] Radar Link Port Unavailable.");
+    }
+    transport_set_peer(&link, "127.0.0.1", SERVER_PORT);
     memset(track_list, 0, sizeof(track_list));
 
     AddLog("> [SYSTEM] Radar Link Established.");
@@ -185,10 +293,7 @@ int main(void) {
     while (!WindowShouldClose()) {
         
         // 1. 네트워크 패킷 수신
-        TargetPacket pkt; struct sockaddr_in f; int flen = sizeof(f);
-        while (recvfrom(s, (char*)&pkt, sizeof(TargetPacket), 0, (struct sockaddr*)&f, &flen) > 0) { 
-            UpdateTrack(pkt); 
-        }
+        if (link.sock != INVALID_SOCKET) transport_drain(&link, OnDatagram, NULL);
 
         // 2. 마우스 제어 및 십자선 피킹
         Vector2 mouse = GetMousePosition();
@@ -208,7 +313,8 @@ int main(void) {
 
         // 3. 키보드 [K] 키 요격 명령 송신
         if (IsKeyPressed(KEY_K) && selected_id != -1) {
-            sendto(s, (char*)&selected_id, sizeof(int), 0, (struct sockaddr*)&server_addr, sizeof(server_addr));
+            C2Command cmd = packet_make_command(C2_CMD_KILL, selected_id, 0, 0.0, 0.0);
+            transport_send(&link, &cmd, (int)sizeof(cmd), &link.peer);
             AddLog(TextFormat("> [ENGAGE] Intercept Signal Sent: #%04d", selected_id));
         }
 
@@ -356,9 +462,10 @@ DrawTriangleLines(v1, v2, v3, WHITE); // 테두리를 흰색으로 줘서 뚜렷
         }
 
         DrawFPS(20, 20);
+        DrawText(TextFormat("LINK: %u frames | %u lost", link_frames, link_lost), 20, 50, 20, link_lost ? ORANGE : GREEN);
         EndDrawing();
     }
-    closesocket(s); WSACleanup(); CloseWindow();
+    transport_close(&link); transport_cleanup(); CloseWindow();
     return 0;
 
     
@@ -7,6 +7,8 @@
 #ifndef PACKET_H
 #define PACKET_H
 
+#include <stdint.h>
+
 /* ============================================================================
    [ 메모리 정렬 (Memory Alignment) 강제 제어 ]
    네트워크 전송 시 컴파일러의 임의적인 메모리 패딩(Padding)을 방지하고,
@@ -33,10 +35,124 @@ typedef struct {
     
 } TargetPacket;
 
+/**
+ * @struct TrackFrameHeader
+ * @brief 여러 TargetPacket을 한 데이터그램에 묶어 보내는 프레임의 머리
+ * @note  총 크기: 2(magic) + 1(version) + 1(flags) + 4(seq) + 4(tick) + 2(count) = 14 Bytes
+ *        바로 뒤에 TargetPacket이 count개 붙습니다. 바이트 순서는 TargetPacket과 같이 송신 호스트 순서(x86 = 리틀 엔디언).
+ */
+typedef struct {
+    uint16_t magic;       // TRACK_FRAME_MAGIC (예전 28바이트 단일 패킷과 구분)
+    uint8_t  version;     // TRACK_FRAME_VERSION
+    uint8_t  flags;       // TRACK_FRAME_FLAG_*
+    uint32_t seq;         // 프레임 순번 (송신 측에서 프레임마다 1씩 증가, 빈 번호 = 유실)
+    uint32_t tick;        // 이 프레임 상태를 만든 시뮬레이션 틱 번호
+    uint16_t count;       // 뒤따르는 TargetPacket 수
+} TrackFrameHeader;
+
+#define TRACK_FRAME_MAGIC       0x4D54      // "TM"
+#define TRACK_FRAME_VERSION     1
+#define TRACK_FRAME_FLAG_LAST   0x01        // 이 틱의 마지막 프레임
+#define TRACK_FRAME_MTU         1400        // 프레임 최대 크기 [바이트] (이더넷 MTU 1500 - IP/UDP 머리 - 여유분)
+#define TRACK_FRAME_MAX_RECORDS ((TRACK_FRAME_MTU - sizeof(TrackFrameHeader)) / sizeof(TargetPacket))  // 49개
+
+/**
+ * @struct TrackDeltaHeader
+ * @brief v2(양자화 + 차분) 프레임의 머리: v1 머리 + 기준 키프레임 번호
+ * @note  총 크기: 14 + 2(key_epoch) = 16 Bytes. version = TRACK_FRAME_VERSION_DELTA이고 count는 뒤따르는 레코드 수.
+ *        레코드는 가변 길이 바이트열이라 구조체가 없습니다. 정수는 모두 LEB128 varint이고,
+ *        부호 있는 값은 zigzag로 바꿔 씁니다. 좌표는 마이크로도(1e-6도 ≈ 0.11 m) 정수입니다.
+ *
+ *        키프레임 레코드 (flags에 KEYFRAME):
+ *          [id 차분] [위도] [경도] [위협도] [상태 1B]
+ *          id 차분 = zigzag(id - 프레임 안 앞 레코드 id), 위도/경도 = zigzag(값 - 앞 레코드 값) (첫 레코드의 "앞" = 0)
+ *          받은 값이 그 표적의 기준 상태가 되고 기준 번호는 key_epoch입니다.
+ *        차분 레코드:
+ *          [id 차분] [마스크 1B] [위도] [경도] [위협도] [상태 1B]  (마스크 비트가 켜진 필드만)
+ *          ABSOLUTE 비트가 없으면 위도/경도 = zigzag(값 - 기준 상태 값)이고, 기준 번호가 key_epoch와 같은 표적에만 적용합니다.
+ *          ABSOLUTE 비트가 있으면 (키프레임 뒤에 생긴 표적) 위도/경도 = zigzag(값)이고 기준 상태 없이 바로 적용합니다.
+ *          마스크에 없는 필드는 기준 상태 값입니다. 상태 = 0인 레코드는 사라진 표적(요격)입니다.
+ */
+typedef struct {
+    TrackFrameHeader frame;
+    uint16_t key_epoch;   // 차분의 기준 키프레임 번호 (키프레임 프레임이면 그 자신의 번호)
+} TrackDeltaHeader;
+
+#define TRACK_FRAME_VERSION_DELTA   2
+#define TRACK_FRAME_FLAG_KEYFRAME   0x02    // 이 프레임의 레코드가 새 기준 상태 (차분 없음)
+#define TRACK_DELTA_LAT             0x01    // 차분 레코드 마스크 비트
+#define TRACK_DELTA_LON             0x02
+#define TRACK_DELTA_THREAT          0x04
+#define TRACK_DELTA_STATUS          0x08
+#define TRACK_DELTA_ABSOLUTE        0x10
+#define TRACK_DELTA_MAX_RECORD      22      // 레코드 최대 길이 [바이트] (varint 5 x 4 + 마스크 + 상태)
+#define TRACK_COORD_SCALE           1e6     // 좌표 양자화 배율 (도 → 마이크로도)
+
+/**
+ * @struct C2Command
+ * @brief 클라이언트 → 서버 지휘 명령 봉투 (요격, 투입, 위협도 변경)
+ * @note  총 크기: 2(magic) + 1(version) + 1(type) + 4(track_id) + 4(threat) + 4(lat) + 4(lon) = 20 Bytes
+ *        데이터그램 하나에 명령 하나. 서버는 예전 클라이언트의 4바이트 표적 ID 데이터그램도 KILL로 받습니다.
+ */
+typedef struct {
+    uint16_t magic;       // C2_COMMAND_MAGIC
+    uint8_t  version;     // C2_COMMAND_VERSION
+    uint8_t  type;        // C2_CMD_*
+    int32_t  track_id;    // 대상 표적 ID
+    int32_t  threat;      // ADD: 위협도, SET_THREAT: 새 위협도 (KILL은 0)
+    int32_t  lat;         // ADD: 투입 위도 [마이크로도] (KILL, SET_THREAT는 0)
+    int32_t  lon;         // ADD: 투입 경도 [마이크로도]
+} C2Command;
+
+#define C2_COMMAND_MAGIC            0x3243      // "C2"
+#define C2_COMMAND_VERSION          1
+#define C2_CMD_KILL                 1
+#define C2_CMD_ADD                  2
+#define C2_CMD_SET_THREAT           3
+
 /* ============================================================================
    메모리 정렬 설정을 원래의 기본값으로 되돌립니다.
    (이후에 선언되는 일반 구조체들의 성능 저하를 막기 위함)
 ============================================================================ */
 #pragma pack(pop) 
 
+/* ============================================================================
+   [ v2 레코드 정수 부호화 ] 서버 인코더와 클라이언트 디코더가 같은 함수를 씁니다.
+============================================================================ */
+
+static inline uint32_t packet_zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t packet_unzigzag(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+// LEB128 varint 쓰기 (최대 5바이트), 쓴 바이트 수 반환
+static inline int packet_put_varint(unsigned char* out, uint32_t v) {
+    int n = 0;
+    while (v >= 0x80) { out[n++] = (unsigned char)(v | 0x80); v >>= 7; }
+    out[n++] = (unsigned char)v;
+    return n;
+}
+
+// LEB128 varint 읽기: *pos를 옮기고, 버퍼 끝을 넘거나 5바이트를 넘으면 0 반환
+static inline int packet_get_varint(const unsigned char* buf, int len, int* pos, uint32_t* v) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35 && *pos < len; shift += 7) {
+        unsigned char b = buf[(*pos)++];
+        result |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) { *v = result; return 1; }
+    }
+    return 0;
+}
+
+// 지휘 명령 봉투 채우기 (좌표는 도 단위로 받아 마이크로도로 양자화)
+static inline C2Command packet_make_command(uint8_t type, int32_t track_id, int32_t threat, double lat, double lon) {
+    C2Command cmd;
+    cmd.magic = C2_COMMAND_MAGIC;
+    cmd.version = C2_COMMAND_VERSION;
+    cmd.type = type;
+    cmd.track_id = track_id;
+    cmd.threat = threat;
+    cmd.lat = (int32_t)(lat * TRACK_COORD_SCALE + (lat < 0.0 ? -0.5 : 0.5));
+    cmd.lon = (int32_t)(lon * TRACK_COORD_SCALE + (lon < 0.0 ? -0.5 : 0.5));
+    return cmd;
+}
+
 #endif // PACKET_H
\ No newline at end of file
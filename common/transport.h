@@ -0,0 +1,279 @@
+/**
+ * @file    transport.h
+ * @brief   T-MAP System: UDP 데이터그램 송수신 추상화 (일괄 소켓 I/O)
+ * @details 서버 송출/명령 수신과 클라이언트 수신이 같은 함수를 씁니다.
+ *          - Linux: 틱 하나의 프레임을 sendmmsg 한 번(최대 TRANSPORT_BATCH개)으로 보내고,
+ *            수신 대기열은 recvmmsg로 TRANSPORT_BATCH개씩 비웁니다. 시스템 호출 수가 데이터그램 수의 1/64가 됩니다.
+ *          - 그 밖 (Windows winsock 등): 데이터그램마다 sendto / recvfrom
+ *          송신은 transport_queue로 쌓고 transport_flush로 내보냅니다. 대기열이 차면 자동으로 내보냅니다.
+ *          Linux 일괄 경로는 _GNU_SOURCE가 필요합니다 (서버는 common.h, 클라이언트는 main.c 맨 위에서 정의).
+ */
+
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    typedef int transport_socklen_t;
+#else
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <errno.h>
+    typedef socklen_t transport_socklen_t;
+    #ifndef INVALID_SOCKET
+        typedef int SOCKET;
+        #define INVALID_SOCKET (-1)
+    #endif
+    #ifndef closesocket
+        #define closesocket close
+    #endif
+#endif
+
+#if defined(__linux__) && defined(_GNU_SOURCE) && defined(MSG_WAITFORONE)
+    #define TRANSPORT_HAS_MMSG 1        // sendmmsg / recvmmsg 사용 가능
+#else
+    #define TRANSPORT_HAS_MMSG 0
+#endif
+
+#define TRANSPORT_BATCH      64         // 시스템 호출 한 번에 주고받는 최대 데이터그램 수
+#define TRANSPORT_SLOT_BYTES 1472       // 데이터그램 하나의 최대 크기 (이더넷 MTU 1500 - IP/UDP 머리)
+
+/**
+ * @brief 받은 데이터그램 하나를 처리하는 함수
+ */
+typedef void (*TransportHandler)(const unsigned char* data, int len, const struct sockaddr_in* from, void* ctx);
+
+/**
+ * @brief UDP 소켓 하나와 송신 대기열, 수신 일괄 버퍼
+ */
+typedef struct Transport {
+    SOCKET              sock;
+    struct sockaddr_in  peer;           // transport_queue로 쌓은 데이터그램의 목적지
+    bool                batched;        // sendmmsg/recvmmsg 사용 (Linux 기본값 true, 끄면 데이터그램마다 호출)
+    unsigned char*      out;            // 송신 대기열 [TRANSPORT_BATCH][TRANSPORT_SLOT_BYTES]
+    int                 out_len[TRANSPORT_BATCH];
+    int                 out_count;
+    unsigned char*      in;             // 수신 일괄 버퍼 [TRANSPORT_BATCH][TRANSPORT_SLOT_BYTES]
+    uint64_t            send_calls;     // 송신 시스템 호출 수
+    uint64_t            recv_calls;     // 수신 시스템 호출 수 (빈 대기열 확인 포함)
+    uint64_t            sent;           // 보낸 데이터그램 수
+    uint64_t            received;       // 받은 데이터그램 수
+} Transport;
+
+/**
+ * @brief 소켓 라이브러리 시작/정리 (winsock만 필요, 프로세스당 한 번)
+ */
+static inline void transport_startup(void) {
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+}
+
+static inline void transport_cleanup(void) {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+static inline const char* transport_backend(const Transport* t) {
+    return t->batched ? "sendmmsg/recvmmsg" : "sendto/recvfrom";
+}
+
+/**
+ * @brief 비차단 UDP 소켓을 열고 bind_ip:port에 묶음
+ * @param bind_ip NULL이면 모든 주소, port 0이면 커널이 빈 포트를 고름
+ * @return false = 소켓/바인드/메모리 실패 (t는 닫힌 상태)
+ */
+static inline bool transport_open(Transport* t, const char* bind_ip, uint16_t port) {
+    memset(t, 0, sizeof(Transport));
+    t->batched = TRANSPORT_HAS_MMSG;
+    t->sock = socket(AF_INET, SOCK_DGRAM, 0);
+    t->out = (unsigned char*)malloc((size_t)TRANSPORT_BATCH * TRANSPORT_SLOT_BYTES * 2);
+    t->in = t->out + (size_t)TRANSPORT_BATCH * TRANSPORT_SLOT_BYTES;
+    if (t->sock == INVALID_SOCKET || t->out == NULL) {
+        if (t->sock != INVALID_SOCKET) closesocket(t->sock);
+        free(t->out);
+        t->sock = INVALID_SOCKET;
+        t->out = t->in = NULL;
+        return false;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = bind_ip != NULL ? inet_addr(bind_ip) : htonl(INADDR_ANY);
+    if (bind(t->sock, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        closesocket(t->sock);
+        free(t->out);
+        t->sock = INVALID_SOCKET;
+        t->out = t->in = NULL;
+        return false;
+    }
+#ifdef _WIN32
+    u_long mode = 1;
+    ioctlsocket(t->sock, FIONBIO, &mode);
+#else
+    fcntl(t->sock, F_SETFL, fcntl(t->sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    return true;
+}
+
+/**
+ * @brief transport_queue의 목적지 지정
+ */
+static inline void transport_set_peer(Transport* t, const char* ip, uint16_t port) {
+    memset(&t->peer, 0, sizeof(t->peer));
+    t->peer.sin_family = AF_INET;
+    t->peer.sin_port = htons(port);
+    t->peer.sin_addr.s_addr = inet_addr(ip);
+}
+
+/**
+ * @brief 소켓이 실제로 묶인 주소 (port 0으로 열었을 때 커널이 고른 포트 확인용)
+ */
+static inline bool transport_local_addr(const Transport* t, struct sockaddr_in* out) {
+    transport_socklen_t len = sizeof(*out);
+    return getsockname(t->sock, (struct sockaddr*)out, &len) == 0;
+}
+
+/**
+ * @brief 데이터그램 하나를 to로 바로 송신 (대기열을 거치지 않는 단발 명령용)
+ */
+static inline bool transport_send(Transport* t, const void* data, int len, const struct sockaddr_in* to) {
+    t->send_calls++;
+    if (sendto(t->sock, (const char*)data, len, 0, (const struct sockaddr*)to, sizeof(*to)) != len) return false;
+    t->sent++;
+    return true;
+}
+
+/**
+ * @brief 쌓인 데이터그램을 모두 peer로 송신
+ * @note  UDP라 송신 버퍼가 차서 실패한 데이터그램은 다시 보내지 않고 버립니다 (유실과 같음).
+ */
+static inline void transport_flush(Transport* t) {
+    int count = t->out_count;
+    t->out_count = 0;
+    if (count == 0) return;
+#if TRANSPORT_HAS_MMSG
+    if (t->batched) {
+        struct mmsghdr msgs[TRANSPORT_BATCH];
+        struct iovec iov[TRANSPORT_BATCH];
+        memset(msgs, 0, sizeof(struct mmsghdr) * (size_t)count);
+        for (int i = 0; i < count; i++) {
+            iov[i].iov_base = t->out + (size_t)i * TRANSPORT_SLOT_BYTES;
+            iov[i].iov_len = (size_t)t->out_len[i];
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &t->peer;
+            msgs[i].msg_hdr.msg_namelen = sizeof(t->peer);
+        }
+        int done = 0;
+        while (done < count) {
+            t->send_calls++;
+            int n = sendmmsg(t->sock, msgs + done, (unsigned int)(count - done), 0);
+            if (n <= 0) break;
+            done += n;
+        }
+        t->sent += (uint64_t)done;
+        return;
+    }
+#endif
+    for (int i = 0; i < count; i++) {
+        transport_send(t, t->out + (size_t)i * TRANSPORT_SLOT_BYTES, t->out_len[i], &t->peer);
+    }
+}
+
+/**
+ * @brief 데이터그램 하나를 송신 대기열에 복사 (대기열이 차면 먼저 내보냄)
+ * @note  TRANSPORT_SLOT_BYTES보다 긴 데이터그램은 대기열을 거치지 않고 바로 보냅니다.
+ */
+static inline void transport_queue(Transport* t, const void* data, size_t len) {
+    if (len > TRANSPORT_SLOT_BYTES) {
+        transport_flush(t);
+        transport_send(t, data, (int)len, &t->peer);
+        return;
+    }
+    if (t->out_count == TRANSPORT_BATCH) transport_flush(t);
+    memcpy(t->out + (size_t)t->out_count * TRANSPORT_SLOT_BYTES, data, len);
+    t->out_len[t->out_count++] = (int)len;
+}
+
+/**
+ * @brief 데이터그램 하나 수신 (없으면 바로 0)
+ * @return 받은 길이. 대기열이 비었으면 0 이하
+ */
+static inline int transport_recv(Transport* t, void* buf, int cap, struct sockaddr_in* from) {
+    struct sockaddr_in dummy;
+    transport_socklen_t flen = sizeof(dummy);
+    t->recv_calls++;
+    int got = (int)recvfrom(t->sock, (char*)buf, cap, 0, (struct sockaddr*)(from != NULL ? from : &dummy), &flen);
+    if (got > 0) t->received++;
+    return got;
+}
+
+/**
+ * @brief 수신 대기열을 비울 때까지 받은 데이터그램마다 handler 호출
+ * @return 처리한 데이터그램 수
+ */
+static inline size_t transport_drain(Transport* t, TransportHandler handler, void* ctx) {
+    size_t total = 0;
+#if TRANSPORT_HAS_MMSG
+    if (t->batched) {
+        struct mmsghdr msgs[TRANSPORT_BATCH];
+        struct iovec iov[TRANSPORT_BATCH];
+        struct sockaddr_in from[TRANSPORT_BATCH];
+        for (;;) {
+            memset(msgs, 0, sizeof(msgs));
+            for (int i = 0; i < TRANSPORT_BATCH; i++) {
+                iov[i].iov_base = t->in + (size_t)i * TRANSPORT_SLOT_BYTES;
+                iov[i].iov_len = TRANSPORT_SLOT_BYTES;
+                msgs[i].msg_hdr.msg_iov = &iov[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+                msgs[i].msg_hdr.msg_name = &from[i];
+                msgs[i].msg_hdr.msg_namelen = sizeof(from[i]);
+            }
+            t->recv_calls++;
+            int n = recvmmsg(t->sock, msgs, TRANSPORT_BATCH, MSG_DONTWAIT, NULL);
+            if (n <= 0) break;
+            for (int i = 0; i < n; i++) handler(t->in + (size_t)i * TRANSPORT_SLOT_BYTES, (int)msgs[i].msg_len, &from[i], ctx);
+            t->received += (uint64_t)n;
+            total += (size_t)n;
+            if (n < TRANSPORT_BATCH) break;     // 대기열을 다 비움
+        }
+        return total;
+    }
+#endif
+    struct sockaddr_in from;
+    int got;
+    while ((got = transport_recv(t, t->in, TRANSPORT_SLOT_BYTES, &from)) > 0) {
+        handler(t->in, got, &from, ctx);
+        total++;
+    }
+    return total;
+}
+
+/**
+ * @brief 남은 대기열을 내보내고 소켓과 버퍼 해제
+ */
+static inline void transport_close(Transport* t) {
+    if (t->sock == INVALID_SOCKET) return;
+    transport_flush(t);
+    closesocket(t->sock);
+    free(t->out);
+    t->sock = INVALID_SOCKET;
+    t->out = t->in = NULL;
+}
+
+#endif // TRANSPORT_H
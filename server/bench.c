@@ -0,0 +1,1774 @@
+/**
+ * @file    bench.c
+ * @brief   Performance Benchmark Suite
+ * @details `tmap_engine.exe --bench <name>` 으로 실행되는 성능 측정 모듈.
+ *          엔진 코어와 같은 바이너리에서 돌기 때문에 실제 배포 빌드 옵션 그대로 측정됩니다.
+ */
+
+#include "common.h"
+#include "clock.h"
+#include "rng.h"
+#include "../common/packet.h"
+#include "../common/transport.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+extern bool btree_insert(TrackArena* arena, BTreeNode** root, TacticalTrack* track);
+extern TacticalTrack* search_btree(BTreeNode* node, int track_id);
+extern void free_btree_node(TrackArena* arena, BTreeNode* node);
+extern bool track_index_init(TrackIndex* idx, size_t expected_tracks);
+extern void track_index_free(TrackIndex* idx);
+extern bool track_index_put(TrackIndex* idx, int64_t key, TacticalTrack* track);
+extern TacticalTrack* track_index_get(const TrackIndex* idx, int64_t key);
+extern TacticalTrack* create_track_quiet(TmapEngine* engine, int track_id, int threat_level);
+extern void add_history_node(TacticalTrack* track, double lat, double lon, int timestamp);
+extern void free_btree(TrackArena* arena, BTreeNode* node);
+extern void free_track(TacticalTrack* track);
+extern void save_single_track(TacticalTrack* track, FILE* fp);
+extern void simulate_flight(TmapEngine* engine, uint32_t tick, int timestamp);
+extern bool worker_pool_init(WorkerPool* pool, int thread_count);
+extern void worker_pool_free(WorkerPool* pool);
+extern void live_table_free(LiveTable* table);
+extern uint64_t live_table_digest(const LiveTable* live);
+extern void engine_init(TmapEngine* engine, uint64_t seed);
+extern void engine_free(TmapEngine* engine);
+extern void kinematics_step(LiveTable* live, size_t begin, size_t end, uint32_t stride, uint64_t seed, uint32_t tick);
+extern const char* kinematics_select(const char* name);
+extern void btree_cursor_first(BTreeCursor* cur, BTreeNode* root);
+extern TacticalTrack* btree_cursor_next(BTreeCursor* cur);
+extern TacticalTrack** load_track_records(TmapEngine* engine, FILE* fp, size_t* out_count);
+extern BTreeNode* btree_bulk_load(TrackArena* arena, TacticalTrack* const* tracks, size_t n);
+extern void tick_scheduler_init(TickScheduler* sched, int hz, TickPolicy policy);
+extern uint32_t tick_scheduler_wait(TickScheduler* sched);
+extern uint32_t tick_scheduler_begin(TickScheduler* sched);
+extern void tick_scheduler_end(TickScheduler* sched);
+extern void tick_scheduler_report(const TickScheduler* sched);
+extern bool scenario_load(const char* path, EventQueue* q, uint64_t offset_ns, uint64_t* end_ns);
+extern bool event_queue_pop(EventQueue* q, SimEvent* out);
+extern void event_queue_free(EventQueue* q);
+extern bool deploy_target(TmapEngine* engine, int target_id, int threat_level, double lat, double lon, int timestamp);
+extern void wire_encoder_init(WireEncoder* enc, WireMode mode);
+extern void wire_encoder_free(WireEncoder* enc);
+extern bool kill_target(TmapEngine* engine, int target_id);
+extern size_t compact_tombstones(TmapEngine* engine, uint64_t budget_ns);
+extern bool command_batch_push(CommandBatch* batch, const QueuedCommand* cmd);
+extern CommandTally command_batch_apply(TmapEngine* engine, CommandBatch* batch, int timestamp);
+extern void command_batch_free(CommandBatch* batch);
+extern bool event_loop_init(EventLoop* loop, bool polled);
+extern bool event_loop_watch(EventLoop* loop, EventSource source, intptr_t fd);
+extern void event_loop_arm(EventLoop* loop, uint64_t deadline_ns);
+extern int event_loop_wait(EventLoop* loop, EventSource ready[EVENT_SOURCE_COUNT]);
+extern void event_loop_free(EventLoop* loop);
+extern const char* event_loop_backend(const EventLoop* loop);
+extern size_t wire_broadcast(WireEncoder* enc, const LiveTable* live, uint32_t tick, WireSink sink, void* ctx);
+
+/* =================================================================
+   [1] Benchmark Helpers
+================================================================= */
+
+// 재현 가능한 입력을 위한 xorshift32 (rand()는 RAND_MAX가 32767인 플랫폼이 있음)
+static uint32_t bench_rng_state = 0x9E3779B9u;
+
+static uint32_t bench_rand(void) {
+    uint32_t x = bench_rng_state;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return bench_rng_state = x;
+}
+
+// 희소한 32비트 ID 집합 생성 (중복 없음, 삽입 순서는 무작위)
+static int* make_sparse_ids(int n) {
+    int* ids = (int*)malloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++) ids[i] = i * 37 + (int)(bench_rand() % 37);
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(bench_rand() % (uint32_t)(i + 1));
+        int tmp = ids[i]; ids[i] = ids[j]; ids[j] = tmp;
+    }
+    return ids;
+}
+
+// 로그 없이 표적 객체만 할당 (create_track은 표적마다 WAYPOINT 로그를 출력함)
+static TacticalTrack* make_bench_tracks(const int* ids, int n) {
+    TacticalTrack* tracks = (TacticalTrack*)calloc((size_t)n, sizeof(TacticalTrack));
+    for (int i = 0; i < n; i++) {
+        tracks[i].track_id = ids[i];
+        tracks[i].threat_level = 1 + (int)(bench_rand() % 10);
+        tracks[i].status = TRACK_STATUS_ACTIVE;
+        tracks[i].live_slot = -1;
+    }
+    return tracks;
+}
+
+static void free_bench_btree(TrackArena* arena, BTreeNode* node) {
+    if (node == NULL) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) free_bench_btree(arena, node->children[i]);
+    }
+    free_btree_node(arena, node);
+}
+
+/* =================================================================
+   [2] Legacy Layout Replica (비교 기준)
+   - 키를 TacticalTrack 포인터 너머에서 읽는 기존 노드 형식 (t = 3)
+================================================================= */
+#define LEGACY_T 3
+#define LEGACY_MAX_KEYS (2 * LEGACY_T - 1)
+
+typedef struct LegacyNode {
+    int                num_keys;
+    bool               is_leaf;
+    TacticalTrack*     tracks[LEGACY_MAX_KEYS];
+    struct LegacyNode* children[LEGACY_MAX_KEYS + 1];
+} LegacyNode;
+
+static LegacyNode* legacy_create(bool is_leaf) {
+    LegacyNode* node = (LegacyNode*)calloc(1, sizeof(LegacyNode));
+    node->is_leaf = is_leaf;
+    return node;
+}
+
+static void legacy_split(LegacyNode* parent, int i, LegacyNode* full) {
+    LegacyNode* right = legacy_create(full->is_leaf);
+    right->num_keys = LEGACY_T - 1;
+    for (int j = 0; j < LEGACY_T - 1; j++) right->tracks[j] = full->tracks[j + LEGACY_T];
+    if (!full->is_leaf) {
+        for (int j = 0; j < LEGACY_T; j++) right->children[j] = full->children[j + LEGACY_T];
+    }
+    full->num_keys = LEGACY_T - 1;
+    for (int j = parent->num_keys; j >= i + 1; j--) parent->children[j + 1] = parent->children[j];
+    parent->children[i + 1] = right;
+    for (int j = parent->num_keys - 1; j >= i; j--) parent->tracks[j + 1] = parent->tracks[j];
+    parent->tracks[i] = full->tracks[LEGACY_T - 1];
+    parent->num_keys++;
+}
+
+static void legacy_insert(LegacyNode** root, TacticalTrack* track) {
+    if (*root == NULL) {
+        *root = legacy_create(true);
+        (*root)->tracks[0] = track;
+        (*root)->num_keys = 1;
+        return;
+    }
+    if ((*root)->num_keys == LEGACY_MAX_KEYS) {
+        LegacyNode* new_root = legacy_create(false);
+        new_root->children[0] = *root;
+        legacy_split(new_root, 0, *root);
+        *root = new_root;
+    }
+    LegacyNode* node = *root;
+    while (!node->is_leaf) {
+        int i = node->num_keys - 1;
+        while (i >= 0 && node->tracks[i]->track_id > track->track_id) i--;
+        i++;
+        if (node->children[i]->num_keys == LEGACY_MAX_KEYS) {
+            legacy_split(node, i, node->children[i]);
+            if (node->tracks[i]->track_id < track->track_id) i++;
+        }
+        node = node->children[i];
+    }
+    int i = node->num_keys - 1;
+    while (i >= 0 && node->tracks[i]->track_id > track->track_id) {
+        node->tracks[i + 1] = node->tracks[i];
+        i--;
+    }
+    node->tracks[i + 1] = track;
+    node->num_keys++;
+}
+
+static TacticalTrack* legacy_search(LegacyNode* node, int track_id) {
+    while (node != NULL) {
+        int i = 0;
+        while (i < node->num_keys && track_id > node->tracks[i]->track_id) i++;
+        if (i < node->num_keys && track_id == node->tracks[i]->track_id) return node->tracks[i];
+        if (node->is_leaf) return NULL;
+        node = node->children[i];
+    }
+    return NULL;
+}
+
+static void legacy_free(LegacyNode* node) {
+    if (node == NULL) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) legacy_free(node->children[i]);
+    }
+    free(node);
+}
+
+/* =================================================================
+   [3] Benchmarks
+================================================================= */
+
+/**
+ * @brief 인라인 키 + SIMD 노드 탐색 vs 기존 포인터 추적 노드 탐색
+ */
+static int bench_btree_search(void) {
+    static const int sizes[] = { 10000, 100000, 1000000 };
+    const int lookups = 2000000;
+
+    printf("[BENCH] B-Tree point lookup (%d random hits per size)\n", lookups);
+    printf("        inline keys: %d slots/node (%d cache line), max %d keys\n",
+           BTREE_KEY_SLOTS, BTREE_KEY_LINES, MAX_KEYS);
+    printf("%10s | %14s | %14s | %7s\n", "tracks", "legacy ns/op", "inline ns/op", "speedup");
+
+    TmapEngine engine;
+    engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int* ids = make_sparse_ids(n);
+        TacticalTrack* tracks = make_bench_tracks(ids, n);
+
+        BTreeNode* root = NULL;
+        LegacyNode* legacy_root = NULL;
+        for (int i = 0; i < n; i++) {
+            btree_insert(&engine.arena, &root, &tracks[i]);
+            legacy_insert(&legacy_root, &tracks[i]);
+        }
+
+        int* probes = (int*)malloc(sizeof(int) * lookups);
+        for (int i = 0; i < lookups; i++) probes[i] = ids[bench_rand() % (uint32_t)n];
+
+        long long checksum = 0;
+        uint64_t t0 = tmap_now_ns();
+        for (int i = 0; i < lookups; i++) checksum += legacy_search(legacy_root, probes[i])->threat_level;
+        uint64_t t1 = tmap_now_ns();
+        for (int i = 0; i < lookups; i++) checksum -= search_btree(root, probes[i])->threat_level;
+        uint64_t t2 = tmap_now_ns();
+
+        double legacy_ns = (double)(t1 - t0) / lookups;
+        double inline_ns = (double)(t2 - t1) / lookups;
+        printf("%10d | %14.1f | %14.1f | %6.2fx%s\n", n, legacy_ns, inline_ns,
+               legacy_ns / inline_ns, checksum == 0 ? "" : "  (MISMATCH!)");
+
+        free(probes);
+        legacy_free(legacy_root);
+        free_bench_btree(&engine.arena, root);
+        free(tracks);
+        free(ids);
+    }
+    engine_free(&engine);
+    return 0;
+}
+
+/**
+ * @brief 해시 인덱스 vs B+Tree 단건 조회 지연 시간 (KILL / SEARCH 경로)
+ */
+static int bench_track_index(void) {
+    static const int sizes[] = { 10000, 100000, 1000000 };
+    const int lookups = 2000000;
+
+    printf("[BENCH] Point lookup: B+Tree vs Robin Hood hash index (%d random hits per size)\n", lookups);
+    printf("%10s | %14s | %14s | %7s\n", "tracks", "btree ns/op", "hash ns/op", "speedup");
+
+    TmapEngine engine;
+    engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int* ids = make_sparse_ids(n);
+        TacticalTrack* tracks = make_bench_tracks(ids, n);
+
+        BTreeNode* root = NULL;
+        TrackIndex index;
+        track_index_init(&index, 0);   // 재해싱 비용까지 포함된 현실적인 테이블 상태
+        for (int i = 0; i < n; i++) {
+            btree_insert(&engine.arena, &root, &tracks[i]);
+            track_index_put(&index, ids[i], &tracks[i]);
+        }
+
+        int* probes = (int*)malloc(sizeof(int) * lookups);
+        for (int i = 0; i < lookups; i++) probes[i] = ids[bench_rand() % (uint32_t)n];
+
+        long long checksum = 0;
+        uint64_t t0 = tmap_now_ns();
+        for (int i = 0; i < lookups; i++) checksum += search_btree(root, probes[i])->threat_level;
+        uint64_t t1 = tmap_now_ns();
+        for (int i = 0; i < lookups; i++) checksum -= track_index_get(&index, probes[i])->threat_level;
+        uint64_t t2 = tmap_now_ns();
+
+        double btree_ns = (double)(t1 - t0) / lookups;
+        double hash_ns = (double)(t2 - t1) / lookups;
+        printf("%10d | %14.1f | %14.1f | %6.2fx%s\n", n, btree_ns, hash_ns,
+               btree_ns / hash_ns, checksum == 0 ? "" : "  (MISMATCH!)");
+
+        free(probes);
+        track_index_free(&index);
+        free_bench_btree(&engine.arena, root);
+        free(tracks);
+        free(ids);
+    }
+    engine_free(&engine);
+    return 0;
+}
+
+/**
+ * @brief 부팅 준비 시간: 레코드별 insert vs 정렬 입력 상향식 일괄 구축
+ * @note  두 경로 모두 파일 읽기, 표적/궤적 할당, 해시 인덱스 등록까지 포함합니다.
+ *        기존 경로의 레코드당 printf 3줄은 제외했으므로 실제 차이는 이보다 큽니다.
+ */
+static int bench_startup(void) {
+    static const int sizes[] = { 10000, 100000, 1000000 };
+    const int points = 2;                       // 표적당 궤적 점 수
+    const char* path = "bench_startup.dat";
+
+    printf("[BENCH] Startup time-to-ready (%d waypoints per track)\n", points);
+    printf("%10s | %14s | %14s | %7s\n", "tracks", "insert ms", "bulk ms", "speedup");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+
+        // 저장 파일과 같은 형식/순서(ID 오름차순)로 입력 생성
+        FILE* fp = fopen(path, "wb");
+        if (fp == NULL) { printf("[BENCH] Cannot write '%s'.\n", path); return 1; }
+        for (int i = 0; i < n; i++) {
+            int header[4] = { i * 7 + 1000, 1 + i % 10, TRACK_STATUS_ACTIVE, points };
+            fwrite(header, sizeof(int), 4, fp);
+            for (int p = 0; p < points; p++) {
+                double lat = 37.5 + p * 0.0001, lon = 127.0 - p * 0.0001;
+                int t = p;
+                fwrite(&lat, sizeof(double), 1, fp);
+                fwrite(&lon, sizeof(double), 1, fp);
+                fwrite(&t, sizeof(int), 1, fp);
+            }
+        }
+        fclose(fp);
+
+        // (1) 기존 경로: 레코드마다 B-Tree 삽입 (경로마다 새 엔진)
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        uint64_t t0 = tmap_now_ns();
+        fp = fopen(path, "rb");
+        BTreeNode* root = NULL;
+        TrackIndex index;
+        track_index_init(&index, 0);
+        int header[4];
+        while (fread(header, sizeof(int), 4, fp) == 4) {
+            TacticalTrack* track = create_track_quiet(&engine, header[0], header[1]);
+            track->status = header[2];
+            for (int p = 0; p < header[3]; p++) {
+                double lat, lon; int t;
+                if (fread(&lat, sizeof(double), 1, fp) != 1 || fread(&lon, sizeof(double), 1, fp) != 1 ||
+                    fread(&t, sizeof(int), 1, fp) != 1) break;
+                add_history_node(track, lat, lon, t);
+            }
+            btree_insert(&engine.arena, &root, track);
+            track_index_put(&index, track->track_id, track);
+        }
+        fclose(fp);
+        uint64_t t1 = tmap_now_ns();
+        free_btree(&engine.arena, root);
+        track_index_free(&index);
+        engine_free(&engine);
+
+        // (2) 일괄 구축 경로
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        uint64_t t2 = tmap_now_ns();
+        fp = fopen(path, "rb");
+        size_t count = 0;
+        TacticalTrack** tracks = load_track_records(&engine, fp, &count);
+        fclose(fp);
+        root = btree_bulk_load(&engine.arena, tracks, count);
+        track_index_init(&index, count);
+        for (size_t i = 0; i < count; i++) track_index_put(&index, tracks[i]->track_id, tracks[i]);
+        free(tracks);
+        uint64_t t3 = tmap_now_ns();
+        free_btree(&engine.arena, root);
+        track_index_free(&index);
+        engine_free(&engine);
+
+        double insert_ms = (t1 - t0) / 1e6;
+        double bulk_ms = (t3 - t2) / 1e6;
+        printf("%10d | %14.1f | %14.1f | %6.2fx\n", n, insert_ms, bulk_ms, insert_ms / bulk_ms);
+    }
+    remove(path);
+    return 0;
+}
+
+/**
+ * @brief 기존 궤적 노드 복제본 (점마다 malloc한 단일 연결 리스트)
+ */
+typedef struct LegacyPoint {
+    double              lat;
+    double              lon;
+    int                 timestamp;
+    struct LegacyPoint* next;
+} LegacyPoint;
+
+/**
+ * @brief 궤적 전체 순회/직렬화: 점 단위 연결 리스트 vs 연속 블록
+ * @note  실제 시뮬레이션처럼 틱마다 모든 표적에 한 점씩 번갈아 추가하므로,
+ *        연결 리스트의 이웃 노드는 메모리상에서 표적 수만큼 떨어져 흩어집니다.
+ */
+static int bench_history(void) {
+    const int n = 20000, ticks = 500;
+    const char* path = "bench_history.dat";
+
+    printf("[BENCH] Trajectory scan (%d tracks x %d waypoints)\n", n, ticks);
+
+    LegacyPoint** heads = (LegacyPoint**)calloc((size_t)n, sizeof(LegacyPoint*));
+    LegacyPoint** tails = (LegacyPoint**)calloc((size_t)n, sizeof(LegacyPoint*));
+    TacticalTrack** tracks = (TacticalTrack**)malloc(sizeof(TacticalTrack*) * (size_t)n);
+    if (heads == NULL || tails == NULL || tracks == NULL) { free(heads); free(tails); free(tracks); return 1; }
+    TmapEngine engine;
+    engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+    for (int i = 0; i < n; i++) tracks[i] = create_track_quiet(&engine, i, 1);
+
+    for (int t = 0; t < ticks; t++) {
+        for (int i = 0; i < n; i++) {
+            double lat = 37.5 + (bench_rand() % 1000) * 1e-6, lon = 127.0 + (bench_rand() % 1000) * 1e-6;
+            LegacyPoint* node = (LegacyPoint*)malloc(sizeof(LegacyPoint));
+            node->lat = lat; node->lon = lon; node->timestamp = t; node->next = NULL;
+            if (heads[i] == NULL) heads[i] = node; else tails[i]->next = node;
+            tails[i] = node;
+            add_history_node(tracks[i], lat, lon, t);
+        }
+    }
+
+    // (1) 전체 순회
+    volatile double sink = 0;
+    uint64_t t0 = tmap_now_ns();
+    for (int i = 0; i < n; i++) {
+        double acc = 0;
+        for (LegacyPoint* p = heads[i]; p != NULL; p = p->next) acc += p->lat + p->lon;
+        sink += acc;
+    }
+    uint64_t t1 = tmap_now_ns();
+    for (int i = 0; i < n; i++) {
+        double acc = 0;
+        HistoryIter it;
+        history_iter_begin(&it, tracks[i]);
+        const HistoryPoint* p;
+        while ((p = history_iter_next(&it)) != NULL) acc += p->lat + p->lon;
+        sink += acc;
+    }
+    uint64_t t2 = tmap_now_ns();
+
+    // (2) 저장 파일 직렬화 (점마다 fwrite 3회 vs 블록마다 1회)
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL) { printf("[BENCH] Cannot write '%s'.\n", path); return 1; }
+    uint64_t t3 = tmap_now_ns();
+    for (int i = 0; i < n; i++) {
+        int header[4] = { i, 1, TRACK_STATUS_ACTIVE, ticks };
+        fwrite(header, sizeof(int), 4, fp);
+        for (LegacyPoint* p = heads[i]; p != NULL; p = p->next) {
+            fwrite(&p->lat, sizeof(double), 1, fp);
+            fwrite(&p->lon, sizeof(double), 1, fp);
+            fwrite(&p->timestamp, sizeof(int), 1, fp);
+        }
+    }
+    fflush(fp);
+    uint64_t t4 = tmap_now_ns();
+    rewind(fp);
+    uint64_t t5 = tmap_now_ns();
+    for (int i = 0; i < n; i++) save_single_track(tracks[i], fp);
+    fflush(fp);
+    uint64_t t6 = tmap_now_ns();
+    fclose(fp);
+    remove(path);
+
+    printf("%10s | %14s | %14s | %7s\n", "pass", "linked ms", "block ms", "speedup");
+    printf("%10s | %14.1f | %14.1f | %6.2fx\n", "iterate", (t1 - t0) / 1e6, (t2 - t1) / 1e6,
+           (double)(t1 - t0) / (double)(t2 - t1));
+    printf("%10s | %14.1f | %14.1f | %6.2fx\n", "serialize", (t4 - t3) / 1e6, (t6 - t5) / 1e6,
+           (double)(t4 - t3) / (double)(t6 - t5));
+
+    for (int i = 0; i < n; i++) {
+        LegacyPoint* p = heads[i];
+        while (p != NULL) { LegacyPoint* next = p->next; free(p); p = next; }
+        free_track(tracks[i]);
+    }
+    engine_free(&engine);
+    free(heads);
+    free(tails);
+    free(tracks);
+    (void)sink;
+    return 0;
+}
+
+// 콜드 스토리지 대역: 넘겨받은 점 개수만 센다
+static void soak_cold_sink(const TacticalTrack* track, const HistoryPoint* points, int count, void* ctx) {
+    (void)track; (void)points;
+    *(size_t*)ctx += (size_t)count;
+}
+
+/**
+ * @brief 궤적 보존 정책 장시간 구동(soak) 검증
+ * @note  모든 표적에 틱마다 한 점씩 끝없이 추가하면서 궤적 풀의 슬랩 수를 관찰합니다.
+ *        워밍업 이후 슬랩이 하나라도 늘면 메모리가 표적 수가 아닌 시간에 비례한다는 뜻이므로 실패입니다.
+ */
+static int bench_soak(void) {
+    const int n = 5000, ticks = 12000, report = 2000;  // 10 Hz 기준 20분 구동
+    static const struct { int max_points, max_age; } policies[] = { { 600, 0 }, { 0, 30 } };
+    int rc = 0;
+
+    printf("[BENCH] Retention soak (%d tracks x %d ticks @ 10 Hz)\n", n, ticks);
+
+    for (size_t c = 0; c < sizeof(policies) / sizeof(policies[0]); c++) {
+        size_t cold_points = 0;
+        HistoryRetention policy = { policies[c].max_points, policies[c].max_age, soak_cold_sink, &cold_points, false };
+        TacticalTrack** tracks = (TacticalTrack**)malloc(sizeof(TacticalTrack*) * (size_t)n);
+        if (tracks == NULL) return 1;
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        engine.retention = policy;
+        for (int i = 0; i < n; i++) tracks[i] = create_track_quiet(&engine, i, 1);
+
+        printf("  policy: %d points / %d s\n", policy.max_points, policy.max_age);
+        printf("%10s | %12s | %10s | %12s | %14s\n", "tick", "live points", "blocks", "slab KiB", "cold points");
+
+        size_t warm_slabs = 0;
+        uint64_t t0 = tmap_now_ns();
+        for (int t = 1; t <= ticks; t++) {
+            for (int i = 0; i < n; i++) add_history_node(tracks[i], 37.5, 127.0, t / 10);
+            if (t % report != 0) continue;
+
+            size_t live_points = 0;
+            for (int i = 0; i < n; i++) live_points += (size_t)tracks[i]->history_count;
+            const TrackArena* arena = &engine.arena;
+            size_t slabs = arena->history.slab_count + arena->history_head.slab_count;
+            printf("%10d | %12zu | %10zu | %12zu | %14zu\n", t, live_points,
+                   arena->history.live + arena->history_head.live, slabs * 64, cold_points);
+            if (t == ticks / 2) warm_slabs = slabs;
+            if (t > ticks / 2 && slabs > warm_slabs) rc = 1;
+        }
+        double ns_per_point = (double)(tmap_now_ns() - t0) / ((double)n * ticks);
+        printf("  %.1f ns per appended point, steady state %s\n", ns_per_point, rc ? "GREW (FAIL)" : "flat (OK)");
+
+        for (int i = 0; i < n; i++) free_track(tracks[i]);
+        free(tracks);
+        engine_free(&engine);
+    }
+    return rc;
+}
+
+// 궤적 풀 전체(원본 + 압축 등급)가 실제로 점유한 바이트
+static size_t history_live_bytes(const TrackArena* arena) {
+    size_t bytes = arena->history_head.live * arena->history_head.object_size +
+                   arena->history.live * arena->history.object_size;
+    for (int i = 0; i < HISTORY_PACKED_CLASSES; i++) {
+        bytes += arena->history_packed[i].live * arena->history_packed[i].object_size;
+    }
+    return bytes;
+}
+
+/**
+ * @brief 궤적 압축률과 비용: 원본 블록 vs Gorilla 압축 블록
+ * @note  입력은 엔진 시뮬레이터와 같은 형태(사인 가감속 + 미세 노이즈, 10 Hz, 초 단위 타임스탬프)와
+ *        정지/순항처럼 좌표 변화가 거의 없는 구간을 섞은 궤적입니다.
+ */
+static int bench_codec(void) {
+    const int n = 2000, ticks = 3600;           // 10 Hz 기준 6분
+    static const char* const shapes[] = { "maneuver", "cruise" };
+
+    printf("[BENCH] Trajectory compression (%d tracks x %d waypoints)\n", n, ticks);
+    printf("%10s | %10s | %12s | %12s | %7s | %11s | %11s\n",
+           "shape", "mode", "history MiB", "B / point", "ratio", "append ns", "iterate ns");
+
+    for (int shape = 0; shape < 2; shape++) {
+        double raw_bytes = 0;
+        for (int mode = 0; mode < 2; mode++) {
+            HistoryRetention policy = { 0, 0, NULL, NULL, mode == 1 };
+            TacticalTrack** tracks = (TacticalTrack**)malloc(sizeof(TacticalTrack*) * (size_t)n);
+            double* lat = (double*)malloc(sizeof(double) * (size_t)n);
+            double* lon = (double*)malloc(sizeof(double) * (size_t)n);
+            if (tracks == NULL || lat == NULL || lon == NULL) { free(tracks); free(lat); free(lon); return 1; }
+            bench_rng_state = 0x9E3779B9u;
+            TmapEngine engine;
+            engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+            engine.retention = policy;
+            for (int i = 0; i < n; i++) {
+                tracks[i] = create_track_quiet(&engine, i, 1);
+                lat[i] = 37.5;
+                lon[i] = 127.0;
+            }
+
+            uint64_t t0 = tmap_now_ns();
+            for (int t = 0; t < ticks; t++) {
+                for (int i = 0; i < n; i++) {
+                    if (shape == 0) {
+                        double speed = 5.5 + 4.5 * sin(t * 0.275);
+                        lat[i] += 0.00008 * speed + ((bench_rand() % 100) / 100.0 - 0.5) * 0.00025;
+                        lon[i] += 0.00008 * speed + ((bench_rand() % 100) / 100.0 - 0.5) * 0.00025;
+                    } else if (t % 50 == 0) {
+                        lat[i] += 0.001;
+                    }
+                    add_history_node(tracks[i], lat[i], lon[i], t / 10);
+                }
+            }
+            uint64_t t1 = tmap_now_ns();
+
+            volatile double sink = 0;
+            for (int i = 0; i < n; i++) {
+                HistoryIter it;
+                history_iter_begin(&it, tracks[i]);
+                const HistoryPoint* p;
+                while ((p = history_iter_next(&it)) != NULL) sink += p->lat;
+            }
+            uint64_t t2 = tmap_now_ns();
+            (void)sink;
+
+            double bytes = (double)history_live_bytes(&engine.arena);
+            if (mode == 0) raw_bytes = bytes;
+            double points = (double)n * ticks;
+            printf("%10s | %10s | %12.1f | %12.2f | %6.2fx | %11.1f | %11.1f\n", shapes[shape],
+                   mode ? "gorilla" : "raw", bytes / (1024.0 * 1024.0), bytes / points, raw_bytes / bytes,
+                   (t1 - t0) / points, (t2 - t1) / points);
+
+            for (int i = 0; i < n; i++) free_track(tracks[i]);
+            engine_free(&engine);
+            free(tracks);
+            free(lat);
+            free(lon);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 시뮬레이션 1틱 비용: B-Tree 순회 + 궤적 꼬리 역참조 vs 실시간 표적 테이블(SoA) 순차 스캔
+ * @note  기존 경로는 표적마다 단말 → 표적 → 꼬리 블록을 차례로 따라가 위치를 읽고,
+ *        방향은 ID로 색인하는 전역 배열에서 읽던 구조를 그대로 재현합니다.
+ *        두 경로 모두 궤적 기록(add_history_node)까지 포함한 한 틱 전체를 잽니다.
+ */
+static int bench_tick(void) {
+    static const int sizes[] = { 10000, 100000, 1000000 };
+    const int ticks = 20;
+    enum { LEGACY_DIRS = 10000 };
+    static int legacy_dir_lat[LEGACY_DIRS], legacy_dir_lon[LEGACY_DIRS];
+
+    printf("[BENCH] Simulation tick (%d ticks, incl. history append)\n", ticks);
+    printf("%10s | %16s | %16s | %7s\n", "tracks", "btree ns/track", "SoA ns/track", "speedup");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int* ids = make_sparse_ids(n);
+        if (ids == NULL) return 1;
+
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        BTreeNode* root = NULL;
+        for (int i = 0; i < n; i++) {
+            TacticalTrack* track = create_track_quiet(&engine, ids[i], 1);
+            add_history_node(track, 37.5, 127.0, 0);
+            btree_insert(&engine.arena, &root, track);
+        }
+        for (int i = 0; i < LEGACY_DIRS; i++) { legacy_dir_lat[i] = 1; legacy_dir_lon[i] = 1; }
+
+        // (1) 기존 경로
+        uint64_t t0 = tmap_now_ns();
+        for (int t = 1; t <= ticks; t++) {
+            BTreeCursor cur;
+            btree_cursor_first(&cur, root);
+            TacticalTrack* track;
+            while ((track = btree_cursor_next(&cur)) != NULL) {
+                const HistoryPoint* last = history_last(track);
+                if (track->status != TRACK_STATUS_ACTIVE || last == NULL) continue;
+                int safe_id = track->track_id % LEGACY_DIRS;
+                double base_s_lat = ((track->track_id % 5) - 2) * 0.00008;
+                double base_s_lon = ((track->track_id % 7) - 3) * 0.00008;
+                if (base_s_lat == 0 && base_s_lon == 0) { base_s_lat = 0.00006; base_s_lon = 0.00006; }
+                double speed_modifier = 5.5 + 4.5 * sin(track->history_count * 0.275);
+                double noise_lat = ((rand() % 100) / 100.0 - 0.5) * 0.00025;
+                double noise_lon = ((rand() % 100) / 100.0 - 0.5) * 0.00025;
+                double next_lat = last->lat + (base_s_lat * speed_modifier) * legacy_dir_lat[safe_id] + noise_lat;
+                double next_lon = last->lon + (base_s_lon * speed_modifier) * legacy_dir_lon[safe_id] + noise_lon;
+                if (next_lat > MAX_LAT || next_lat < MIN_LAT) legacy_dir_lat[safe_id] *= -1;
+                if (next_lon > MAX_LON || next_lon < MIN_LON) legacy_dir_lon[safe_id] *= -1;
+                add_history_node(track, next_lat, next_lon, t);
+            }
+        }
+        uint64_t t1 = tmap_now_ns();
+
+        // (2) SoA 경로 (엔진의 simulate_flight)
+        for (int t = 1; t <= ticks; t++) simulate_flight(&engine, (uint32_t)t, t);
+        uint64_t t2 = tmap_now_ns();
+
+        double legacy_ns = (double)(t1 - t0) / ((double)n * ticks);
+        double soa_ns = (double)(t2 - t1) / ((double)n * ticks);
+        printf("%10d | %16.1f | %16.1f | %6.2fx\n", n, legacy_ns, soa_ns, legacy_ns / soa_ns);
+
+        free_btree(&engine.arena, root);
+        engine_free(&engine);
+        free(ids);
+    }
+    return 0;
+}
+
+/**
+ * @brief 병렬 틱 강한 확장성: 표적 수를 고정하고 작업자 수만 늘려 틱 시간을 비교
+ * @note  작업자 수마다 같은 표적 집합을 새로 만들어 같은 틱 수를 돌립니다. 첫 블록(8점)이
+ *        차서 새 블록을 빌리는 틱이 포함되므로 공유 풀 잠금 구간도 측정에 들어갑니다.
+ *        하드웨어 스레드보다 많은 작업자는 이득이 없으므로 코어 수와 함께 해석합니다.
+ *        라운드마다 등록 순서(행 순서)도 뒤집어, 최종 위치가 직렬 실행과 비트 단위로 같은지 확인합니다.
+ */
+static int bench_parallel_tick(void) {
+    static const int threads[] = { 1, 2, 4, 8, 16 };
+    const int n = 500000;
+    const int ticks = 32;
+    const double budget_ms = 100.0;
+
+    printf("[BENCH] Parallel simulation tick (%d tracks, %d ticks, tick budget %.0f ms)\n", n, ticks, budget_ms);
+    printf("%8s | %12s | %8s | %10s | %9s | %s\n", "threads", "ms/tick", "speedup", "efficiency", "in budget", "same result");
+
+    // k = -1: 슬랩 메모리를 한 번 건드려 두는 예열 라운드 (첫 측정만 페이지 폴트를 떠안지 않도록)
+    double serial_ms = 0.0;
+    uint64_t serial_digest = 0;
+    int rc = 0;
+    for (int k = -1; k < (int)(sizeof(threads) / sizeof(threads[0])); k++) {
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        for (int i = 0; i < n; i++) {
+            int id = (k & 1) ? n - 1 - i : i;
+            add_history_node(create_track_quiet(&engine, id, 1), 37.5, 127.0, 0);
+        }
+        WorkerPool pool;
+        worker_pool_init(&pool, k < 0 ? 1 : threads[k]);
+        engine.workers = &pool;
+
+        uint64_t t0 = tmap_now_ns();
+        for (int t = 1; t <= ticks; t++) simulate_flight(&engine, (uint32_t)t, t);
+        double ms = (double)(tmap_now_ns() - t0) / 1e6 / ticks;
+        uint64_t digest = live_table_digest(&engine.live);
+
+        worker_pool_free(&pool);
+        engine_free(&engine);
+
+        if (k < 0) continue;
+        if (k == 0) { serial_ms = ms; serial_digest = digest; }
+        double speedup = serial_ms / ms;
+        if (digest != serial_digest) rc = 1;
+        printf("%8d | %12.2f | %7.2fx | %9.0f%% | %9s | %s\n", threads[k], ms, speedup,
+               100.0 * speedup / threads[k], ms <= budget_ms ? "yes" : "NO", digest == serial_digest ? "yes" : "NO");
+    }
+    return rc;
+}
+
+/**
+ * @brief 운동 커널 도입 전 스칼라 경로 (libm sin, 분기 반사) 재현, 선회는 커널과 같은 식
+ */
+static void legacy_kinematics_rows(LiveTable* live, size_t begin, size_t end, uint64_t seed, uint32_t tick) {
+    for (size_t i = begin; i < end; i++) {
+        double speed_modifier = 5.5 + 4.5 * sin(live->phase[i]++ * 0.275);
+        uint64_t r = tmap_rng_at(seed, live->id[i], tick);
+        double noise_lat = (((uint32_t)r % 100) / 100.0 - 0.5) * 0.00025;
+        double noise_lon = (((uint32_t)(r >> 32) % 100) / 100.0 - 0.5) * 0.00025;
+        double vel_lat = live->vel_lat[i] * live->turn_cos[i] - live->vel_lon[i] * live->turn_sin[i];
+        double vel_lon = live->vel_lat[i] * live->turn_sin[i] + live->vel_lon[i] * live->turn_cos[i];
+        live->vel_lat[i] = vel_lat;
+        live->vel_lon[i] = vel_lon;
+        double next_lat = live->lat[i] + (vel_lat * speed_modifier) * live->dir_lat[i] + noise_lat;
+        double next_lon = live->lon[i] + (vel_lon * speed_modifier) * live->dir_lon[i] + noise_lon;
+        if (next_lat > MAX_LAT || next_lat < MIN_LAT) live->dir_lat[i] = (int8_t)-live->dir_lat[i];
+        if (next_lon > MAX_LON || next_lon < MIN_LON) live->dir_lon[i] = (int8_t)-live->dir_lon[i];
+        live->lat[i] = next_lat;
+        live->lon[i] = next_lon;
+    }
+}
+
+/**
+ * @brief 운동 커널 마이크로벤치마크: 기존 스칼라 경로 vs 커널별 (궤적 기록 제외, 1단계만)
+ * @note  매 실행 전 같은 초기 상태로 되돌리고, 커널끼리 최종 상태가 비트 단위로 같은지 확인합니다.
+ *        기존 경로는 libm sin을 쓰므로 요약값이 다를 수 있으며, 위치 차이의 최대값을 함께 보입니다.
+ */
+static int bench_kinematics(void) {
+    static const char* const kernels[] = { "scalar", "sse2", "avx2" };
+    const int n = 100000;
+    const int ticks = 200;
+    const uint64_t seed = TMAP_RNG_DEFAULT_SEED;
+
+    // 표적마다 다른 위상과 위치에서 시작 (경계 반사가 골고루 일어나도록), 4대 중 1대는 선회 비행
+    TmapEngine engine;
+    engine_init(&engine, seed);
+    LiveTable* live = &engine.live;
+    for (int i = 0; i < n; i++) {
+        TacticalTrack* track = create_track_quiet(&engine, i, 1);
+        track->motion.phase = bench_rand() % 100000;
+        if (i % 4 == 0) track->motion.turn = 0.001 * (1 + i % 20);
+        add_history_node(track, 37.45 + 0.1 * (i % 1000) / 1000.0, 126.93 + 0.14 * (i % 997) / 997.0, 0);
+    }
+    size_t rows = live->count;
+    double* lat0 = (double*)malloc(sizeof(double) * rows);
+    double* lon0 = (double*)malloc(sizeof(double) * rows);
+    double* vel_lat0 = (double*)malloc(sizeof(double) * rows);
+    double* vel_lon0 = (double*)malloc(sizeof(double) * rows);
+    double* lat_ref = (double*)malloc(sizeof(double) * rows);
+    uint32_t* phase0 = (uint32_t*)malloc(sizeof(uint32_t) * rows);
+    if (lat0 == NULL || lon0 == NULL || vel_lat0 == NULL || vel_lon0 == NULL || lat_ref == NULL || phase0 == NULL) return 1;
+    memcpy(lat0, live->lat, sizeof(double) * rows);
+    memcpy(vel_lat0, live->vel_lat, sizeof(double) * rows);
+    memcpy(vel_lon0, live->vel_lon, sizeof(double) * rows);
+    memcpy(lon0, live->lon, sizeof(double) * rows);
+    memcpy(phase0, live->phase, sizeof(uint32_t) * rows);
+
+    printf("[BENCH] Flight kinematics (%d tracks, %d ticks, history append excluded)\n", n, ticks);
+    printf("%10s | %12s | %8s | %s\n", "kernel", "ns/track", "speedup", "same result as scalar kernel");
+
+    const char* chosen = kinematics_select(NULL);
+    double legacy_ns = 0.0;
+    uint64_t scalar_digest = 0;
+    int rc = 0;
+    for (int k = -1; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++) {
+        if (k >= 0 && kinematics_select(kernels[k]) == NULL) {
+            printf("%10s | %12s | %8s | not supported on this CPU\n", kernels[k], "-", "-");
+            continue;
+        }
+        memcpy(live->lat, lat0, sizeof(double) * rows);
+        memcpy(live->lon, lon0, sizeof(double) * rows);
+        memcpy(live->vel_lat, vel_lat0, sizeof(double) * rows);
+        memcpy(live->vel_lon, vel_lon0, sizeof(double) * rows);
+        memcpy(live->phase, phase0, sizeof(uint32_t) * rows);
+        memset(live->dir_lat, 1, rows);
+        memset(live->dir_lon, 1, rows);
+
+        uint64_t t0 = tmap_now_ns();
+        for (int t = 1; t <= ticks; t++) {
+            if (k < 0) legacy_kinematics_rows(live, 0, rows, seed, (uint32_t)t);
+            else kinematics_step(live, 0, rows, 1, seed, (uint32_t)t);
+        }
+        double ns = (double)(tmap_now_ns() - t0) / ((double)rows * ticks);
+        uint64_t digest = live_table_digest(live);
+
+        if (k < 0) {
+            legacy_ns = ns;
+            memcpy(lat_ref, live->lat, sizeof(double) * rows);
+            printf("%10s | %12.2f | %7.2fx | (libm sin reference)\n", "legacy", ns, 1.0);
+            continue;
+        }
+        if (k == 0) {
+            scalar_digest = digest;
+            double max_diff = 0.0;
+            for (size_t i = 0; i < rows; i++) {
+                double d = fabs(live->lat[i] - lat_ref[i]);
+                if (d > max_diff) max_diff = d;
+            }
+            printf("%10s | %12.2f | %7.2fx | yes (max |lat - legacy| = %.2e deg)\n",
+                   kernels[k], ns, legacy_ns / ns, max_diff);
+            continue;
+        }
+        if (digest != scalar_digest) rc = 1;
+        printf("%10s | %12.2f | %7.2fx | %s\n", kernels[k], ns, legacy_ns / ns,
+               digest == scalar_digest ? "yes" : "NO");
+    }
+    printf("[BENCH] Engine default kernel on this CPU: %s\n", chosen);
+    kinematics_select(chosen);
+
+    free(lat0); free(lon0); free(vel_lat0); free(vel_lon0); free(lat_ref); free(phase0);
+    engine_free(&engine);
+    return rc;
+}
+
+// 박자 검사용 표적 투입: 투입 시점의 위상과 마지막 시뮬레이션 틱을 기록
+static void bench_lod_spawn(TmapEngine* engine, int id, uint32_t* born, uint32_t* phase0) {
+    int threat = 1 + (int)(bench_rand() % 4);
+    double lat = 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0;
+    double lon = 126.93 + 0.14 * (bench_rand() % 10000) / 10000.0;
+    if (!deploy_target(engine, id, threat, lat, lon, (int)engine->live.tick)) return;
+    TacticalTrack* track = track_index_get(&engine->index, id);
+    born[id] = engine->live.tick;
+    phase0[id] = engine->live.phase[track->live_slot];
+}
+
+/**
+ * @brief 다중 주기 박자 검사: 표적을 계속 투입/요격하는 동안 표적마다 적분한 틱 수가 경과 틱 수를 따라가는지
+ * @note  적분한 틱 수는 행의 가감속 위상(갱신마다 적분 틱 수만큼 증가)으로 셉니다. 틱이 끝날 때마다
+ *        모든 표적에서 (경과 틱 - 적분 틱)이 0 이상, 지금 단계의 갱신 주기 미만이어야 합니다.
+ *        행 수가 바뀔 때마다 재배정이 일어나므로 단계 1~3의 조각이 틱 중간에 다시 나뉘는 경우를 덮습니다.
+ */
+static int bench_lod_cadence(void) {
+    const int initial = 2000;
+    const int ticks = 800;
+    const int ids = initial + ticks;
+    uint32_t* born = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)ids);
+    uint32_t* phase0 = (uint32_t*)malloc(sizeof(uint32_t) * (size_t)ids);
+    bool* flagged = (bool*)calloc((size_t)ids, sizeof(bool));     // 한 번이라도 어긋난 표적
+    if (born == NULL || phase0 == NULL || flagged == NULL) return 1;
+
+    TmapEngine engine;
+    engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+    engine.lod.enabled = true;
+    LiveTable* live = &engine.live;
+
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    bench_rng_state = 0x2545F491u;
+    int next_id = 0;
+    for (; next_id < initial; next_id++) bench_lod_spawn(&engine, next_id, born, phase0);
+
+    size_t adds = 0, kills = 0, drifted = 0;
+    int64_t worst = 0;
+    for (int t = 1; t <= ticks; t++) {
+        simulate_flight(&engine, (uint32_t)t, t);
+
+        int tier = 0;
+        for (size_t r = 0; r < live->count; r++) {
+            while (tier < LOD_TIERS - 1 && r >= live->tier_end[tier]) tier++;
+            int id = live->id[r];
+            int64_t drift = (int64_t)((uint32_t)t - born[id]) - (int64_t)(live->phase[r] - phase0[id]);
+            if (llabs(drift) > worst) worst = llabs(drift);
+            if ((drift < 0 || drift >= (1 << tier)) && !flagged[id]) { flagged[id] = true; drifted++; }
+        }
+
+        // 틱 사이 명령: 3틱마다 투입, 4틱마다 요격
+        if (t % 3 == 0) { bench_lod_spawn(&engine, next_id++, born, phase0); adds++; }
+        if (t % 4 == 0 && live->count > 0) {
+            if (kill_target(&engine, live->id[bench_rand() % live->count])) kills++;
+            compact_tombstones(&engine, 0);
+        }
+    }
+    tmap_log_waypoints = log_waypoints;
+
+    printf("[BENCH] Cadence under churn (%d ticks, %zu adds, %zu kills): %zu of %zu tracks drifted a full stride "
+           "or more from the elapsed ticks (max drift %lld ticks): %s\n",
+           ticks, adds, kills, drifted, (size_t)next_id, (long long)worst, drifted ? "NO" : "ok");
+
+    engine_free(&engine);
+    free(born); free(phase0); free(flagged);
+    return drifted ? 1 : 0;
+}
+
+/**
+ * @brief 다중 주기 시뮬레이션: 전 표적 매 틱 갱신 vs 위협도/거리 단계별 갱신 (궤적 기록 포함)
+ * @note  같은 군집(대부분 저위협, 20대 중 1대 고위협)을 모드마다 새로 만들어 같은 틱 수를 돌리고,
+ *        최종 위치를 매 틱 갱신 결과와 표적 ID로 맞대어 단계별 위치 오차를 봅니다.
+ *        내내 단계 0에 있던 표적은 매 틱 갱신과 비트 단위로 같아야 합니다.
+ */
+static int bench_lod(void) {
+    const int n = 100000;
+    const int ticks = 40;
+    static const struct { const char* name; bool enabled; size_t budget[LOD_TIERS - 1]; } modes[] = {
+        { "full rate", false, { 0, 0, 0 } },
+        { "lod", true, { 0, 0, 0 } },
+        { "lod+budget", true, { 4000, 8000, 16000 } },
+    };
+
+    double* ref_lat = (double*)malloc(sizeof(double) * (size_t)n);
+    double* ref_lon = (double*)malloc(sizeof(double) * (size_t)n);
+    int* tier_of = (int*)malloc(sizeof(int) * (size_t)n);
+    bool* pinned = (bool*)malloc(sizeof(bool) * (size_t)n);   // 첫 배정부터 끝까지 단계 0
+    if (ref_lat == NULL || ref_lon == NULL || tier_of == NULL || pinned == NULL) return 1;
+
+    printf("[BENCH] Multi-rate simulation (%d tracks in a swarm, %d ticks, incl. history append)\n", n, ticks);
+    printf("%12s | %29s | %10s | %8s | %s\n", "mode", "tracks in tier 0/1/2/3", "ms/tick", "speedup",
+           "mean position error per tier [m]");
+
+    double full_ms = 0.0;
+    int rc = 0;
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        LodPolicy* lod = &engine.lod;
+        LiveTable* live = &engine.live;
+        lod->enabled = modes[m].enabled;
+        for (int t = 0; t < LOD_TIERS - 1; t++) lod->budget[t] = modes[m].budget[t];
+
+        bench_rng_state = 0x9E3779B9u;
+        for (int i = 0; i < n; i++) {
+            int threat = (i % 20 == 0) ? 8 : 1 + (int)(bench_rand() % 4);
+            double lat = 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0;
+            double lon = 126.93 + 0.14 * (bench_rand() % 10000) / 10000.0;
+            add_history_node(create_track_quiet(&engine, i, threat), lat, lon, 0);
+        }
+        for (int i = 0; i < n; i++) pinned[i] = true;
+
+        uint64_t t0 = tmap_now_ns();
+        for (int t = 1; t <= ticks; t++) {
+            simulate_flight(&engine, (uint32_t)t, t);
+            if (!lod->enabled) continue;
+            for (size_t r = live->tier_end[0]; r < live->count; r++) pinned[live->id[r]] = false;
+        }
+        double ms = (double)(tmap_now_ns() - t0) / 1e6 / ticks;
+
+        size_t tier_rows[LOD_TIERS] = { 0 };
+        double tier_error[LOD_TIERS] = { 0 };
+        for (size_t r = 0; r < live->count; r++) {
+            int tier = 0;
+            if (lod->enabled) while (tier < LOD_TIERS - 1 && r >= live->tier_end[tier]) tier++;
+            tier_of[live->id[r]] = tier;
+            tier_rows[tier]++;
+            int id = live->id[r];
+            if (m == 0) {
+                ref_lat[id] = live->lat[r];
+                ref_lon[id] = live->lon[r];
+                continue;
+            }
+            double d_lat = (live->lat[r] - ref_lat[id]) * 111320.0;
+            double d_lon = (live->lon[r] - ref_lon[id]) * 111320.0 * LON_SCALE;
+            tier_error[tier] += sqrt(d_lat * d_lat + d_lon * d_lon);
+            if (pinned[id] && (live->lat[r] != ref_lat[id] || live->lon[r] != ref_lon[id])) rc = 1;
+        }
+        if (m == 0) full_ms = ms;
+
+        char tiers[64], errors[64];
+        snprintf(tiers, sizeof(tiers), "%zu/%zu/%zu/%zu", tier_rows[0], tier_rows[1], tier_rows[2], tier_rows[3]);
+        if (m == 0) snprintf(errors, sizeof(errors), "(reference)");
+        else {
+            int len = 0;
+            for (int t = 0; t < LOD_TIERS; t++) {
+                len += snprintf(errors + len, sizeof(errors) - (size_t)len, t ? " / %.0f" : "%.0f",
+                                tier_rows[t] ? tier_error[t] / (double)tier_rows[t] : 0.0);
+            }
+        }
+        printf("%12s | %29s | %10.2f | %7.2fx | %s\n", modes[m].name, tiers, ms, full_ms / ms, errors);
+
+        engine_free(&engine);
+    }
+    printf("[BENCH] Tracks pinned to tier 0 for the whole run match full rate bit-for-bit: %s\n", rc ? "NO" : "yes");
+
+    free(ref_lat); free(ref_lon); free(tier_of); free(pinned);
+    return bench_lod_cadence() | rc;
+}
+
+// 틱 처리 시간 흉내: 지정한 시간만큼 CPU를 점유 (sleep과 달리 스케줄러 지연이 섞이지 않음)
+static void bench_busy_ns(uint64_t ns) {
+    uint64_t until = tmap_now_ns() + ns;
+    while (tmap_now_ns() < until) { }
+}
+
+// 틱 k의 합성 부하: 평소 2~8 ms, 40틱마다 주기의 3.5배 짜리 스파이크 (대량 로드/저장 흉내)
+static uint64_t bench_tick_load_ns(uint64_t k, uint64_t period_ns) {
+    if (k % 40 == 39) return period_ns * 7 / 2;
+    return 2000000ull + (uint64_t)(bench_rand() % 6000000u);
+}
+
+/**
+ * @brief 틱 주기 안정성: 기존 "처리 후 상대 Sleep" vs 절대 마감 스케줄러 (따라잡기/건너뛰기)
+ * @note  각 방식을 같은 벽시계 시간 동안 돌려 실제로 진행된 시뮬레이션 틱 수로 달성 주파수를 잽니다.
+ *        기존 방식은 주기가 (period + 처리 시간)으로 늘어나고, 스케줄러는 부하와 무관하게 목표 주파수를 지킵니다.
+ */
+static int bench_scheduler(void) {
+    const int hz = 100;
+    const uint64_t period = 1000000000ull / hz;
+    const uint64_t run_ns = 3000000000ull;
+
+    printf("[BENCH] Tick scheduler (target %d Hz, %.1f s per mode, load 2-8 ms + 35 ms spike every 40 ticks)\n",
+           hz, run_ns / 1e9);
+    printf("%14s | %9s | %12s | %9s | %8s | %15s\n",
+           "mode", "sim ticks", "achieved Hz", "overruns", "skipped", "max jitter [us]");
+
+    // 기존 방식: 처리 후 period만큼 상대 대기 -> 실제 주기 = period + 처리 시간
+    bench_rng_state = 0x9E3779B9u;
+    uint64_t start = tmap_now_ns();
+    uint64_t ticks = 0;
+    while (tmap_now_ns() - start < run_ns) {
+        bench_busy_ns(bench_tick_load_ns(ticks, period));
+        ticks++;
+        tmap_sleep_until_ns(tmap_now_ns() + period);
+    }
+    double elapsed = (double)(tmap_now_ns() - start) / 1e9;
+    printf("%14s | %9llu | %12.2f | %9s | %8s | %15s\n", "legacy sleep",
+           (unsigned long long)ticks, (double)ticks / elapsed, "-", "-", "-");
+
+    static const TickPolicy policies[] = { TICK_POLICY_CATCH_UP, TICK_POLICY_SKIP };
+    TickScheduler scheds[2];
+    for (int p = 0; p < 2; p++) {
+        TickScheduler* sched = &scheds[p];
+        bench_rng_state = 0x9E3779B9u;
+        tick_scheduler_init(sched, hz, policies[p]);
+        start = tmap_now_ns();
+        ticks = 0;
+        while (tmap_now_ns() - start < run_ns) {
+            uint32_t steps = tick_scheduler_wait(sched);
+            for (uint32_t s = 0; s < steps; s++) bench_busy_ns(bench_tick_load_ns(ticks++, period));
+            tick_scheduler_end(sched);
+        }
+        elapsed = (double)(tmap_now_ns() - start) / 1e9;
+        printf("%14s | %9llu | %12.2f | %9llu | %8llu | %15.1f\n",
+               policies[p] == TICK_POLICY_CATCH_UP ? "deadline/catch" : "deadline/skip",
+               (unsigned long long)ticks, (double)ticks / elapsed,
+               (unsigned long long)sched->overruns, (unsigned long long)sched->skipped, sched->jitter_max_ns / 1e3);
+    }
+    for (int p = 0; p < 2; p++) tick_scheduler_report(&scheds[p]);
+    return 0;
+}
+
+/**
+ * @brief 시나리오 부하 생성: 스크립트 펼치기 → 전 표적 투입 → 첫 틱 (scenarios/stress_*.scn)
+ * @note  저장소 루트나 server/ 에서 실행합니다. 투입은 시각과 무관하게 스크립트의 ADD를 모두 반영하므로
+ *        "부팅 직후 표적 N대가 한꺼번에 들어온" 최악의 경우를 잽니다.
+ */
+static int bench_scenario(void) {
+    static const char* const files[] = { "stress_10k.scn", "stress_100k.scn", "stress_1m.scn" };
+    const int ticks = 5;
+
+    printf("[BENCH] Scenario load generator (expand + ingest all ADDs + %d ticks)\n", ticks);
+    printf("%16s | %9s | %10s | %13s | %10s\n", "scenario", "tracks", "expand ms", "ingest ns/trk", "ms/tick");
+
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    int rc = 0;
+    for (size_t f = 0; f < sizeof(files) / sizeof(files[0]); f++) {
+        char path[128];
+        snprintf(path, sizeof(path), "scenarios/%s", files[f]);
+        FILE* probe = fopen(path, "r");
+        if (probe == NULL) snprintf(path, sizeof(path), "../scenarios/%s", files[f]);
+        else fclose(probe);
+
+        EventQueue queue = { 0 };
+        uint64_t end_ns = 0;
+        uint64_t t0 = tmap_now_ns();
+        if (!scenario_load(path, &queue, 0, &end_ns)) {
+            printf("[BENCH] Run from the repository root or server/ so that '%s' is found.\n", files[f]);
+            event_queue_free(&queue);
+            rc = 1;
+            break;
+        }
+        uint64_t t1 = tmap_now_ns();
+
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        SimEvent ev;
+        size_t tracks = 0;
+        while (event_queue_pop(&queue, &ev)) {
+            if (ev.type == SIM_EVENT_ADD && deploy_target(&engine, ev.track_id, ev.threat, ev.lat, ev.lon, 0)) tracks++;
+        }
+        uint64_t t2 = tmap_now_ns();
+        for (int t = 1; t <= ticks; t++) simulate_flight(&engine, (uint32_t)t, t);
+        uint64_t t3 = tmap_now_ns();
+
+        printf("%16s | %9zu | %10.1f | %13.1f | %10.2f\n", files[f], tracks, (t1 - t0) / 1e6,
+               tracks ? (double)(t2 - t1) / (double)tracks : 0.0, (t3 - t2) / 1e6 / ticks);
+        engine_free(&engine);
+        event_queue_free(&queue);
+    }
+    tmap_log_waypoints = log_waypoints;
+    return rc;
+}
+
+/**
+ * @brief v2 프레임 검증용 디코더 (클라이언트 DecodeDatagram과 같은 규칙, 표적 ID = 배열 번호)
+ */
+typedef struct {
+    int         max_id;
+    int32_t*    base;           // 표적별 [위도, 경도, 위협도] 기준 상태
+    int32_t*    cur;            // 표적별 [위도, 경도, 위협도, 상태] 해석 결과
+    int32_t*    epoch;          // 기준 상태의 키프레임 번호 (-1 = 없음)
+    int         errors;         // 형식 오류 수
+} BenchWireView;
+
+static void bench_wire_decode(const void* datagram, size_t len, void* ctx) {
+    BenchWireView* v = (BenchWireView*)ctx;
+    const unsigned char* buf = (const unsigned char*)datagram;
+    TrackDeltaHeader hdr;
+    if (len < sizeof(hdr)) { v->errors++; return; }
+    memcpy(&hdr, buf, sizeof(hdr));
+    if (hdr.frame.magic != TRACK_FRAME_MAGIC || hdr.frame.version != TRACK_FRAME_VERSION_DELTA) { v->errors++; return; }
+
+    int pos = (int)sizeof(hdr);
+    uint32_t u;
+    int32_t id = 0, lat = 0, lon = 0;
+    bool keyframe = (hdr.frame.flags & TRACK_FRAME_FLAG_KEYFRAME) != 0;
+    for (int r = 0; r < hdr.frame.count; r++) {
+        if (!packet_get_varint(buf, (int)len, &pos, &u)) { v->errors++; return; }
+        id = (int32_t)((uint32_t)id + (uint32_t)packet_unzigzag(u));
+        if (id < 0 || id >= v->max_id) { v->errors++; return; }
+        int32_t* base = &v->base[id * 3];
+        int32_t* cur = &v->cur[id * 4];
+        uint8_t mask = TRACK_DELTA_LAT | TRACK_DELTA_LON | TRACK_DELTA_THREAT | TRACK_DELTA_STATUS;
+        if (!keyframe) {
+            if (pos >= (int)len) { v->errors++; return; }
+            mask = buf[pos++];
+        }
+        int32_t f_lat = 0, f_lon = 0;
+        uint32_t threat = 0, status = 0;
+        if (mask & TRACK_DELTA_LAT) {
+            if (!packet_get_varint(buf, (int)len, &pos, &u)) { v->errors++; return; }
+            f_lat = packet_unzigzag(u);
+        }
+        if (mask & TRACK_DELTA_LON) {
+            if (!packet_get_varint(buf, (int)len, &pos, &u)) { v->errors++; return; }
+            f_lon = packet_unzigzag(u);
+        }
+        if ((mask & TRACK_DELTA_THREAT) && !packet_get_varint(buf, (int)len, &pos, &threat)) { v->errors++; return; }
+        if (mask & TRACK_DELTA_STATUS) {
+            if (pos >= (int)len) { v->errors++; return; }
+            status = buf[pos++];
+        }
+
+        if (keyframe) {
+            lat = (int32_t)((uint32_t)lat + (uint32_t)f_lat);
+            lon = (int32_t)((uint32_t)lon + (uint32_t)f_lon);
+            base[0] = cur[0] = lat; base[1] = cur[1] = lon; base[2] = cur[2] = (int32_t)threat;
+            cur[3] = (int32_t)status;
+            v->epoch[id] = hdr.key_epoch;
+        } else if ((mask & TRACK_DELTA_STATUS) && status == 0) {
+            cur[3] = 0;
+        } else if (mask & TRACK_DELTA_ABSOLUTE) {
+            cur[0] = f_lat; cur[1] = f_lon; cur[2] = (int32_t)threat; cur[3] = (int32_t)status;
+        } else if (v->epoch[id] == hdr.key_epoch) {
+            cur[0] = (mask & TRACK_DELTA_LAT) ? (int32_t)((uint32_t)base[0] + (uint32_t)f_lat) : base[0];
+            cur[1] = (mask & TRACK_DELTA_LON) ? (int32_t)((uint32_t)base[1] + (uint32_t)f_lon) : base[1];
+            cur[2] = (mask & TRACK_DELTA_THREAT) ? (int32_t)threat : base[2];
+        }
+    }
+    if (pos != (int)len) v->errors++;
+}
+
+// 해석 결과가 실시간 표적 테이블(마이크로도 양자화)과 같은지, 요격된 표적이 사라졌다고 해석됐는지
+static bool bench_wire_matches(const BenchWireView* v, const LiveTable* live, const bool* alive) {
+    for (size_t r = 0; r < live->count; r++) {
+        const int32_t* cur = &v->cur[live->id[r] * 4];
+        if (cur[0] != (int32_t)llround(live->lat[r] * TRACK_COORD_SCALE) ||
+            cur[1] != (int32_t)llround(live->lon[r] * TRACK_COORD_SCALE) ||
+            cur[2] != live->threat[r] || cur[3] != TRACK_STATUS_ACTIVE) return false;
+    }
+    for (int id = 0; id < v->max_id; id++) {
+        if (!alive[id] && v->cur[id * 4 + 3] == TRACK_STATUS_ACTIVE) return false;
+    }
+    return v->errors == 0;
+}
+
+/**
+ * @brief v2 인코더 검증: 틱마다 해석 결과가 실시간 표적 테이블과 같은지 (요격, 추가, 같은 ID 재투입 포함)
+ */
+static bool bench_wire_verify(int n, int ticks) {
+    const int max_id = n + n / 10;
+    BenchWireView view = { max_id, NULL, NULL, NULL, 0 };
+    view.base = (int32_t*)calloc((size_t)max_id * 3, sizeof(int32_t));
+    view.cur = (int32_t*)calloc((size_t)max_id * 4, sizeof(int32_t));
+    view.epoch = (int32_t*)malloc(sizeof(int32_t) * (size_t)max_id);
+    bool* alive = (bool*)calloc((size_t)max_id, sizeof(bool));
+    if (view.base == NULL || view.cur == NULL || view.epoch == NULL || alive == NULL) return false;
+    for (int id = 0; id < max_id; id++) view.epoch[id] = -1;
+
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    TmapEngine engine;
+    engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+    WireEncoder enc;
+    wire_encoder_init(&enc, WIRE_MODE_DELTA);
+    bench_rng_state = 0x2545F491u;
+    for (int i = 0; i < n; i++) {
+        deploy_target(&engine, i, 1 + (int)(bench_rand() % 9), 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0,
+                      126.93 + 0.14 * (bench_rand() % 10000) / 10000.0, 0);
+        alive[i] = true;
+    }
+
+    bool ok = true;
+    for (int t = 1; t <= ticks && ok; t++) {
+        if (t % 4 == 0) {                   // 요격 n/50대 + 새 표적 n/100대 + 방금 요격한 ID 일부 재투입
+            for (int k = 0; k < n / 50; k++) {
+                int id = (int)(bench_rand() % (uint32_t)n);
+                if (kill_target(&engine, id)) alive[id] = false;
+            }
+            compact_tombstones(&engine, 0);
+            for (int k = 0; k < n / 100; k++) {
+                int id = (k % 2 == 0) ? n + (int)(bench_rand() % (uint32_t)(max_id - n)) : (int)(bench_rand() % (uint32_t)n);
+                if (!alive[id] && deploy_target(&engine, id, 5, 37.5, 127.0, t)) alive[id] = true;
+            }
+        }
+        simulate_flight(&engine, (uint32_t)t, t);
+        wire_broadcast(&enc, &engine.live, (uint32_t)t, bench_wire_decode, &view);
+        ok = bench_wire_matches(&view, &engine.live, alive);
+    }
+
+    wire_encoder_free(&enc);
+    engine_free(&engine);
+    tmap_log_waypoints = log_waypoints;
+    free(view.base); free(view.cur); free(view.epoch); free(alive);
+    return ok;
+}
+
+static void bench_udp_sink(const void* datagram, size_t len, void* ctx) {
+    transport_queue((Transport*)ctx, datagram, len);
+}
+
+static void bench_count_datagram(const unsigned char* data, int len, const struct sockaddr_in* from, void* ctx) {
+    (void)data; (void)len; (void)from;
+    (*(uint64_t*)ctx)++;
+}
+
+// 루프백 송신/수신 소켓 한 쌍 (tx의 목적지 = rx가 받은 빈 포트)
+static bool bench_open_loopback(Transport* tx, Transport* rx) {
+    struct sockaddr_in addr;
+    if (!transport_open(rx, "127.0.0.1", 0)) return false;
+    if (!transport_local_addr(rx, &addr) || !transport_open(tx, "127.0.0.1", 0)) {
+        transport_close(rx);
+        return false;
+    }
+    tx->peer = addr;
+    return true;
+}
+
+/**
+ * @brief 송출: 표적당 데이터그램 하나 vs MTU 크기 프레임 vs v2 차분 프레임 (루프백 UDP 실제 송수신)
+ * @note  틱마다 비행 시뮬레이션 후 전부 보내고 수신 측을 비우는 것은 클라이언트가 화면 프레임마다 소켓을 비우는 것과 같습니다.
+ *        수신 버퍼를 넘친 데이터그램은 커널이 버리므로 "전달률"은 클라이언트가 실제로 받은 데이터그램 비율입니다.
+ *        송출 형식만 비교하도록 소켓은 데이터그램마다 sendto/recvfrom으로 씁니다 (일괄 I/O는 --bench transport).
+ */
+static int bench_wire(void) {
+    static const int sizes[] = { 1000, 10000, 100000 };
+    static const struct { const char* name; WireMode mode; } modes[] = {
+        { "per-track", WIRE_MODE_PER_TRACK },
+        { "framed", WIRE_MODE_FRAMED },
+        { "delta", WIRE_MODE_DELTA },
+    };
+    const int ticks = 40;
+
+    transport_startup();
+    Transport tx, rx;
+    if (!bench_open_loopback(&tx, &rx)) {
+        printf("[BENCH] Cannot open loopback UDP sockets. Skipping wire benchmark.\n");
+        transport_cleanup();
+        return 1;
+    }
+    tx.batched = rx.batched = false;
+
+    printf("[BENCH] Track broadcast over loopback UDP (%d ticks of flight, receiver drained after each tick)\n", ticks);
+    printf("%8s | %10s | %13s | %9s | %8s | %12s | %12s | %9s | %7s\n", "tracks", "mode", "datagrams/tk", "KB/tick",
+           "B/track", "send us/tick", "recv us/tick", "delivered", "speedup");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        bench_rng_state = 0x9E3779B9u;
+        for (int i = 0; i < n; i++) {
+            double lat = 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0;
+            double lon = 126.93 + 0.14 * (bench_rand() % 10000) / 10000.0;
+            add_history_node(create_track_quiet(&engine, i, 1 + (int)(bench_rand() % 9)), lat, lon, 0);
+        }
+
+        double per_track_us = 0.0;
+        uint32_t tick = 0;
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            WireEncoder enc;
+            wire_encoder_init(&enc, modes[m].mode);
+            uint64_t send_ns = 0, recv_ns = 0, received = 0;
+            for (int t = 1; t <= ticks; t++) {
+                tick++;
+                simulate_flight(&engine, tick, (int)tick);
+                uint64_t t0 = tmap_now_ns();
+                wire_broadcast(&enc, &engine.live, tick, bench_udp_sink, &tx);
+                transport_flush(&tx);
+                uint64_t t1 = tmap_now_ns();
+                transport_drain(&rx, bench_count_datagram, &received);
+                send_ns += t1 - t0;
+                recv_ns += tmap_now_ns() - t1;
+            }
+            double send_us = send_ns / 1e3 / ticks;
+            if (m == 0) per_track_us = send_us;
+            printf("%8d | %10s | %13.0f | %9.1f | %8.1f | %12.0f | %12.0f | %8.1f%% | %6.2fx\n", n, modes[m].name,
+                   (double)enc.datagrams / ticks, enc.bytes / 1024.0 / ticks, (double)enc.bytes / ((double)n * ticks),
+                   send_us, recv_ns / 1e3 / ticks, 100.0 * (double)received / (double)enc.datagrams, per_track_us / send_us);
+            wire_encoder_free(&enc);
+        }
+        engine_free(&engine);
+    }
+
+    transport_close(&tx);
+    transport_close(&rx);
+    transport_cleanup();
+
+    bool ok = bench_wire_verify(10000, 60);
+    printf("[BENCH] v2 decode matches the live table every tick (kills, adds, re-used IDs, keyframes): %s\n", ok ? "yes" : "NO");
+    return ok ? 0 : 1;
+}
+
+// 한 틱의 데이터그램을 모아 두는 WireSink (인코딩 시간을 소켓 I/O 측정에서 빼기 위함)
+typedef struct {
+    unsigned char*  data;           // [capacity][TRANSPORT_SLOT_BYTES]
+    int*            len;
+    int             count;
+    int             capacity;
+} BenchFrames;
+
+static void bench_collect_sink(const void* datagram, size_t len, void* ctx) {
+    BenchFrames* f = (BenchFrames*)ctx;
+    if (f->count == f->capacity || len > TRANSPORT_SLOT_BYTES) return;
+    memcpy(f->data + (size_t)f->count * TRANSPORT_SLOT_BYTES, datagram, len);
+    f->len[f->count++] = (int)len;
+}
+
+/**
+ * @brief 소켓 I/O: 데이터그램마다 sendto/recvfrom vs sendmmsg/recvmmsg 일괄 (같은 프레임열, 루프백 UDP)
+ * @note  틱마다 프레임을 먼저 만들어 두고 송신(대기열 복사 + 시스템 호출)과 수신만 잽니다.
+ *        일괄 경로는 Linux에서만 있으므로 다른 플랫폼에서는 한 줄만 나옵니다.
+ *        수신 버퍼를 4 MB로 키우고 틱마다 비우며, 수신 비용은 받은 데이터그램당 시간으로 비교합니다.
+ *        루프백은 송신 호출 안에서 수신 측 전달까지 처리하므로 실제 NIC보다 시스템 호출 절감 효과가 작게 보입니다.
+ */
+static int bench_transport(void) {
+    static const int sizes[] = { 10000, 100000 };
+    static const struct { const char* name; WireMode mode; } modes[] = {
+        { "framed", WIRE_MODE_FRAMED },
+        { "delta", WIRE_MODE_DELTA },
+    };
+    const int ticks = 40;
+    const int backends = TRANSPORT_HAS_MMSG ? 2 : 1;
+
+    BenchFrames frames = { NULL, NULL, 0, 4096 };
+    frames.data = (unsigned char*)malloc((size_t)frames.capacity * TRANSPORT_SLOT_BYTES);
+    frames.len = (int*)malloc(sizeof(int) * (size_t)frames.capacity);
+    transport_startup();
+    Transport tx, rx;
+    if (frames.data == NULL || frames.len == NULL || !bench_open_loopback(&tx, &rx)) {
+        printf("[BENCH] Cannot open loopback UDP sockets. Skipping transport benchmark.\n");
+        free(frames.data); free(frames.len);
+        transport_cleanup();
+        return 1;
+    }
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(rx.sock, SOL_SOCKET, SO_RCVBUF, (const char*)&rcvbuf, sizeof(rcvbuf));
+
+    printf("[BENCH] Socket I/O backends over loopback UDP (%d ticks of flight, receiver drained after each tick)\n", ticks);
+    printf("%8s | %6s | %17s | %12s | %10s | %12s | %11s | %10s | %11s | %7s\n", "tracks", "wire", "backend", "datagrams/tk",
+           "sends/tick", "send us/tick", "send ns/dgm", "recvs/tick", "recv ns/dgm", "speedup");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        bench_rng_state = 0x9E3779B9u;
+        for (int i = 0; i < n; i++) {
+            double lat = 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0;
+            double lon = 126.93 + 0.14 * (bench_rand() % 10000) / 10000.0;
+            add_history_node(create_track_quiet(&engine, i, 1 + (int)(bench_rand() % 9)), lat, lon, 0);
+        }
+
+        uint32_t tick = 0;
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            double base_us = 0.0;
+            for (int b = 0; b < backends; b++) {
+                tx.batched = rx.batched = (b == 1);
+                tx.send_calls = rx.recv_calls = 0;
+                WireEncoder enc;
+                wire_encoder_init(&enc, modes[m].mode);
+                uint64_t send_ns = 0, recv_ns = 0, sent = 0, received = 0;
+                for (int t = 1; t <= ticks; t++) {
+                    tick++;
+                    simulate_flight(&engine, tick, (int)tick);
+                    frames.count = 0;
+                    wire_broadcast(&enc, &engine.live, tick, bench_collect_sink, &frames);
+
+                    uint64_t t0 = tmap_now_ns();
+                    for (int f = 0; f < frames.count; f++) {
+                        transport_queue(&tx, frames.data + (size_t)f * TRANSPORT_SLOT_BYTES, (size_t)frames.len[f]);
+                    }
+                    transport_flush(&tx);
+                    uint64_t t1 = tmap_now_ns();
+                    transport_drain(&rx, bench_count_datagram, &received);
+                    send_ns += t1 - t0;
+                    recv_ns += tmap_now_ns() - t1;
+                    sent += (uint64_t)frames.count;
+                }
+                double send_us = send_ns / 1e3 / ticks;
+                if (b == 0) base_us = send_us;
+                printf("%8d | %6s | %17s | %12.0f | %10.1f | %12.0f | %11.0f | %10.1f | %11.0f | %6.2fx\n", n, modes[m].name,
+                       transport_backend(&tx), (double)sent / ticks, (double)tx.send_calls / ticks, send_us,
+                       sent ? (double)send_ns / (double)sent : 0.0, (double)rx.recv_calls / ticks,
+                       received ? (double)recv_ns / (double)received : 0.0, base_us / send_us);
+                wire_encoder_free(&enc);
+            }
+        }
+        engine_free(&engine);
+    }
+
+    transport_close(&tx);
+    transport_close(&rx);
+    transport_cleanup();
+    free(frames.data); free(frames.len);
+    return 0;
+}
+
+// 요격 명령 송신 스레드: 무작위 간격(5~45 ms)으로 명령을 보내며 데이터그램에 송신 시각을 실어 보냄
+typedef struct {
+    Transport*      tx;
+    int             commands;
+    int             track_count;
+    uint32_t        rng;
+} BenchC2Sender;
+
+typedef struct {
+    int32_t         id;
+    uint64_t        sent_ns;
+} BenchC2Command;
+
+static void* bench_c2_sender(void* arg) {
+    BenchC2Sender* sender = (BenchC2Sender*)arg;
+    for (int i = 0; i < sender->commands; i++) {
+        sender->rng = sender->rng * 1103515245u + 12345u;
+        tmap_sleep_until_ns(tmap_now_ns() + 5000000ull + (uint64_t)((sender->rng >> 8) % 40000u) * 1000ull);
+        BenchC2Command cmd;
+        cmd.id = (int32_t)((sender->rng >> 4) % (uint32_t)sender->track_count);
+        cmd.sent_ns = tmap_now_ns();
+        transport_send(sender->tx, &cmd, (int)sizeof(cmd), &sender->tx->peer);
+    }
+    return NULL;
+}
+
+typedef struct {
+    TmapEngine*     engine;
+    uint64_t*       latency_ns;         // 명령별 송신 → 요격 반영 시간
+    int             count;
+    int             capacity;
+} BenchC2Receiver;
+
+static void bench_c2_apply(const unsigned char* data, int len, const struct sockaddr_in* from, void* ctx) {
+    BenchC2Receiver* rx = (BenchC2Receiver*)ctx;
+    BenchC2Command cmd;
+    (void)from;
+    if (len != (int)sizeof(cmd) || rx->count == rx->capacity) return;
+    memcpy(&cmd, data, sizeof(cmd));
+    kill_target(rx->engine, cmd.id);
+    rx->latency_ns[rx->count++] = tmap_now_ns() - cmd.sent_ns;
+}
+
+static int bench_cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 요격 명령 지연: 예전 "마감까지 자고 확인" 루프 vs epoll + timerfd 루프 (루프백 UDP)
+ * @note  실시간 서버와 같은 10 Hz 틱(1만 대 비행 시뮬레이션)을 돌리는 동안 다른 스레드가 무작위 시각에 명령을 보내고,
+ *        명령이 kill_target으로 반영될 때까지의 시간을 잽니다. 명령이 틱 작업 도중에 오면 그 틱이 끝날 때까지 기다리므로
+ *        epoll 루프의 꼬리 지연은 틱 작업 시간에 묶입니다.
+ */
+static int bench_event_loop(void) {
+    const int tracks = 10000, commands = 80, hz = 10;
+    const int backends = EVENT_LOOP_HAS_EPOLL ? 2 : 1;
+
+    transport_startup();
+    printf("[BENCH] Kill command latency, send -> applied (%d commands at random 5-45 ms gaps, %d Hz tick over %d tracks)\n",
+           commands, hz, tracks);
+    printf("%16s | %8s | %10s | %10s | %10s | %10s | %9s | %12s\n", "event loop", "commands", "p50 us", "p90 us", "p99 us",
+           "max us", "wake-ups", "tick work ms");
+
+    int rc = 0;
+    for (int b = 0; b < backends; b++) {
+        TmapEngine engine;
+        engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+        bool log_waypoints = tmap_log_waypoints;
+        tmap_log_waypoints = false;
+        bench_rng_state = 0x9E3779B9u;
+        for (int i = 0; i < tracks; i++) {
+            deploy_target(&engine, i, 1 + (int)(bench_rand() % 9), 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0,
+                          126.93 + 0.14 * (bench_rand() % 10000) / 10000.0, 0);
+        }
+
+        Transport tx, rx;
+        BenchC2Receiver recv = { &engine, (uint64_t*)malloc(sizeof(uint64_t) * (size_t)commands), 0, commands };
+        if (recv.latency_ns == NULL || !bench_open_loopback(&tx, &rx)) {
+            printf("[BENCH] Cannot open loopback UDP sockets. Skipping event loop benchmark.\n");
+            free(recv.latency_ns);
+            engine_free(&engine);
+            tmap_log_waypoints = log_waypoints;
+            rc = 1;
+            break;
+        }
+
+        EventLoop events;
+        event_loop_init(&events, b == 0);
+        event_loop_watch(&events, EVENT_SOURCE_C2, (intptr_t)rx.sock);
+        TickScheduler sched;
+        tick_scheduler_init(&sched, hz, TICK_POLICY_CATCH_UP);
+        event_loop_arm(&events, sched.next_deadline);
+
+        BenchC2Sender sender = { &tx, commands, tracks, 0x2545F491u };
+        pthread_t thread;
+        pthread_create(&thread, NULL, bench_c2_sender, &sender);
+
+        uint32_t tick = 0;
+        uint64_t give_up = 0;
+        while (recv.count < commands && (give_up == 0 || tmap_now_ns() < give_up)) {
+            EventSource ready[EVENT_SOURCE_COUNT];
+            int n = event_loop_wait(&events, ready);
+            for (int i = 0; i < n; i++) {
+                if (ready[i] == EVENT_SOURCE_C2) {
+                    transport_drain(&rx, bench_c2_apply, &recv);
+                } else if (ready[i] == EVENT_SOURCE_TICK) {
+                    uint32_t steps = tick_scheduler_begin(&sched);
+                    for (uint32_t k = 0; k < steps; k++, tick++) simulate_flight(&engine, tick, (int)tick);
+                    compact_tombstones(&engine, 0);
+                    tick_scheduler_end(&sched);
+                    event_loop_arm(&events, sched.next_deadline);
+                    // 송신이 끝났는데 1초 넘게 못 받은 명령은 유실로 보고 종료
+                    if (give_up == 0 && (uint64_t)tick * sched.period_ns > (uint64_t)commands * 45000000ull) {
+                        give_up = tmap_now_ns() + 1000000000ull;
+                    }
+                }
+            }
+        }
+        pthread_join(thread, NULL);
+
+        qsort(recv.latency_ns, (size_t)recv.count, sizeof(uint64_t), bench_cmp_u64);
+        int count = recv.count > 0 ? recv.count : 1;
+        printf("%16s | %8d | %10.1f | %10.1f | %10.1f | %10.1f | %9llu | %12.2f\n", event_loop_backend(&events), recv.count,
+               recv.count ? recv.latency_ns[count / 2] / 1e3 : 0.0, recv.count ? recv.latency_ns[count * 9 / 10] / 1e3 : 0.0,
+               recv.count ? recv.latency_ns[count * 99 / 100] / 1e3 : 0.0, recv.count ? recv.latency_ns[count - 1] / 1e3 : 0.0,
+               (unsigned long long)events.wakeups, sched.work_total_ns / 1e6 / (double)(sched.wakeups ? sched.wakeups : 1));
+
+        event_loop_free(&events);
+        transport_close(&tx);
+        transport_close(&rx);
+        free(recv.latency_ns);
+        engine_free(&engine);
+        tmap_log_waypoints = log_waypoints;
+    }
+    transport_cleanup();
+    return rc;
+}
+
+// 엔진 상태 요약: 위치 요약값 + (ID, 위협도) 요약값 + 활성 표적 수
+static uint64_t bench_engine_state(const TmapEngine* engine) {
+    uint64_t h = live_table_digest(&engine->live) ^ (uint64_t)engine->live.count;
+    for (size_t i = 0; i < engine->live.count; i++) {
+        h ^= tmap_rng_mix(((uint64_t)(uint32_t)engine->live.id[i] << 32) ^ (uint64_t)(uint32_t)engine->live.threat[i]);
+    }
+    return h;
+}
+
+/**
+ * @brief 지휘 명령 몰림: 도착 순서대로 하나씩 반영 vs 정렬·중복 제거 후 한 번에 반영
+ * @note  10만 대 엔진에 여러 콘솔이 보낸 명령 한 무더기(KILL 60%, SET_THREAT 20%, ADD 20%, 약 1/4은 다른 콘솔과 겹침)를
+ *        반영합니다. 두 방식의 최종 상태(위치, 위협도, 활성 표적)가 같은지도 확인합니다.
+ *        무더기 끝의 2%는 요격 직후 같은 ID를 다시 투입하는 KILL → ADD 쌍이며, 재투입된 표적이 활성인지 셉니다 (re-ADD).
+ *        예전 서버는 루프마다 명령을 하나만 읽었으므로 같은 무더기를 비우는 데 명령 수만큼의 틱이 걸렸습니다.
+ */
+static int bench_commands(void) {
+    static const int bursts[] = { 1000, 20000 };
+    const int tracks = 100000;
+    const int reserved = 100;       // 요격 직후 재투입(KILL → ADD) 확인용 ID [tracks - reserved, tracks)
+
+    printf("[BENCH] C2 command burst on %d tracks (old server: one command per tick -> burst of N waits N ticks)\n", tracks);
+    printf("%7s | %15s | %8s | %10s | %8s | %9s | %10s | %7s | %11s | %7s\n", "burst", "apply", "applied", "duplicate", "rejected",
+           "apply ms", "ns/command", "speedup", "same state", "re-ADD");
+
+    int rc = 0;
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    for (size_t k = 0; k < sizeof(bursts) / sizeof(bursts[0]); k++) {
+        int n = bursts[k];
+        QueuedCommand* burst = (QueuedCommand*)malloc(sizeof(QueuedCommand) * (size_t)n);
+        if (burst == NULL) { rc = 1; break; }
+        bench_rng_state = 0xC2C2C2C2u;
+        const int pairs = n / 50 < reserved ? n / 50 : reserved;
+        const int mixed = n - 2 * pairs;
+        for (int i = 0; i < mixed; i++) {
+            QueuedCommand* c = &burst[i];
+            memset(c, 0, sizeof(*c));
+            if (i > 0 && bench_rand() % 4 == 0) {           // 다른 콘솔이 같은 명령을 보냄
+                *c = burst[bench_rand() % (uint32_t)i];
+                continue;
+            }
+            uint32_t r = bench_rand() % 10;
+            c->type = r < 6 ? C2_CMD_KILL : r < 8 ? C2_CMD_SET_THREAT : C2_CMD_ADD;
+            c->track_id = c->type == C2_CMD_ADD ? tracks + (int)(bench_rand() % (uint32_t)n) : (int)(bench_rand() % (uint32_t)(tracks - reserved));
+            c->threat = 1 + (int)(bench_rand() % 10);
+            c->lat = 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0;
+            c->lon = 126.93 + 0.14 * (bench_rand() % 10000) / 10000.0;
+        }
+        for (int i = mixed - 1; i > 0; i--) {               // 도착 순서 섞기
+            int j = (int)(bench_rand() % (uint32_t)(i + 1));
+            QueuedCommand t = burst[i]; burst[i] = burst[j]; burst[j] = t;
+        }
+        for (int p = 0; p < pairs; p++) {                   // 같은 배치 안에서 요격 직후 같은 ID 재투입
+            QueuedCommand* kill = &burst[mixed + 2 * p];
+            QueuedCommand* add = kill + 1;
+            memset(kill, 0, sizeof(*kill));
+            kill->type = C2_CMD_KILL;
+            kill->track_id = tracks - reserved + p;
+            *add = *kill;
+            add->type = C2_CMD_ADD;
+            add->threat = 10;
+            add->lat = 37.5;
+            add->lon = 127.0;
+        }
+
+        uint64_t state[2] = { 0, 0 };
+        double base_ns = 0.0;
+        for (int mode = 0; mode < 2; mode++) {
+            TmapEngine engine;
+            engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
+            bench_rng_state = 0x9E3779B9u;
+            for (int i = 0; i < tracks; i++) {
+                deploy_target(&engine, i, 1 + (int)(bench_rand() % 9), 37.45 + 0.1 * (bench_rand() % 10000) / 10000.0,
+                              126.93 + 0.14 * (bench_rand() % 10000) / 10000.0, 0);
+            }
+
+            CommandBatch batch;
+            memset(&batch, 0, sizeof(batch));
+            CommandTally total;
+            memset(&total, 0, sizeof(total));
+            uint64_t t0 = tmap_now_ns();
+            for (int i = 0; i < n; i++) {
+                command_batch_push(&batch, &burst[i]);
+                if (mode == 0) {                            // 도착하는 대로 하나씩
+                    CommandTally t = command_batch_apply(&engine, &batch, 0);
+                    total.kills += t.kills; total.adds += t.adds; total.threats += t.threats;
+                    total.duplicates += t.duplicates; total.rejected += t.rejected;
+                }
+            }
+            if (mode == 1) total = command_batch_apply(&engine, &batch, 0);
+            uint64_t elapsed = tmap_now_ns() - t0;
+            state[mode] = bench_engine_state(&engine);
+            int readded = 0;
+            for (int p = 0; p < pairs; p++) {
+                TacticalTrack* t = track_index_get(&engine.index, tracks - reserved + p);
+                if (t != NULL && t->status == TRACK_STATUS_ACTIVE && t->threat_level == 10 && t->history_count == 1) readded++;
+            }
+
+            double ns = (double)elapsed / n;
+            if (mode == 0) base_ns = ns;
+            printf("%7d | %15s | %8zu | %10zu | %8zu | %9.2f | %10.0f | %6.2fx | %11s | %3d/%-3d\n", n,
+                   mode == 0 ? "arrival order" : "sorted batch", total.kills + total.adds + total.threats, total.duplicates,
+                   total.rejected, elapsed / 1e6, ns, base_ns / ns, mode == 0 ? "-" : state[0] == state[1] ? "yes" : "NO",
+                   readded, pairs);
+            if ((mode == 1 && state[0] != state[1]) || readded != pairs) rc = 1;
+            command_batch_free(&batch);
+            engine_free(&engine);
+        }
+        free(burst);
+    }
+    tmap_log_waypoints = log_waypoints;
+    return rc;
+}
+
+/* =================================================================
+   [4] Dispatcher
+================================================================= */
+typedef struct {
+    const char* name;
+    int (*run)(void);
+    const char* summary;
+} BenchEntry;
+
+static const BenchEntry bench_table[] = {
+    { "btree", bench_btree_search, "B-Tree point lookup: inline SIMD keys vs legacy layout" },
+    { "index", bench_track_index,  "Point lookup: B+Tree vs track ID hash index" },
+    { "startup", bench_startup,    "Time-to-ready: per-record insert vs bulk load" },
+    { "history", bench_history,    "Trajectory scan/save: per-point linked list vs blocks" },
+    { "soak", bench_soak,          "History retention: memory stays flat over a long run" },
+    { "codec", bench_codec,        "Trajectory memory: raw blocks vs Gorilla-compressed blocks" },
+    { "tick", bench_tick,          "Simulation tick: B-Tree pointer chase vs SoA live table" },
+    { "parallel", bench_parallel_tick, "Simulation tick strong scaling over worker threads" },
+    { "kinematics", bench_kinematics, "Flight kinematics: scalar libm path vs SIMD kernels" },
+    { "lod", bench_lod,            "Simulation tick: every track every tick vs multi-rate tiers" },
+    { "scheduler", bench_scheduler, "Tick period stability: relative sleep vs absolute deadlines" },
+    { "scenario", bench_scenario,  "Load generator: expand and ingest 10k/100k/1M-track scenarios" },
+    { "wire", bench_wire,          "Track broadcast: per-track datagrams vs MTU frames vs v2 delta frames" },
+    { "transport", bench_transport, "Socket I/O: per-datagram sendto/recvfrom vs sendmmsg/recvmmsg" },
+    { "eventloop", bench_event_loop, "Kill command latency: sleep-and-poll loop vs epoll + timerfd" },
+    { "commands", bench_commands,  "C2 command burst: per-command apply vs sorted, deduplicated batch" },
+};
+
+/**
+ * @brief 이름으로 벤치마크 실행 ("all"이면 전부)
+ */
+int run_benchmark(const char* name) {
+    const int count = (int)(sizeof(bench_table) / sizeof(bench_table[0]));
+    int ran = 0, rc = 0;
+    kinematics_select(NULL);    // 엔진과 같은 운동 커널로 측정
+    for (int i = 0; i < count; i++) {
+        if (strcmp(name, "all") == 0 || strcmp(name, bench_table[i].name) == 0) {
+            rc |= bench_table[i].run();
+            ran++;
+        }
+    }
+    if (ran == 0) {
+        printf("[BENCH] Unknown benchmark '%s'. Available:\n", name);
+        for (int i = 0; i < count; i++) printf("  %-12s %s\n", bench_table[i].name, bench_table[i].summary);
+        return 1;
+    }
+    return rc;
+}
@@ -1,52 +1,160 @@
 #include "common.h"
-#include "../common/packet.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <winsock2.h>       // SOCKET, sockaddr_in 정의를 위해 필요
-#pragma comment(lib, "ws2_32.lib")
-
-#ifndef MIN_DEGREE
-#define MIN_DEGREE 3        // B-Tree의 최소 차수 (에러 해결)
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
 #endif
+
 /* --- 외부 함수 연결 --- */
 extern void free_track(TacticalTrack* track);
+extern void* pool_alloc(ObjectPool* pool);
+extern void pool_free(ObjectPool* pool, void* obj);
+
+/* =================================================================
+   [1] Cache-Line Aligned Node Memory
+================================================================= */
 
 /**
- * @brief 새로운 B-Tree 노드 생성
+ * @brief 빈 키 슬롯을 센티널로 채움
+ * @note  SIMD 탐색은 num_keys와 무관하게 키 배열 전체를 비교하므로,
+ *        노드의 키 개수가 줄어들 때마다 반드시 호출해야 합니다.
  */
-BTreeNode* create_btree_node(bool is_leaf) {
-    BTreeNode* node = (BTreeNode*)malloc(sizeof(BTreeNode));
+static inline void seal_node_keys(BTreeNode* node) {
+    for (int i = node->num_keys; i < BTREE_KEY_SLOTS; i++) node->keys[i] = BTREE_KEY_SENTINEL;
+}
+
+/**
+ * @brief 다음에 방문할 노드의 모든 캐시 라인을 미리 요청
+ * @note  키 배열과 자식 포인터 배열은 서로 다른 캐시 라인에 있으므로,
+ *        한꺼번에 프리페치하여 직렬 캐시 미스를 병렬 미스로 바꿉니다.
+ */
+static inline void prefetch_node(const BTreeNode* node) {
+    const char* p = (const char*)node;
+    for (size_t off = 0; off < sizeof(BTreeNode); off += CACHE_LINE_SIZE) {
+        __builtin_prefetch(p + off, 0, 3);
+    }
+}
+
+/**
+ * @brief 노드 내 키 탐색: node->keys[] 중 key보다 작은 키의 개수 (lower bound)
+ * @note  AVX2(8-wide) / SSE2(4-wide) 비교 마스크의 popcount로 분기 없이 계산합니다.
+ *        센티널(INT32_MAX)은 어떤 키보다도 작지 않으므로 결과는 항상 num_keys 이하입니다.
+ */
+static inline int node_lower_bound(const BTreeNode* node, int32_t key) {
+    int count = 0;
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi32(key);
+    for (int i = 0; i < BTREE_KEY_SLOTS; i += 8) {
+        __m256i v = _mm256_load_si256((const __m256i*)&node->keys[i]);
+        __m256i lt = _mm256_cmpgt_epi32(needle, v);
+        count += __builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lt)));
+    }
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi32(key);
+    for (int i = 0; i < BTREE_KEY_SLOTS; i += 4) {
+        __m128i v = _mm_load_si128((const __m128i*)&node->keys[i]);
+        __m128i lt = _mm_cmpgt_epi32(needle, v);
+        count += __builtin_popcount((unsigned)_mm_movemask_ps(_mm_castsi128_ps(lt)));
+    }
+#else
+    for (int i = 0; i < BTREE_KEY_SLOTS; i++) count += (node->keys[i] < key);
+#endif
+    return count;
+}
+
+/**
+ * @brief 노드 내 키 탐색: key 이하인 키의 개수 (upper bound)
+ * @note  센티널과 같은 키(INT32_MAX)가 들어오면 센티널까지 세어지므로 num_keys로 절삭합니다.
+ */
+static inline int node_upper_bound(const BTreeNode* node, int32_t key) {
+    int greater = 0;
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi32(key);
+    for (int i = 0; i < BTREE_KEY_SLOTS; i += 8) {
+        __m256i v = _mm256_load_si256((const __m256i*)&node->keys[i]);
+        __m256i gt = _mm256_cmpgt_epi32(v, needle);
+        greater += __builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(gt)));
+    }
+#elif defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi32(key);
+    for (int i = 0; i < BTREE_KEY_SLOTS; i += 4) {
+        __m128i v = _mm_load_si128((const __m128i*)&node->keys[i]);
+        __m128i gt = _mm_cmpgt_epi32(v, needle);
+        greater += __builtin_popcount((unsigned)_mm_movemask_ps(_mm_castsi128_ps(gt)));
+    }
+#else
+    for (int i = 0; i < BTREE_KEY_SLOTS; i++) greater += (node->keys[i] > key);
+#endif
+    int count = BTREE_KEY_SLOTS - greater;
+    return (count < node->num_keys) ? count : node->num_keys;
+}
+
+/**
+ * @brief 새로운 B-Tree 노드 생성 (엔진 아레나의 캐시 라인 정렬 슬랩에서 할당)
+ */
+BTreeNode* create_btree_node(TrackArena* arena, bool is_leaf) {
+    BTreeNode* node = (BTreeNode*)pool_alloc(&arena->nodes);
+    if (node == NULL) {
+        printf("[FATAL ERROR] Memory allocation failed for B-Tree node.\n");
+        return NULL;
+    }
     node->num_keys = 0;
     node->is_leaf = is_leaf;
-    for (int i = 0; i < MAX_KEYS; i++) node->tracks[i] = NULL;
-    for (int i = 0; i <= MAX_KEYS; i++) node->children[i] = NULL;
+    node->next = NULL;
+    seal_node_keys(node);
+    for (int i = 0; i < MAX_CHILDREN; i++) node->children[i] = NULL;  // tracks[]와 공용 메모리
     return node;
 }
 
+/**
+ * @brief B-Tree 노드 1개 해제 (슬랩 프리 리스트로 반환)
+ */
+void free_btree_node(TrackArena* arena, BTreeNode* node) {
+    pool_free(&arena->nodes, node);
+}
+
+/* =================================================================
+   [2] Insertion
+================================================================= */
+
 /**
  * @brief 노드 분할 (Split Child)
+ * @note  단말 분할: 오른쪽 절반을 새 단말로 옮기고 그 첫 ID를 부모에 '복사'하며
+ *        단말 연결 리스트에 새 노드를 끼워 넣습니다.
+ *        내부 분할: 가운데 구분 키를 부모로 '이동'합니다.
  */
-void split_child(BTreeNode* parent, int i, BTreeNode* full_node) {
-    BTreeNode* new_node = create_btree_node(full_node->is_leaf);
-    new_node->num_keys = MIN_DEGREE - 1;
+void split_child(TrackArena* arena, BTreeNode* parent, int i, BTreeNode* full_node) {
+    BTreeNode* new_node = create_btree_node(arena, full_node->is_leaf);
+    int32_t separator;
 
-    // 데이터를 새 노드로 복사
-    for (int j = 0; j < MIN_DEGREE - 1; j++) {
-        new_node->tracks[j] = full_node->tracks[j + MIN_DEGREE];
-        full_node->tracks[j + MIN_DEGREE] = NULL;
-    }
+    if (full_node->is_leaf) {
+        // 왼쪽 BTREE_T개 유지, 나머지(BTREE_T - 1개)를 새 단말로 이동
+        new_node->num_keys = MAX_KEYS - BTREE_T;
+        for (int j = 0; j < new_node->num_keys; j++) {
+            new_node->keys[j] = full_node->keys[j + BTREE_T];
+            new_node->tracks[j] = full_node->tracks[j + BTREE_T];
+        }
+        full_node->num_keys = BTREE_T;
+        separator = new_node->keys[0];
 
-    // 자식 노드가 있다면 자식들도 복사
-    if (!full_node->is_leaf) {
-        for (int j = 0; j < MIN_DEGREE; j++) {
-            new_node->children[j] = full_node->children[j + MIN_DEGREE];
-            full_node->children[j + MIN_DEGREE] = NULL;
+        new_node->next = full_node->next;
+        full_node->next = new_node;
+    } else {
+        new_node->num_keys = BTREE_T - 1;
+        for (int j = 0; j < BTREE_T - 1; j++) {
+            new_node->keys[j] = full_node->keys[j + BTREE_T];
+        }
+        for (int j = 0; j < BTREE_T; j++) {
+            new_node->children[j] = full_node->children[j + BTREE_T];
+            full_node->children[j + BTREE_T] = NULL;
         }
+        separator = full_node->keys[BTREE_T - 1];
+        full_node->num_keys = BTREE_T - 1;
     }
-
-    full_node->num_keys = MIN_DEGREE - 1;
+    seal_node_keys(new_node);
+    seal_node_keys(full_node);
 
     // 부모 노드의 자식 포인터 밀어내고 새 노드 연결
     for (int j = parent->num_keys; j >= i + 1; j--) {
@@ -54,151 +162,409 @@ void split_child(BTreeNode* parent, int i, BTreeNode* full_node) {
     }
     parent->children[i + 1] = new_node;
 
-    // 부모 노드의 키(Track) 밀어내고 분할점 데이터 올리기
+    // 부모 노드의 구분 키 밀어내고 분할점 키 올리기
     for (int j = parent->num_keys - 1; j >= i; j--) {
-        parent->tracks[j + 1] = parent->tracks[j];
+        parent->keys[j + 1] = parent->keys[j];
     }
-    parent->tracks[i] = full_node->tracks[MIN_DEGREE - 1];
-    full_node->tracks[MIN_DEGREE - 1] = NULL;
+    parent->keys[i] = separator;
     parent->num_keys++;
 }
 
 /**
  * @brief 꽉 차지 않은 노드에 삽입
  */
-void insert_non_full(BTreeNode* node, TacticalTrack* track) {
-    int i = node->num_keys - 1;
+void insert_non_full(TrackArena* arena, BTreeNode* node, TacticalTrack* track) {
+    const int32_t key = track->track_id;
 
-    if (node->is_leaf) {
-        while (i >= 0 && node->tracks[i]->track_id > track->track_id) {
-            node->tracks[i + 1] = node->tracks[i];
-            i--;
+    while (!node->is_leaf) {
+        int i = node_upper_bound(node, key);
+        if (node->children[i]->num_keys == MAX_KEYS) {
+            split_child(arena, node, i, node->children[i]);
+            if (node->keys[i] <= key) i++;
         }
-        node->tracks[i + 1] = track;
-        node->num_keys++;
-    } else {
-        while (i >= 0 && node->tracks[i]->track_id > track->track_id) i--;
-        if (node->children[i + 1]->num_keys == MAX_KEYS) {
-            split_child(node, i + 1, node->children[i + 1]);
-            if (node->tracks[i + 1]->track_id < track->track_id) i++;
-        }
-        insert_non_full(node->children[i + 1], track);
+        node = node->children[i];
     }
+
+    // 단말 노드: 삽입 위치 뒤의 키들을 한 칸씩 밀어냄
+    int pos = node_upper_bound(node, key);
+    for (int j = node->num_keys; j > pos; j--) {
+        node->keys[j] = node->keys[j - 1];
+        node->tracks[j] = node->tracks[j - 1];
+    }
+    node->keys[pos] = key;
+    node->tracks[pos] = track;
+    node->num_keys++;
 }
 
 /**
- * @brief 메인 삽입 함수
+ * @brief 로그 없는 삽입 (대량 적재 및 벤치마크용 핵심 경로)
+ * @return 트리 높이가 증가했으면 true
  */
-void insert_track(BTreeNode** root, TacticalTrack* track) {
+bool btree_insert(TrackArena* arena, BTreeNode** root, TacticalTrack* track) {
     if (*root == NULL) {
-        *root = create_btree_node(true);
+        *root = create_btree_node(arena, true);
+        (*root)->keys[0] = track->track_id;
         (*root)->tracks[0] = track;
         (*root)->num_keys = 1;
-        printf("[WAYPOINT] INSERT     | Target ID: %-4d | Root created & Track inserted.\n", track->track_id);
-        return;
+        return false;
     }
 
     if ((*root)->num_keys == MAX_KEYS) {
-        BTreeNode* new_root = create_btree_node(false);
+        BTreeNode* new_root = create_btree_node(arena, false);
         new_root->children[0] = *root;
-        split_child(new_root, 0, *root);
-        int i = (new_root->tracks[0]->track_id < track->track_id) ? 1 : 0;
-        insert_non_full(new_root->children[i], track);
+        split_child(arena, new_root, 0, *root);
         *root = new_root;
+        insert_non_full(arena, new_root, track);
+        return true;
+    }
+    insert_non_full(arena, *root, track);
+    return false;
+}
+
+/**
+ * @brief 메인 삽입 함수
+ */
+void insert_track(TrackArena* arena, BTreeNode** root, TacticalTrack* track) {
+    if (*root == NULL) {
+        btree_insert(arena, root, track);
+        if (tmap_log_waypoints) printf("[WAYPOINT] INSERT     | Target ID: %-4d | Root created & Track inserted.\n", track->track_id);
+        return;
+    }
+
+    bool split = btree_insert(arena, root, track);
+    if (!tmap_log_waypoints) return;
+    if (split) {
         printf("[WAYPOINT] SPLIT      | B-Tree Height Increased.\n");
-    } else {
-        insert_non_full(*root, track);
     }
     printf("[WAYPOINT] INSERT     | Target ID: %-4d | Inserted into B-Tree Leaf.\n", track->track_id);
 }
 
+/* =================================================================
+   [3] Bulk Load (Bottom-up O(N) Construction)
+================================================================= */
+
 /**
- * @brief 트랙 ID로 검색
+ * @brief 한 레벨을 노드 단위로 자를 때 이번 노드에 담을 원소 수
+ * @note  기본은 꽉 채우되(max), 마지막 노드가 최소 점유(min) 미만으로 남지 않도록
+ *        마지막 두 노드는 반씩 나눠 담습니다.
  */
-TacticalTrack* search_btree(BTreeNode* node, int track_id) {
-    if (node == NULL) return NULL;
-    int i = 0;
-    while (i < node->num_keys && track_id > node->tracks[i]->track_id) i++;
-    if (i < node->num_keys && track_id == node->tracks[i]->track_id) return node->tracks[i];
-    if (node->is_leaf) return NULL;
-    return search_btree(node->children[i], track_id);
+static size_t pack_size(size_t remaining, size_t max, size_t min) {
+    if (remaining <= max) return remaining;
+    if (remaining < max + min) return remaining / 2;
+    return max;
 }
 
 /**
- * @brief B-Tree 구조 출력 (시각화)
+ * @brief 정렬된 표적 배열로 B+Tree를 상향식(Bottom-up)으로 구축 [O(N)]
+ * @param tracks ID 오름차순, 중복 없는 표적 포인터 배열 (저장 파일은 중위 순회 순서이므로 이미 정렬됨)
+ * @return 새 루트 (n == 0이면 NULL)
+ * @note  단말을 꽉 채워 한 번에 만들고 연결한 뒤, 위 레벨을 차례로 쌓아 올립니다.
+ *        삽입 경로처럼 분할이 일어나지 않으므로 로그도 출력하지 않습니다.
  */
-void print_btree(BTreeNode* node, int level) {
-    if (node == NULL) return;
-    printf("Level %d: ", level);
-    for (int i = 0; i < node->num_keys; i++) printf("[%d] ", node->tracks[i]->track_id);
-    printf("\n");
-    if (!node->is_leaf) {
-        for (int i = 0; i <= node->num_keys; i++) print_btree(node->children[i], level + 1);
+BTreeNode* btree_bulk_load(TrackArena* arena, TacticalTrack* const* tracks, size_t n) {
+    if (n == 0) return NULL;
+
+    size_t max_nodes = n / (BTREE_T - 1) + 1;
+    BTreeNode** level = (BTreeNode**)malloc(sizeof(BTreeNode*) * max_nodes);
+    int32_t* mins = (int32_t*)malloc(sizeof(int32_t) * max_nodes);
+    if (level == NULL || mins == NULL) {
+        free(level);
+        free(mins);
+        printf("[FATAL ERROR] Memory allocation failed for bulk load (%zu tracks).\n", n);
+        return NULL;
+    }
+
+    // 1. 단말 레벨: 꽉 채운 단말을 만들고 형제 포인터로 연결
+    size_t count = 0;
+    BTreeNode* prev = NULL;
+    for (size_t i = 0; i < n; ) {
+        size_t take = pack_size(n - i, MAX_KEYS, BTREE_T - 1);
+        BTreeNode* leaf = create_btree_node(arena, true);
+        for (size_t j = 0; j < take; j++) {
+            leaf->keys[j] = tracks[i + j]->track_id;
+            leaf->tracks[j] = tracks[i + j];
+        }
+        leaf->num_keys = (int)take;
+        if (prev != NULL) prev->next = leaf;
+        prev = leaf;
+
+        level[count] = leaf;
+        mins[count] = leaf->keys[0];
+        count++;
+        i += take;
     }
+
+    // 2. 내부 레벨: 아래 레벨 노드들을 묶고, 각 자식 서브트리의 최소 ID를 구분 키로 사용
+    while (count > 1) {
+        size_t out = 0;
+        for (size_t i = 0; i < count; ) {
+            size_t take = pack_size(count - i, MAX_CHILDREN, BTREE_T);
+            BTreeNode* node = create_btree_node(arena, false);
+            int32_t group_min = mins[i];
+            for (size_t j = 0; j < take; j++) {
+                node->children[j] = level[i + j];
+                if (j > 0) node->keys[j - 1] = mins[i + j];
+            }
+            node->num_keys = (int)take - 1;
+
+            // out <= i 이므로 이미 읽은 칸에 덮어써도 안전
+            level[out] = node;
+            mins[out] = group_min;
+            out++;
+            i += take;
+        }
+        count = out;
+    }
+
+    BTreeNode* root = level[0];
+    free(level);
+    free(mins);
+    return root;
 }
 
+/* =================================================================
+   [4] Deletion (Borrow / Merge)
+   - 하강하기 전에 자식이 최소 키 개수보다 하나 이상 많도록 미리 채워서,
+     단말에서 키를 지운 뒤 위로 되돌아가며 재조정할 필요가 없게 합니다.
+================================================================= */
+
 /**
- * @brief 고위험 표적 스캔
+ * @brief 왼쪽 형제의 마지막 원소를 children[i]의 맨 앞으로 회전
  */
-void scan_high_threat(BTreeNode* node, int threshold) {
-    if (node == NULL) return;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) scan_high_threat(node->children[i], threshold);
-        if (node->tracks[i]->threat_level >= threshold && node->tracks[i]->status != 0) {
-            printf("  [!] ALERT: Target %d (Threat: %d) detected!\n", 
-                   node->tracks[i]->track_id, node->tracks[i]->threat_level);
+static void borrow_from_left(BTreeNode* parent, int i) {
+    BTreeNode* child = parent->children[i];
+    BTreeNode* left = parent->children[i - 1];
+
+    for (int j = child->num_keys; j > 0; j--) child->keys[j] = child->keys[j - 1];
+
+    if (child->is_leaf) {
+        for (int j = child->num_keys; j > 0; j--) child->tracks[j] = child->tracks[j - 1];
+        child->keys[0] = left->keys[left->num_keys - 1];
+        child->tracks[0] = left->tracks[left->num_keys - 1];
+        parent->keys[i - 1] = child->keys[0];
+    } else {
+        for (int j = child->num_keys + 1; j > 0; j--) child->children[j] = child->children[j - 1];
+        child->keys[0] = parent->keys[i - 1];
+        child->children[0] = left->children[left->num_keys];
+        left->children[left->num_keys] = NULL;
+        parent->keys[i - 1] = left->keys[left->num_keys - 1];
+    }
+
+    child->num_keys++;
+    left->num_keys--;
+    seal_node_keys(left);
+}
+
+/**
+ * @brief 오른쪽 형제의 첫 원소를 children[i]의 맨 뒤로 회전
+ */
+static void borrow_from_right(BTreeNode* parent, int i) {
+    BTreeNode* child = parent->children[i];
+    BTreeNode* right = parent->children[i + 1];
+    int n = child->num_keys;
+
+    if (child->is_leaf) {
+        child->keys[n] = right->keys[0];
+        child->tracks[n] = right->tracks[0];
+        for (int j = 0; j < right->num_keys - 1; j++) {
+            right->keys[j] = right->keys[j + 1];
+            right->tracks[j] = right->tracks[j + 1];
         }
+        parent->keys[i] = right->keys[0];
+    } else {
+        child->keys[n] = parent->keys[i];
+        child->children[n + 1] = right->children[0];
+        parent->keys[i] = right->keys[0];
+        for (int j = 0; j < right->num_keys - 1; j++) right->keys[j] = right->keys[j + 1];
+        for (int j = 0; j < right->num_keys; j++) right->children[j] = right->children[j + 1];
+        right->children[right->num_keys] = NULL;
     }
-    if (!node->is_leaf) scan_high_threat(node->children[node->num_keys], threshold);
+
+    child->num_keys++;
+    right->num_keys--;
+    seal_node_keys(right);
 }
 
 /**
- * @brief 메모리 해제
+ * @brief children[i]와 children[i + 1]을 하나로 병합하고 오른쪽 노드 해제
+ * @note  단말 병합은 구분 키를 버리고, 내부 병합은 구분 키를 끌어내립니다.
  */
-void free_btree(BTreeNode* node) {
-    if (node == NULL) return;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) free_btree(node->children[i]);
-        free_track(node->tracks[i]);
+static void merge_children(TrackArena* arena, BTreeNode* parent, int i) {
+    BTreeNode* left = parent->children[i];
+    BTreeNode* right = parent->children[i + 1];
+    int n = left->num_keys;
+
+    if (left->is_leaf) {
+        for (int j = 0; j < right->num_keys; j++) {
+            left->keys[n + j] = right->keys[j];
+            left->tracks[n + j] = right->tracks[j];
+        }
+        left->num_keys = n + right->num_keys;
+        left->next = right->next;
+    } else {
+        left->keys[n] = parent->keys[i];
+        for (int j = 0; j < right->num_keys; j++) left->keys[n + 1 + j] = right->keys[j];
+        for (int j = 0; j <= right->num_keys; j++) left->children[n + 1 + j] = right->children[j];
+        left->num_keys = n + 1 + right->num_keys;
     }
-    if (!node->is_leaf) free_btree(node->children[node->num_keys]);
-    free(node);
+
+    for (int j = i; j < parent->num_keys - 1; j++) parent->keys[j] = parent->keys[j + 1];
+    for (int j = i + 1; j < parent->num_keys; j++) parent->children[j] = parent->children[j + 1];
+    parent->children[parent->num_keys] = NULL;
+    parent->num_keys--;
+    seal_node_keys(parent);
+
+    free_btree_node(arena, right);
 }
 
-/* ========================================================
-    [핵심 추가 함수] B-Tree 데이터를 UDP로 브로드캐스트
-   ======================================================== */
-void broadcast_btree(BTreeNode* node, SOCKET sock, struct sockaddr_in* addr) {
-    if (node == NULL) return;
+/**
+ * @brief 최소 키 개수인 자식을 형제에게서 빌리거나 병합해서 채움
+ * @return 이어서 하강할 자식 인덱스 (왼쪽 형제와 병합하면 i - 1)
+ */
+static int fill_child(TrackArena* arena, BTreeNode* parent, int i) {
+    if (i > 0 && parent->children[i - 1]->num_keys >= BTREE_T) {
+        borrow_from_left(parent, i);
+        return i;
+    }
+    if (i < parent->num_keys && parent->children[i + 1]->num_keys >= BTREE_T) {
+        borrow_from_right(parent, i);
+        return i;
+    }
+    if (i < parent->num_keys) {
+        merge_children(arena, parent, i);
+        return i;
+    }
+    merge_children(arena, parent, i - 1);
+    return i - 1;
+}
+
+/**
+ * @brief 트리에서 ID를 실제로 제거 (Hard Delete)
+ * @return 제거된 표적 포인터 (없으면 NULL). 표적 본체 해제는 호출자 책임.
+ */
+TacticalTrack* btree_delete(TrackArena* arena, BTreeNode** root, int32_t key) {
+    BTreeNode* node = *root;
+    if (node == NULL) return NULL;
+
+    while (!node->is_leaf) {
+        int i = node_upper_bound(node, key);
+        if (node->children[i]->num_keys < BTREE_T) i = fill_child(arena, node, i);
+        node = node->children[i];
+    }
 
-    for (int i = 0; i < node->num_keys; i++) {
-        // 1. 왼쪽 자식 노드 탐색
-        if (!node->is_leaf) {
-            broadcast_btree(node->children[i], sock, addr);
+    TacticalTrack* removed = NULL;
+    int pos = node_lower_bound(node, key);
+    if (pos < node->num_keys && node->keys[pos] == key) {
+        removed = node->tracks[pos];
+        for (int j = pos; j < node->num_keys - 1; j++) {
+            node->keys[j] = node->keys[j + 1];
+            node->tracks[j] = node->tracks[j + 1];
         }
+        node->num_keys--;
+        seal_node_keys(node);
+    }
 
-        // 2. 현재 노드의 표적 전송
-        TacticalTrack* track = node->tracks[i];
-        if (track != NULL && track->status == 1) { // 1: ACTIVE
-            TargetPacket pkt;
-            memset(&pkt, 0, sizeof(TargetPacket));
+    // 루트가 비었으면 트리 높이 감소
+    BTreeNode* old_root = *root;
+    if (old_root->num_keys == 0) {
+        *root = old_root->is_leaf ? NULL : old_root->children[0];
+        free_btree_node(arena, old_root);
+    }
+    return removed;
+}
 
-            pkt.id = track->track_id;
-            pkt.threat_level = track->threat_level;
-            pkt.status = (int)track->status;
+/* =================================================================
+   [5] Search & Cursor
+================================================================= */
 
-            if (track->history_tail != NULL) {
-                pkt.lat = (float)track->history_tail->lat;
-                pkt.lon = (float)track->history_tail->lon;
-            }
+/**
+ * @brief key가 들어있을(또는 들어갈) 단말 노드까지 하강
+ * @note  노드마다 SIMD upper bound 1회 + 다음 자식 프리페치. 재귀 없이 반복으로 하강합니다.
+ */
+static BTreeNode* find_leaf(BTreeNode* node, int32_t key) {
+    if (node == NULL) return NULL;
+    while (!node->is_leaf) {
+        node = node->children[node_upper_bound(node, key)];
+        prefetch_node(node);
+    }
+    return node;
+}
 
-            sendto(sock, (const char*)&pkt, sizeof(TargetPacket), 0,
-                   (struct sockaddr*)addr, sizeof(*addr));
+/**
+ * @brief 트랙 ID로 검색
+ */
+TacticalTrack* search_btree(BTreeNode* node, int track_id) {
+    BTreeNode* leaf = find_leaf(node, track_id);
+    if (leaf == NULL) return NULL;
+    int i = node_lower_bound(leaf, track_id);
+    if (i < leaf->num_keys && leaf->keys[i] == track_id) return leaf->tracks[i];
+    return NULL;
+}
+
+/**
+ * @brief 커서를 [lo, hi) 범위의 시작 위치에 놓음
+ */
+void btree_cursor_range(BTreeCursor* cur, BTreeNode* root, int32_t lo, int64_t hi) {
+    cur->leaf = find_leaf(root, lo);
+    cur->index = (cur->leaf != NULL) ? node_lower_bound(cur->leaf, lo) : 0;
+    cur->hi = hi;
+}
+
+/**
+ * @brief 커서를 id 이상인 첫 표적 위치에 놓음 (상한 없음)
+ */
+void btree_cursor_seek(BTreeCursor* cur, BTreeNode* root, int32_t id) {
+    btree_cursor_range(cur, root, id, INT64_MAX);
+}
+
+/**
+ * @brief 커서를 가장 작은 ID 위치에 놓음 (전체 순차 스캔용)
+ */
+void btree_cursor_first(BTreeCursor* cur, BTreeNode* root) {
+    btree_cursor_range(cur, root, INT32_MIN, INT64_MAX);
+}
+
+/**
+ * @brief 다음 표적을 반환하고 커서를 전진 (범위를 벗어나면 NULL)
+ */
+TacticalTrack* btree_cursor_next(BTreeCursor* cur) {
+    while (cur->leaf != NULL) {
+        if (cur->index < cur->leaf->num_keys) {
+            if (cur->leaf->keys[cur->index] >= cur->hi) {
+                cur->leaf = NULL;
+                return NULL;
+            }
+            return cur->leaf->tracks[cur->index++];
         }
+        cur->leaf = cur->leaf->next;
+        cur->index = 0;
+        if (cur->leaf != NULL && cur->leaf->next != NULL) prefetch_node(cur->leaf->next);
     }
+    return NULL;
+}
 
-    // 3. 마지막 오른쪽 자식 노드 탐색
+/**
+ * @brief B-Tree 구조 출력 (시각화)
+ */
+void print_btree(BTreeNode* node, int level) {
+    if (node == NULL) return;
+    printf("Level %d: ", level);
+    for (int i = 0; i < node->num_keys; i++) printf("[%d] ", node->keys[i]);
+    printf("\n");
     if (!node->is_leaf) {
-        broadcast_btree(node->children[node->num_keys], sock, addr);
+        for (int i = 0; i <= node->num_keys; i++) print_btree(node->children[i], level + 1);
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 메모리 해제
+ */
+void free_btree(TrackArena* arena, BTreeNode* node) {
+    if (node == NULL) return;
+    if (node->is_leaf) {
+        for (int i = 0; i < node->num_keys; i++) free_track(node->tracks[i]);
+    } else {
+        for (int i = 0; i <= node->num_keys; i++) free_btree(arena, node->children[i]);
+    }
+    free_btree_node(arena, node);
+}
@@ -0,0 +1,56 @@
+/**
+ * @file    clock.h
+ * @brief   Monotonic High-Resolution Clock
+ * @details 벤치마크와 실시간 예산 계산, 틱 스케줄링에 쓰이는 단조 증가(monotonic) 나노초 시계.
+ *          벽시계(time())와 달리 NTP 보정이나 시간 변경의 영향을 받지 않습니다.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+
+static inline uint64_t tmap_now_ns(void) {
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    // 곱셈 오버플로우를 피하기 위해 초 단위와 나머지를 분리해서 변환
+    return (uint64_t)(now.QuadPart / freq.QuadPart) * 1000000000ull +
+           (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000000ull / (uint64_t)freq.QuadPart;
+}
+
+/**
+ * @brief 단조 시계 기준 절대 시각 deadline까지 대기
+ * @note  Sleep은 ms 단위라 1 ms 이상 남았을 때만 자고, 나머지는 양보하며 기다립니다.
+ */
+static inline void tmap_sleep_until_ns(uint64_t deadline) {
+    uint64_t now = tmap_now_ns();
+    if (deadline > now + 1000000ull) Sleep((DWORD)((deadline - now) / 1000000ull - 1));
+    while (tmap_now_ns() < deadline) SwitchToThread();
+}
+#else
+    #include <time.h>
+    #include <errno.h>
+
+static inline uint64_t tmap_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief 단조 시계 기준 절대 시각 deadline까지 대기 (TIMER_ABSTIME: 상대 대기처럼 오차가 쌓이지 않음)
+ */
+static inline void tmap_sleep_until_ns(uint64_t deadline) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline / 1000000000ull);
+    ts.tv_nsec = (long)(deadline % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+}
+#endif
+
+#endif // CLOCK_H
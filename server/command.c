@@ -0,0 +1,178 @@
+/**
+ * @file    command.c
+ * @brief   C2 Command Ingestion (Batched, Sorted Single-Pass Application)
+ * @details 명령 소켓에 쌓인 지휘 명령을 루프가 깨어날 때마다 모두 받아 버퍼에 모은 뒤,
+ *          (표적 ID, 도착 순번)으로 정렬하고 같은 표적에 겹친 명령을 접어서 한 번에 반영합니다.
+ *          여러 콘솔이 동시에 명령을 쏟아내도 소켓 버퍼에 남아 다음 틱을 기다리는 명령이 없습니다.
+ *          - 같은 표적의 명령은 도착 순서대로 적용 (ADD 후 KILL, KILL 후 재투입 ADD 모두 그대로.
+ *            재투입 ADD는 아직 정리되지 않은 묘비를 deploy_target이 먼저 물리 삭제하고 새 표적으로 등록)
+ *          - 연달아 같은 종류면 하나로 접음: KILL은 한 번, SET_THREAT는 마지막 값, ADD는 처음 것
+ *          - ID 오름차순으로 적용하므로 B+Tree 삽입과 위협도 인덱스 갱신이 이웃한 노드를 차례로 건드림
+ *          봉투 형식은 common/packet.h의 C2Command이고, 예전 클라이언트의 4바이트 표적 ID는 KILL로 받습니다.
+ */
+
+#include "common.h"
+#include "../common/packet.h"
+#include "../common/transport.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMMAND_BATCH_INITIAL   256     // 첫 버퍼 크기 (명령 수)
+
+extern bool deploy_target(TmapEngine* engine, int target_id, int threat_level, double lat, double lon, int timestamp);
+extern bool kill_target(TmapEngine* engine, int target_id);
+extern TacticalTrack* track_index_get(const TrackIndex* idx, int64_t key);
+extern void threat_index_set_threat(ThreatIndex* idx, TacticalTrack* track, int threat_level);
+
+/* =================================================================
+   [1] Decoding & Buffering
+================================================================= */
+
+/**
+ * @brief 데이터그램 하나를 명령으로 해석
+ * @return false = 길이, 매직, 버전, 종류가 맞지 않음
+ */
+bool command_decode(const unsigned char* data, int len, QueuedCommand* out) {
+    memset(out, 0, sizeof(QueuedCommand));
+    if (len == (int)sizeof(int32_t)) {             // 예전 클라이언트: 표적 ID만 = KILL
+        memcpy(&out->track_id, data, sizeof(int32_t));
+        out->type = C2_CMD_KILL;
+        return true;
+    }
+    if (len != (int)sizeof(C2Command)) return false;
+
+    C2Command cmd;
+    memcpy(&cmd, data, sizeof(C2Command));
+    if (cmd.magic != C2_COMMAND_MAGIC || cmd.version != C2_COMMAND_VERSION) return false;
+    if (cmd.type != C2_CMD_KILL && cmd.type != C2_CMD_ADD && cmd.type != C2_CMD_SET_THREAT) return false;
+    out->track_id = cmd.track_id;
+    out->type = cmd.type;
+    out->threat = cmd.threat;
+    if (cmd.lat == 0 && cmd.lon == 0) {            // 좌표 없이 온 ADD는 사령부에 투입
+        out->lat = HQ_LAT;
+        out->lon = HQ_LON;
+    } else {
+        out->lat = cmd.lat / TRACK_COORD_SCALE;
+        out->lon = cmd.lon / TRACK_COORD_SCALE;
+    }
+    return true;
+}
+
+/**
+ * @brief 명령 하나를 배치에 추가 (도착 순번 부여)
+ * @return false = 메모리 부족 (명령은 버려짐)
+ */
+bool command_batch_push(CommandBatch* batch, const QueuedCommand* cmd) {
+    if (batch->count == batch->capacity) {
+        size_t capacity = batch->capacity ? batch->capacity * 2 : COMMAND_BATCH_INITIAL;
+        QueuedCommand* items = (QueuedCommand*)realloc(batch->items, sizeof(QueuedCommand) * capacity);
+        if (items == NULL) return false;
+        batch->items = items;
+        batch->capacity = capacity;
+    }
+    QueuedCommand* slot = &batch->items[batch->count++];
+    *slot = *cmd;
+    slot->seq = batch->next_seq++;
+    batch->received++;
+    return true;
+}
+
+/**
+ * @brief transport_drain 처리 함수: 받은 데이터그램을 해석해 배치(ctx)에 쌓기만 함
+ */
+void command_ingest_datagram(const unsigned char* data, int len, const struct sockaddr_in* from, void* ctx) {
+    CommandBatch* batch = (CommandBatch*)ctx;
+    QueuedCommand cmd;
+    (void)from;
+    if (!command_decode(data, len, &cmd)) {
+        batch->malformed++;
+        return;
+    }
+    command_batch_push(batch, &cmd);
+}
+
+void command_batch_free(CommandBatch* batch) {
+    free(batch->items);
+    memset(batch, 0, sizeof(CommandBatch));
+}
+
+/* =================================================================
+   [2] Sorted Single-Pass Application
+================================================================= */
+
+static int command_order(const void* a, const void* b) {
+    const QueuedCommand* x = (const QueuedCommand*)a;
+    const QueuedCommand* y = (const QueuedCommand*)b;
+    if (x->track_id != y->track_id) return x->track_id < y->track_id ? -1 : 1;
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+/**
+ * @brief 같은 표적의 연달은 같은 종류 명령 중 반영할 것만 남김 (정렬된 배치 기준)
+ * @return 남긴 명령 수 (items 앞쪽으로 당겨 채움)
+ */
+static size_t command_collapse(QueuedCommand* items, size_t count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (kept > 0) {
+            QueuedCommand* prev = &items[kept - 1];
+            if (prev->track_id == items[i].track_id && prev->type == items[i].type) {
+                if (items[i].type == C2_CMD_SET_THREAT) *prev = items[i];     // 마지막 값이 이김
+                continue;                                                   // KILL, ADD: 처음 것만
+            }
+        }
+        items[kept++] = items[i];
+    }
+    return kept;
+}
+
+/**
+ * @brief 쌓인 명령을 정렬·중복 제거 후 한 번에 반영하고 배치를 비움
+ * @param timestamp ADD 투입 시각 (첫 궤적 점)
+ * @return 적용 결과 (표적 생성/요격 로그는 끄고 호출 측이 요약 출력)
+ * @note  틱 작업(비행 시뮬레이션) 밖에서 호출해야 합니다 (표적 테이블 행 추가/삭제).
+ */
+CommandTally command_batch_apply(TmapEngine* engine, CommandBatch* batch, int timestamp) {
+    CommandTally tally;
+    memset(&tally, 0, sizeof(tally));
+    if (batch->count == 0) return tally;
+
+    size_t count = batch->count;
+    if (count > 1) qsort(batch->items, count, sizeof(QueuedCommand), command_order);
+    size_t kept = command_collapse(batch->items, count);
+    tally.duplicates = count - kept;
+
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    for (size_t i = 0; i < kept; i++) {
+        const QueuedCommand* cmd = &batch->items[i];
+        bool applied = false;
+        if (cmd->type == C2_CMD_KILL) {
+            applied = kill_target(engine, cmd->track_id);
+            if (applied) tally.kills++;
+        } else if (cmd->type == C2_CMD_ADD) {
+            applied = deploy_target(engine, cmd->track_id, cmd->threat, cmd->lat, cmd->lon, timestamp);
+            if (applied) tally.adds++;
+        } else {
+            TacticalTrack* track = track_index_get(&engine->index, cmd->track_id);
+            applied = (track != NULL && track->status == TRACK_STATUS_ACTIVE);
+            if (applied) {
+                threat_index_set_threat(&engine->threats, track, cmd->threat);
+                tally.threats++;
+            }
+        }
+        if (applied) {
+            tally.last_id = cmd->track_id;
+            tally.last_type = cmd->type;
+        } else {
+            tally.rejected++;
+        }
+    }
+    tmap_log_waypoints = log_waypoints;
+
+    if (count > batch->largest) batch->largest = count;
+    batch->batches++;
+    batch->count = 0;
+    return tally;
+}
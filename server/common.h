@@ -2,12 +2,17 @@
  * @file    common.h
  * @brief   T-MAP Tactical Engine Core Data Structures & Macros
  * @details Mission-Critical 실시간 전술 표적 추적을 위한 하이브리드 인메모리 구조체 정의.
- * B-Tree와 O(1) Tail-Pointer Linked List를 결합하여 설계됨.
+ * B-Tree와 O(1) Tail-Pointer 궤적 블록 리스트를 결합하여 설계됨.
  */
 
 #ifndef COMMON_H
 #define COMMON_H
 
+// Linux: sendmmsg/recvmmsg 선언 노출 (transport.h). 시스템 헤더보다 먼저 정의해야 하므로 맨 위에 둠
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
 #ifndef RAYLIB_H
 
 #include <stdio.h>
@@ -61,61 +66,707 @@ typedef struct Color {
     #include <crtdbg.h>
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
 // B-Tree Tuning Parameters
-#define BTREE_T 3                       // B-Tree의 최소 차수 (t)
-#define MAX_KEYS (2 * BTREE_T - 1)      // 노드당 최대 키 개수 (5)
-#define MAX_CHILDREN (2 * BTREE_T)      // 노드당 최대 자식 개수 (6)
+// 팬아웃은 캐시 라인 크기에서 유도됩니다. 키 배열(int32_t)이 정확히
+// BTREE_KEY_LINES 개의 캐시 라인을 채우도록 노드 크기를 결정합니다.
+#define CACHE_LINE_SIZE 64              // x86-64 L1 캐시 라인 (Bytes)
+#ifndef BTREE_KEY_LINES
+#define BTREE_KEY_LINES 1               // 노드당 키 배열이 차지하는 캐시 라인 수
+#endif
+#define BTREE_KEY_SLOTS (BTREE_KEY_LINES * CACHE_LINE_SIZE / 4) // 키 슬롯 수 (16)
+#define BTREE_T (BTREE_KEY_SLOTS / 2)   // B-Tree의 최소 차수 (t = 8)
+#define MAX_KEYS (2 * BTREE_T - 1)      // 노드당 최대 키 개수 (15, 마지막 슬롯은 센티널)
+#define MAX_CHILDREN (2 * BTREE_T)      // 노드당 최대 자식 개수 (16)
+#define BTREE_KEY_SENTINEL INT32_MAX    // 빈 키 슬롯 채움값 (SIMD 탐색 시 항상 '크다'로 판정)
 
 /* =================================================================
-   [2] Target Status Constants (매직 넘버 제거)
+   [2] Target Status & Theater Constants (매직 넘버 제거)
 ================================================================= */
 #define TRACK_STATUS_ACTIVE     1       // 활성화된 정상 표적
 #define TRACK_STATUS_DESTROYED -1       // 요격 완료된 표적 (Tombstone)
 
+// 사령부 위치 (클라이언트 화면 중심, 좌표 없이 투입한 표적의 출발점). 다중 주기 단계, 교전 모델, 시나리오가 공유
+#define HQ_LAT                  37.5
+#define HQ_LON                  127.0
+#define LON_SCALE               0.7934  // cos(37.5°): 경도 1도를 위도 도 단위 거리로 환산
+
+// 비행 가능 구역 (경계를 넘으면 해당 축 방향 반전). 시나리오 가장자리 투입선도 이 경계에서 정함
+#define MIN_LAT                 37.450000
+#define MAX_LAT                 37.550000
+#define MIN_LON                 126.930000
+#define MAX_LON                 127.070000
+
 /* =================================================================
    [3] Core Data Structures
 ================================================================= */
 
 /**
- * @brief Trajectory Node (단일 궤적 노드)
- * @note  표적의 특정 시간대 위치 정보를 담는 Linked List의 단위체
+ * @brief Trajectory Point (단일 궤적 점)
+ * @note  표적의 특정 시간대 위치 정보
  */
-typedef struct HistoryNode {
+typedef struct HistoryPoint {
     double              lat;            // 위도 (Latitude)
     double              lon;            // 경도 (Longitude)
     int                 timestamp;      // 탐지 시간 (System Time)
-    struct HistoryNode* next;           // 다음 궤적을 가리키는 포인터
-} HistoryNode;
+} HistoryPoint;
+
+/**
+ * @brief Trajectory Block (연속 궤적 블록)
+ * @note  궤적 점을 점마다 따로 할당하지 않고 블록 안의 연속 배열에 쌓습니다.
+ *        블록끼리는 next로 연결되며, 순회와 직렬화는 블록 단위로 메모리를 훑습니다.
+ *        대부분의 표적은 궤적이 짧으므로 첫 블록만 작게(HISTORY_HEAD_POINTS) 두고,
+ *        두 번째 블록부터 HISTORY_BLOCK_POINTS 크기로 늘립니다.
+ */
+#define HISTORY_HEAD_POINTS  8          // 첫 블록의 점 수
+#define HISTORY_BLOCK_POINTS 128        // 이후 블록의 점 수
+
+typedef struct HistoryBlock {
+    struct HistoryBlock* next;          // 다음(더 최근) 블록 (풀 프리 리스트 링크 겸용)
+    int                 count;          // 블록에 기록된 점 수
+    int                 capacity;       // 블록이 담을 수 있는 점 수
+    int                 start;          // 보존 정책으로 잘려 나간 점 수 (유효 구간은 [start, count))
+    int                 encoded;        // 압축 블록이면 points 자리에 담긴 비트열 바이트 수 (0 = 원본 배열)
+    HistoryPoint        points[];       // 시간 순 궤적 점 배열 (압축 블록에서는 비트열)
+} HistoryBlock;
+
+#define HISTORY_BLOCK_BYTES(points) (sizeof(HistoryBlock) + (points) * sizeof(HistoryPoint))
+
+/**
+ * @brief 압축(Gorilla) 블록 크기 등급
+ * @note  꼬리에서 밀려나 봉인된 블록은 비트열로 다시 써서 HISTORY_PACKED_STEP 단위 크기 등급의
+ *        풀로 옮깁니다. 원본 블록보다 작아지는 경우에만 압축합니다.
+ */
+#define HISTORY_PACKED_STEP    128      // 압축 블록 크기 등급 간격 (Bytes)
+#define HISTORY_PACKED_CLASSES 24       // 등급 수 (128 ~ 3072 Bytes)
+#define HISTORY_PACKED_SLACK   9        // 디코더가 비트열 끝에서 한 번에 읽는 여유 바이트
+
+/**
+ * @brief Packed Block Decoder (압축 블록 스트리밍 디코더 상태)
+ * @note  타임스탬프는 delta-of-delta, 좌표는 직전 값과의 XOR 비트열로 저장되어 있어
+ *        앞에서부터 한 점씩만 복원할 수 있습니다.
+ */
+typedef struct HistoryDecoder {
+    const uint8_t*      bits;           // 블록의 비트열
+    size_t              pos;            // 다음에 읽을 비트 위치
+    int                 index;          // 다음에 복원할 점 번호
+    uint32_t            timestamp;      // 직전 타임스탬프
+    uint32_t            delta;          // 직전 타임스탬프 간격
+    uint64_t            lat_bits;       // 직전 위도 (IEEE-754 비트)
+    uint64_t            lon_bits;       // 직전 경도 (IEEE-754 비트)
+    uint8_t             lat_lead, lat_trail;    // 위도 XOR 유효 비트 창 (선행/후행 0 개수)
+    uint8_t             lon_lead, lon_trail;    // 경도 XOR 유효 비트 창
+} HistoryDecoder;
+
+void history_decoder_begin(HistoryDecoder* dec, const HistoryBlock* block);
+void history_decoder_next(HistoryDecoder* dec, HistoryPoint* out);
+
+struct TacticalTrack;
+struct TmapEngine;
+
+/**
+ * @brief Cold Storage Hook (보존 기간을 넘긴 궤적 점 인계 콜백)
+ * @param points 잘려 나간 블록의 점 배열 (시간 순, 콜백이 반환된 뒤에는 무효)
+ */
+typedef void (*HistoryColdSink)(const struct TacticalTrack* track, const HistoryPoint* points,
+                                int count, void* ctx);
+
+/**
+ * @brief History Retention Policy (궤적 보존 정책)
+ * @note  표적마다 최근 max_points개 또는 최근 max_age초 이내의 점만 유지합니다 (0 = 제한 없음).
+ *        잘린 점은 블록이 통째로 비는 시점에 cold_sink로 넘기거나(NULL이면 버림)
+ *        풀로 반환되어 다음 꼬리 블록으로 재사용되므로, 정상 상태 메모리는 표적 수에만 비례합니다.
+ *        compress가 켜져 있으면 압축 블록의 시간 조건은 블록 단위로 적용되어,
+ *        최대 한 블록만큼 더 오래 보존될 수 있습니다.
+ */
+typedef struct HistoryRetention {
+    int                 max_points;     // 표적당 최대 보존 점 수 (0 = 무제한)
+    int                 max_age;        // 최신 점 기준 최대 보존 시간 [timestamp 단위, 초] (0 = 무제한)
+    HistoryColdSink     cold_sink;      // 잘린 블록을 넘겨받을 콜드 스토리지 (NULL = 폐기)
+    void*               cold_ctx;       // cold_sink에 그대로 전달되는 사용자 데이터
+    bool                compress;       // 봉인된 블록을 Gorilla 비트열로 압축 보관
+} HistoryRetention;
+
+/**
+ * @brief Track Motion (표적별 기동 상태)
+ * @note  표적이 실시간 표적 테이블에 등록되어 있는 동안은 테이블의 행이 최신 값이고,
+ *        이 사본은 등록/해제/저장 시점에 동기화됩니다. 저장 파일에 함께 기록됩니다.
+ */
+typedef struct TrackMotion {
+    double              vel_lat;        // 기본 속도 위도 성분 [도/틱]
+    double              vel_lon;        // 기본 속도 경도 성분 [도/틱]
+    double              turn;           // 선회율 [rad/틱] (속도 벡터를 매 틱 회전, 0 = 직진)
+    uint32_t            phase;          // 가감속 위상 (기동 경과 틱)
+    int8_t              dir_lat;        // 진행 방향 부호 (+1/-1, 경계에서 반사 시 반전)
+    int8_t              dir_lon;
+} TrackMotion;
 
 /**
  * @brief Tactical Target Data (전술 표적 본체)
- * @note  O(1) 삽입 성능을 위해 history_tail 포인터를 유지하는 것이 핵심 아키텍처
+ * @note  O(1) 삽입 성능을 위해 history_tail 블록 포인터를 유지하는 것이 핵심 아키텍처
  */
 typedef struct TacticalTrack {
     int                 track_id;       // 고유 표적 식별자 (Unique ID)
     int                 threat_level;   // 위협도 (1~10)
     int                 status;         // 표적 상태 (ACTIVE or DESTROYED)
-    int                 history_count;  // 누적 궤적 데이터 개수
+    int                 history_count;  // 보존 중인 궤적 데이터 개수
+    int                 live_slot;      // 실시간 표적 테이블(LiveTable) 슬롯 (-1 = 미등록)
     
-    HistoryNode* history_head;   // 궤적 리스트의 시작점 (순회 및 메모리 해제용)
-    HistoryNode* history_tail;   // 궤적 리스트의 끝점 (O(1) 빠른 삽입용)
+    HistoryBlock* history_head;  // 궤적 블록 리스트의 시작점 (순회 및 메모리 해제용)
+    HistoryBlock* history_tail;  // 궤적 블록 리스트의 끝점 (O(1) 빠른 삽입용)
+    HistoryBlock** history_link; // history_tail을 가리키는 포인터의 주소 (봉인 블록 교체용)
+    struct TmapEngine*  engine;         // 소속 엔진 인스턴스 (슬랩 아레나, 실시간 표적 테이블, 궤적 보존 정책)
+    TrackMotion         motion;         // 기동 상태 (등록 중에는 LiveTable 행이 최신)
 } TacticalTrack;
 
 /**
- * @brief B-Tree Node (고속 인덱싱 노드)
- * @note  최대 MAX_KEYS 개의 표적 포인터를 품고 있는 트리의 마디
+ * @brief 표적의 최신 위치 [O(1)]
+ * @return 궤적이 없으면 NULL
+ * @note  꼬리 블록은 압축되지 않으므로 항상 배열에서 바로 읽습니다.
+ */
+static inline const HistoryPoint* history_last(const TacticalTrack* track) {
+    const HistoryBlock* tail = track->history_tail;
+    return (tail != NULL) ? &tail->points[tail->count - 1] : NULL;
+}
+
+/**
+ * @brief History Iterator (궤적 점 순차 반복자)
+ * @note  블록 경계만 넘나들며 오래된 점부터 순서대로 반환합니다. 원본 블록은 배열 안의
+ *        점을, 압축 블록은 it->point에 복원한 사본을 가리키므로 반환된 포인터는
+ *        다음 history_iter_next 호출 전까지만 유효합니다.
+ */
+typedef struct HistoryIter {
+    const HistoryBlock* block;          // 현재 블록 (NULL이면 순회 종료)
+    int                 index;          // 블록 안에서의 다음 위치
+    HistoryDecoder      decoder;        // 압축 블록 복원 상태
+    HistoryPoint        point;          // 압축 블록에서 복원한 현재 점
+} HistoryIter;
+
+static inline void history_iter_enter(HistoryIter* it, const HistoryBlock* block) {
+    it->block = block;
+    it->index = (block != NULL) ? block->start : 0;
+    if (block == NULL || block->encoded == 0) return;
+
+    // 압축 블록은 앞에서부터만 풀 수 있으므로 잘려 나간 점은 복원 후 버림
+    history_decoder_begin(&it->decoder, block);
+    for (int i = 0; i < block->start; i++) history_decoder_next(&it->decoder, &it->point);
+}
+
+static inline void history_iter_begin(HistoryIter* it, const TacticalTrack* track) {
+    history_iter_enter(it, track->history_head);
+}
+
+static inline const HistoryPoint* history_iter_next(HistoryIter* it) {
+    while (it->block != NULL && it->index >= it->block->count) {
+        history_iter_enter(it, it->block->next);
+    }
+    if (it->block == NULL) return NULL;
+    if (it->block->encoded == 0) return &it->block->points[it->index++];
+
+    it->index++;
+    history_decoder_next(&it->decoder, &it->point);
+    return &it->point;
+}
+
+/**
+ * @brief B+Tree Node (고속 인덱싱 노드)
+ * @note  모든 표적 포인터는 단말(Leaf) 노드에만 존재하며, 단말 노드들은 next 포인터로
+ *        ID 오름차순 연결 리스트를 이룹니다. 내부 노드의 keys[]는 구분 키(separator)로,
+ *        keys[i]는 children[i + 1] 서브트리의 최소 ID입니다.
+ *        표적 ID는 keys[]에 인라인으로 복제되어 있어, 노드 내 탐색이
+ *        TacticalTrack 포인터를 따라가지 않고 캐시 라인 정렬된 배열 하나에서
+ *        SIMD 비교로 끝납니다. 사용하지 않는 슬롯은 BTREE_KEY_SENTINEL로 채웁니다.
  */
 typedef struct BTreeNode {
+    _Alignas(CACHE_LINE_SIZE)
+    int32_t             keys[BTREE_KEY_SLOTS];    // 표적 ID 인라인 키 배열 (캐시 라인 정렬)
     int                 num_keys;                 // 현재 저장된 키의 개수
     bool                is_leaf;                  // 단말(Leaf) 노드 여부
-    TacticalTrack* tracks[MAX_KEYS];         // 표적 데이터 포인터 배열
-    struct BTreeNode* children[MAX_CHILDREN];   // 자식 노드 포인터 배열
+    struct BTreeNode*   next;                     // 오른쪽 형제 단말 노드 (단말 전용)
+    union {
+        TacticalTrack*    tracks[MAX_KEYS];       // 표적 데이터 포인터 배열 (단말 전용)
+        struct BTreeNode* children[MAX_CHILDREN]; // 자식 노드 포인터 배열 (내부 노드 전용)
+    };
 } BTreeNode;
 
+/**
+ * @brief B+Tree Cursor (순차 스캔 반복자)
+ * @note  단말 연결 리스트를 따라 [lo, hi) 범위를 재귀/스택 없이 순회합니다.
+ *        스캔 도중 트리 구조가 바뀌면(삽입 분할 등) 커서는 무효가 됩니다.
+ */
+typedef struct BTreeCursor {
+    BTreeNode*          leaf;           // 현재 단말 노드 (NULL이면 스캔 종료)
+    int                 index;          // 단말 노드 안에서의 다음 위치
+    int64_t             hi;             // 범위 상한 (미포함, 전체 스캔이면 INT64_MAX)
+} BTreeCursor;
+
+/**
+ * @brief Track ID Hash Index (표적 ID → 표적 포인터 O(1) 인덱스)
+ * @note  Robin Hood 오픈 어드레싱 해시 테이블. dist[i]는 슬롯 i에 있는 키가
+ *        자기 홈 버킷에서 떨어진 거리 + 1 (0 = 빈 슬롯)이며, 탐색은 이 1바이트
+ *        메타데이터만으로 조기 종료합니다. 키는 64비트라 희소한 32/64비트 ID를 모두 수용합니다.
+ */
+typedef struct TrackIndexSlot {
+    int64_t             key;            // 표적 ID
+    TacticalTrack*      track;          // 표적 본체 포인터
+} TrackIndexSlot;
+
+typedef struct TrackIndex {
+    TrackIndexSlot*     slots;          // 슬롯 배열 (capacity개, 2의 거듭제곱)
+    uint8_t*            dist;           // 슬롯별 탐사 거리 + 1 (0 = 비어 있음)
+    size_t              capacity;       // 전체 슬롯 수
+    size_t              count;          // 저장된 표적 수
+    int                 shift;          // 64 - log2(capacity) (피보나치 해싱용)
+} TrackIndex;
+
+/**
+ * @brief Threat Index (위협도 2차 인덱스)
+ * @note  (threat_level, track_id) 복합 키 인덱스. 위협도 단계마다 track_id로 정렬된
+ *        B+Tree를 하나씩 두고, 비어 있지 않은 단계를 비트마스크로 관리합니다.
+ *        활성(ACTIVE) 표적만 등록되므로 "위협도 8 이상" 조회 비용은 결과 개수에 비례합니다.
+ */
+#define THREAT_LEVELS 16                // 위협도 단계 수 (0 ~ 15, 15 이상은 마지막 단계로 묶음)
+
+typedef struct ThreatIndex {
+    BTreeNode*          levels[THREAT_LEVELS];  // 단계별 활성 표적 B+Tree (ID 정렬)
+    uint32_t            nonempty;               // 표적이 있는 단계 비트마스크
+    size_t              count;                  // 등록된 활성 표적 수
+} ThreatIndex;
+
+/**
+ * @brief Threat Cursor (위협도 내림차순 스캔 반복자)
+ */
+typedef struct ThreatCursor {
+    const ThreatIndex*  index;
+    int                 level;          // 현재 스캔 중인 단계
+    int                 min_threat;     // 조회 하한 (이 값 이상만 반환)
+    BTreeCursor         inner;          // 단계 내부 ID 순 커서
+} ThreatCursor;
+
+/**
+ * @brief Tombstone Queue (물리 삭제 대기열)
+ * @note  요격 시점에는 묘비만 세우고(O(1)), 실제 B-Tree 삭제와 재조정은
+ *        틱의 유휴 시간에 시간 예산 안에서 배치로 처리하기 위해 ID를 쌓아 두는 원형 큐.
+ */
+typedef struct TombstoneQueue {
+    int32_t*            ids;            // 묘비 표적 ID 원형 버퍼
+    size_t              head;           // 다음에 꺼낼 위치
+    size_t              count;          // 대기 중인 묘비 수
+    size_t              capacity;       // 버퍼 크기
+} TombstoneQueue;
+
+/**
+ * @brief Live Track Table (실시간 표적 테이블, Structure-of-Arrays)
+ * @note  위치를 가진 활성(ACTIVE) 표적의 틱 단위 상태를 필드별 병렬 배열로 모아 둡니다.
+ *        시뮬레이션, 브로드캐스트, 쿼드트리 구축은 TacticalTrack 포인터를 따라가지 않고
+ *        이 배열들을 앞에서부터 순차로 훑습니다. 표적은 track->live_slot으로 자기 행을 가리키며,
+ *        행 순서는 ID 순이 아닙니다 (삭제 시 마지막 행을 빈자리로 옮김).
+ *        활성 표적만 담으므로 상태(status) 열은 두지 않습니다.
+ *        다중 주기 모드에서는 행을 갱신 단계 순으로 모아 두어, 한 단계의 행이 연속 구간이 됩니다.
+ */
+#define LOD_TIERS 4                     // 갱신 단계 수 (단계 t = 2^t 틱마다 갱신, 1/2/4/8)
+#define LOD_SLICES ((1 << LOD_TIERS) - 1)  // 단계별 조각 수의 합 (단계 t = 2^t 조각, 틱마다 조각 하나씩 갱신)
+
+typedef struct LiveTable {
+    int32_t*            id;             // 표적 ID
+    double*             lat;            // 현재 위도 (궤적 꼬리와 동일)
+    double*             lon;            // 현재 경도
+    double*             vel_lat;        // 기본 속도 위도 성분 [도/틱] (선회 시 매 틱 회전)
+    double*             vel_lon;        // 기본 속도 경도 성분 [도/틱]
+    double*             turn_cos;       // cos(선회율), 선회 없으면 1
+    double*             turn_sin;       // sin(선회율), 선회 없으면 0
+    int8_t*             dir_lat;        // 진행 방향 부호 (+1/-1, 경계에서 반사 시 반전)
+    int8_t*             dir_lon;
+    uint32_t*           phase;          // 가감속 위상 (기동 경과 틱)
+    int32_t*            threat;         // 위협도
+    uint32_t*           last_tick;      // 마지막으로 적분한 틱 (다음 갱신은 그 뒤로 흐른 틱 수만큼 적분)
+    TacticalTrack**     track;          // 행의 표적 본체 (B-Tree/인덱스와 같은 객체)
+    size_t              count;          // 사용 중인 행 수
+    size_t              capacity;       // 할당된 행 수
+    uint32_t            tick;           // 마지막으로 시뮬레이션한 틱 (새 행은 이 틱에 갱신한 것으로 봄)
+    size_t              tier_end[LOD_TIERS];    // 단계 t의 행 = [tier_end[t-1], tier_end[t]) (다중 주기 모드)
+    size_t              slice_end[LOD_SLICES];  // 단계 t 조각 s의 행 = 조각 번호 2^t - 1 + s 구간 (같은 배치)
+    bool                tiered;         // 행이 단계·조각 순으로 정렬된 상태 (행 추가/삭제 시 false → 재배정)
+} LiveTable;
+
+/**
+ * @brief Level-of-Detail Policy (다중 주기 시뮬레이션 정책)
+ * @note  단계 t의 표적은 2^t 틱마다 한 번, 지난 갱신 이후 흐른 틱 수(보통 2^t)만큼 적분합니다.
+ *        위협도가 높거나 사령부(HQ)에 가까운 표적은 단계 0(매 틱)에 남고,
+ *        멀리 있는 저위협 표적만 성기게 갱신해 군집 상황의 틱 비용을 줄입니다.
+ */
+typedef struct LodPolicy {
+    bool                enabled;        // false면 모든 표적을 매 틱 갱신 (기존 동작)
+    int                 full_threat;    // 이 위협도 이상은 거리와 무관하게 단계 0
+    double              tier_radius[LOD_TIERS - 1]; // HQ 거리 경계 [도]: r[0] 안 → 단계 0, r[1] 안 → 1, ...
+    size_t              budget[LOD_TIERS - 1];      // 단계별 최대 표적 수 (0 = 무제한, 넘치면 먼 표적부터 강등)
+    int                 retier_ticks;   // 단계 재배정 주기 [틱] (표적 수가 바뀌면 즉시 재배정)
+} LodPolicy;
+
+extern const LodPolicy tmap_lod_defaults;   // 새 엔진의 다중 주기 정책 (꺼짐, HQ 1.5 / 3 / 5 km 경계)
+
+/**
+ * @brief 한 틱에 갱신할 행 구간 (같은 구간은 같은 시간 간격으로 적분)
+ */
+typedef struct LodRange {
+    size_t              begin;
+    size_t              end;
+    uint32_t            stride;         // 갱신 주기 [틱] (적분 간격은 행마다 지난 갱신 이후 틱 수, 단계가 그대로면 stride)
+} LodRange;
+
+/* =================================================================
+   [4] Memory Pools (Slab Allocator)
+================================================================= */
+
+/**
+ * @brief Object Pool (타입별 고정 크기 슬랩 할당기)
+ * @note  객체를 슬랩(64 KiB) 단위로 미리 잘라 두고 침투형(intrusive) 프리 리스트로
+ *        재사용합니다. 프리 리스트 링크는 객체 안의 link_offset 위치에 저장되므로,
+ *        같은 위치에 next 포인터를 가진 연결 리스트(궤적 블록 등)는 통째로 O(1)에 반환할 수 있습니다.
+ *        할당/반환은 풀 잠금 아래에서 일어나므로 병렬 틱의 작업자들이 같은 풀을 나눠 써도 안전합니다.
+ */
+typedef struct PoolSlab {
+    struct PoolSlab*    next;           // 풀이 소유한 다음 슬랩
+} PoolSlab;
+
+typedef struct ObjectPool {
+    const char*         name;           // 통계 출력용 이름
+    size_t              object_size;    // 정렬 단위로 올림한 객체 크기
+    size_t              align;          // 객체 정렬 (BTreeNode는 캐시 라인)
+    size_t              link_offset;    // 프리 리스트 링크가 놓일 객체 내 오프셋
+    PoolSlab*           slabs;          // 할당된 슬랩 목록 (일괄 해제용)
+    void*               free_list;      // 재사용 가능한 객체 리스트
+    size_t              slab_count;     // 슬랩 수
+    size_t              capacity;       // 슬랩에 잘려 있는 전체 객체 수
+    size_t              live;           // 사용 중인 객체 수
+    size_t              peak;           // 최대 동시 사용 객체 수
+    pthread_mutex_t     lock;           // 병렬 틱 작업자 간 할당/반환 보호
+} ObjectPool;
+
+#define POOL_ROUND_UP(size, align) (((size) + (align) - 1) / (align) * (align))
+#define OBJECT_POOL_INIT_SIZED(name, size, align, link_offset) \
+    { name, POOL_ROUND_UP(size, align), align, link_offset, NULL, NULL, 0, 0, 0, 0, PTHREAD_MUTEX_INITIALIZER }
+#define OBJECT_POOL_INIT(name, type, align, link_offset) \
+    OBJECT_POOL_INIT_SIZED(name, sizeof(type), align, link_offset)
+
+/**
+ * @brief Track Arena (엔진이 쓰는 타입별 풀 묶음)
+ */
+typedef struct TrackArena {
+    ObjectPool          nodes;          // BTreeNode (캐시 라인 정렬)
+    ObjectPool          tracks;         // TacticalTrack
+    ObjectPool          history_head;   // 첫 궤적 블록 (HISTORY_HEAD_POINTS)
+    ObjectPool          history;        // 이후 궤적 블록 (HISTORY_BLOCK_POINTS)
+    ObjectPool          history_packed[HISTORY_PACKED_CLASSES];    // 압축 궤적 블록 (크기 등급별)
+} TrackArena;
+
+/* =================================================================
+   [5] Worker Pool (Parallel Tick)
+================================================================= */
+
+/**
+ * @brief 작업 함수: 행 구간 [begin, end)를 처리
+ */
+typedef void (*WorkerTask)(void* ctx, size_t begin, size_t end);
+
+/**
+ * @brief Worker Pool (틱 병렬 처리용 상주 스레드 묶음)
+ * @note  호출 스레드도 작업자 하나로 참여하므로 보조 스레드는 thread_count - 1개입니다.
+ *        작업은 고정 크기 청크로 나뉘고, 작업자들이 next 카운터에서 청크를 하나씩 가져갑니다.
+ *        청크 경계는 스레드 수와 무관하게 같으므로 청크 단위 결과도 항상 같습니다.
+ */
+typedef struct WorkerPool {
+    pthread_t*          threads;        // 보조 스레드
+    int                 thread_count;   // 호출 스레드를 포함한 작업자 수 (1 = 직렬)
+    pthread_mutex_t     lock;
+    pthread_cond_t      start_cv;       // 새 작업 공지
+    pthread_cond_t      done_cv;        // 보조 스레드 전원 완료
+    uint64_t            generation;     // 공지된 작업 번호
+    int                 pending;        // 이번 작업을 아직 끝내지 않은 보조 스레드 수
+    bool                stopping;
+    WorkerTask          task;           // 이번 작업
+    void*               ctx;
+    size_t              total;          // 전체 행 수
+    size_t              chunk;          // 청크 크기 (행)
+    atomic_size_t       next;           // 다음에 가져갈 청크의 시작 행
+} WorkerPool;
+
+/* =================================================================
+   [6] Tick Scheduler (Fixed Timestep)
+================================================================= */
+
+#define TICK_HIST_BUCKETS 10            // 지연/주기 오차 히스토그램 구간 수 (50us ~ 20ms 이상)
+
+/**
+ * @brief 마감을 놓쳤을 때의 처리 방식
+ */
+typedef enum TickPolicy {
+    TICK_POLICY_CATCH_UP,               // 밀린 틱을 연달아 실행해 시뮬레이션 시간을 따라잡음 (최대 max_catch_up)
+    TICK_POLICY_SKIP                    // 밀린 틱은 건너뛰고 다음 격자 시각에 다시 맞춤
+} TickPolicy;
+
+/**
+ * @brief Tick Scheduler (절대 마감 시각 기반 고정 주기 스케줄러)
+ * @note  틱 시작 시각을 start + k * period 격자에 고정하므로, 처리 시간이 늘어도
+ *        주기가 밀리지 않습니다 (작업 후 상대 Sleep은 주기 = period + 처리 시간).
+ */
+typedef struct TickScheduler {
+    uint64_t            period_ns;      // 틱 주기
+    TickPolicy          policy;
+    uint32_t            max_catch_up;   // 한 번에 몰아서 실행할 최대 틱 수
+    uint64_t            next_deadline;  // 다음 틱 시작 예정 시각 (단조 시계, 절대값)
+    uint64_t            tick_start;     // 이번 틱 실제 시작 시각
+    uint64_t            last_start;     // 직전 틱 시작 시각 (0 = 첫 틱)
+
+    uint64_t            ticks;          // 실행한 시뮬레이션 틱 수 (따라잡기 포함)
+    uint64_t            wakeups;        // 스케줄러가 깨어난 횟수
+    uint64_t            overruns;       // 처리가 다음 마감을 넘긴 횟수
+    uint64_t            skipped;        // 건너뛴 틱 수
+    uint64_t            work_max_ns;    // 최대 처리 시간
+    uint64_t            work_total_ns;  // 누적 처리 시간
+    uint64_t            jitter_max_ns;  // 최대 기상 지연 (실제 시작 - 예정 시작)
+    uint64_t            jitter_hist[TICK_HIST_BUCKETS];    // 기상 지연 분포
+    uint64_t            period_hist[TICK_HIST_BUCKETS];    // |실제 주기 - period| 분포
+} TickScheduler;
+
+/* =================================================================
+   [7] Engine Instance
+================================================================= */
+
+/**
+ * @brief Engine Instance (엔진 인스턴스 컨텍스트)
+ * @note  표적 저장소(B-Tree, 인덱스, 묘비 큐), 슬랩 아레나, 실시간 표적 테이블, 정책과 난수 씨앗을
+ *        한데 묶습니다. 엔진 함수는 모두 이 컨텍스트(또는 track->engine)로만 상태에 접근하므로
+ *        인스턴스끼리 공유하는 전역 상태가 없고, 서로 다른 스레드에서 인스턴스를 동시에 돌릴 수 있습니다.
+ */
+typedef struct TmapEngine {
+    BTreeNode*          root;           // 주 B+Tree (ID 순)
+    TrackIndex          index;          // 표적 ID → 표적 포인터 O(1) 인덱스 (root와 항상 동기화)
+    ThreatIndex         threats;        // (위협도, ID) 2차 인덱스 (활성 표적만)
+    TombstoneQueue      graveyard;      // 요격되었지만 아직 트리에서 물리 삭제되지 않은 표적 ID
+    LiveTable           live;           // 실시간 표적 테이블
+    TrackArena          arena;          // B-Tree 노드, 표적, 궤적 블록 슬랩
+    HistoryRetention    retention;      // 새 표적에 적용되는 궤적 보존 정책
+    LodPolicy           lod;            // 다중 주기 정책 (--lod, --lod-budget)
+    WorkerPool*         workers;        // 틱 작업자 풀 (NULL = 호출 스레드에서 직렬)
+    uint64_t            seed;           // 난기류 난수 씨앗 (--seed)
+    bool                running;        // false가 되면 메인 루프 종료
+} TmapEngine;
+
+/* =================================================================
+   [8] Discrete-Event Simulation (Headless Fast-Forward)
+================================================================= */
+
+/**
+ * @brief 가상 시계 이벤트 종류 (같은 시각이면 명령 → 틱 → 브로드캐스트 → 종료 순으로 처리)
+ */
+typedef enum SimEventType {
+    SIM_EVENT_ADD,                      // 표적 투입 (스크립트)
+    SIM_EVENT_KILL,                     // 표적 요격 (스크립트)
+    SIM_EVENT_TICK,                     // simulate_flight 한 틱 + 묘비 정리
+    SIM_EVENT_BROADCAST,                // 활성 표적 상태 송출 (헤드리스에서는 패킷 요약값만 누적)
+    SIM_EVENT_END                       // 시나리오 종료
+} SimEventType;
+
+/**
+ * @brief Simulation Event (가상 시각에 예약된 작업 하나)
+ */
+typedef struct SimEvent {
+    uint64_t            time_ns;        // 가상 시각 (시나리오 시작 = 0)
+    uint64_t            seq;            // 예약 순번 (같은 시각, 같은 종류면 먼저 예약한 것부터)
+    SimEventType        type;
+    int32_t             track_id;       // ADD/KILL 대상
+    int32_t             threat;         // ADD 위협도
+    double              lat;            // ADD 투입 위치
+    double              lon;
+} SimEvent;
+
+/**
+ * @brief Event Queue (가상 시각 우선순위 큐, 이진 최소 힙)
+ */
+typedef struct EventQueue {
+    SimEvent*           heap;
+    size_t              count;
+    size_t              capacity;
+    uint64_t            next_seq;       // 다음 예약 순번
+} EventQueue;
+
+/**
+ * @brief 헤드리스 실행 집계
+ */
+typedef struct HeadlessStats {
+    uint64_t            ticks;
+    uint64_t            broadcasts;
+    uint64_t            packets;        // 송출했을 TargetPacket 수
+    uint64_t            datagrams;      // 송출했을 데이터그램 수
+    uint64_t            wire_bytes;     // 송출했을 UDP 페이로드 바이트 수
+    uint64_t            wire_digest;    // 송출 바이트열 FNV-1a 요약값
+    uint64_t            adds, adds_ignored;
+    uint64_t            kills, kills_ignored;
+    size_t              peak_tracks;
+} HeadlessStats;
+
+/**
+ * @brief 이벤트 처리 직후 호출되는 관찰 함수 (applied = ADD/KILL이 실제로 반영되었는지)
+ * @note  TICK 이벤트 뒤에 불리면 그 틱의 비행 시뮬레이션과 묘비 정리가 끝난 상태입니다.
+ */
+typedef void (*SimEventHook)(TmapEngine* engine, const SimEvent* ev, bool applied, void* ctx);
+
+/**
+ * @brief Monte Carlo Batch (씨앗만 다른 독립 엔진 인스턴스 일괄 실행 설정)
+ */
+typedef struct MonteCarloConfig {
+    const char*         script;         // 시나리오 스크립트 (헤드리스 형식)
+    int                 runs;           // 실행할 인스턴스 수
+    int                 threads;        // 동시에 돌릴 인스턴스 수 (0 = 전체 코어)
+    int                 tick_hz;        // 가상 틱 주파수
+    double              sim_secs;       // 인스턴스당 가상 시간 상한 [초] (0 = 스크립트 끝까지)
+    uint64_t            base_seed;      // 인스턴스 i의 씨앗 = mix(base_seed + i)
+    LodPolicy           lod;            // 인스턴스 공통 다중 주기 정책
+    HistoryRetention    retention;      // 인스턴스 공통 궤적 보존 정책 (콜드 스토리지는 쓰지 않음)
+} MonteCarloConfig;
+
+/* =================================================================
+   [9] Track Broadcast (Wire Encoding)
+================================================================= */
+
+/**
+ * @brief 송출 방식 (--wire)
+ */
+typedef enum WireMode {
+    WIRE_MODE_DELTA,                    // v2: 마이크로도 정수 + 키프레임 대비 varint 차분 프레임 (기본)
+    WIRE_MODE_FRAMED,                   // v1: MTU 크기 프레임에 TargetPacket을 그대로 묶어 송출
+    WIRE_MODE_PER_TRACK                 // 표적 하나당 28바이트 데이터그램 하나 (예전 방식)
+} WireMode;
+
+/**
+ * @brief 완성된 데이터그램 하나를 받아 내보내는 함수 (실시간: sendto, 헤드리스: 요약값 누적)
+ */
+typedef void (*WireSink)(const void* datagram, size_t len, void* ctx);
+
+/**
+ * @brief v2 송출 기준 상태 (표적 ID별, 마지막 키프레임에 보낸 값)
+ * @note  키프레임 뒤에 생긴 표적은 has_base = false로 들어가 다음 키프레임까지 절대값으로 송출됩니다.
+ */
+typedef struct WireBaseline {
+    int32_t             id;
+    int32_t             lat_q;          // 기준 위도 [마이크로도]
+    int32_t             lon_q;          // 기준 경도 [마이크로도]
+    int32_t             threat;
+    uint32_t            seen;           // 마지막으로 송출 대상이었던 브로드캐스트 번호 + 1 (0 = 빈 슬롯)
+    bool                has_base;       // 키프레임에 실렸는지 (false면 절대값 송출)
+    uint8_t             last_mask;      // 직전에 보낸 차분 마스크 (0이면 기준 상태와 같다고 알려 둔 상태)
+} WireBaseline;
+
+/**
+ * @brief Wire Encoder (송출 상태: 방식, 다음 프레임 순번, v2 기준 상태 테이블)
+ */
+typedef struct WireEncoder {
+    WireMode            mode;
+    uint32_t            next_seq;       // 다음 프레임 순번
+    uint64_t            datagrams;      // 누적 송출 데이터그램 수
+    uint64_t            bytes;          // 누적 송출 바이트 수 (UDP 페이로드)
+    int                 keyframe_interval;  // v2 키프레임 간격 [브로드캐스트 수]
+    uint32_t            broadcasts;     // 지금까지의 브로드캐스트 수
+    uint16_t            key_epoch;      // 마지막 키프레임 번호
+    WireBaseline*       base;           // ID → 기준 상태 오픈 어드레싱 테이블 (선형 탐사)
+    size_t              base_capacity;  // 슬롯 수 (2의 거듭제곱)
+    size_t              base_count;     // 사용 중인 슬롯 수
+    int                 base_shift;     // 64 - log2(base_capacity) (피보나치 해싱용)
+} WireEncoder;
+
+/* =================================================================
+   [10] Real-Time Event Loop
+================================================================= */
+
+#if defined(__linux__)
+    #define EVENT_LOOP_HAS_EPOLL 1      // epoll + timerfd 사용 가능
+#else
+    #define EVENT_LOOP_HAS_EPOLL 0
+#endif
+
+/**
+ * @brief 실시간 루프를 깨우는 사건 출처 (event_loop_wait가 이 순서로 돌려줌)
+ */
+typedef enum EventSource {
+    EVENT_SOURCE_C2,                    // 클라이언트 명령 UDP 소켓
+    EVENT_SOURCE_CONSOLE,               // 운용자 콘솔 (Linux: stdin, Windows: _kbhit)
+    EVENT_SOURCE_TICK,                  // 틱 마감 도달
+    EVENT_SOURCE_COUNT
+} EventSource;
+
+/**
+ * @brief Event Loop (명령은 도착 즉시, 틱은 마감 시각에 처리)
+ * @note  epoll 경로: 명령 소켓과 stdin, 마감 시각에 맞춘 timerfd를 한 epoll로 기다립니다.
+ *        polled 경로 (Windows 또는 --event-loop poll): 마감까지 자고 깨어난 뒤 모든 출처를 한 번씩 확인합니다
+ *        (예전 메인 루프 동작, 명령은 최대 한 틱 기다림).
+ */
+typedef struct EventLoop {
+    bool                polled;         // 마감까지 자고 나서 확인 (EVENT_LOOP_HAS_EPOLL이 아니면 항상 true)
+    int                 epoll_fd;       // -1 = 없음
+    int                 timer_fd;       // 틱 마감 timerfd (-1 = 없음)
+    uint64_t            deadline_ns;    // 다음 틱 마감 (단조 시계, 절대값)
+    bool                watched[EVENT_SOURCE_COUNT];
+    uint64_t            wakeups;        // event_loop_wait 반환 횟수
+    uint64_t            dispatched[EVENT_SOURCE_COUNT];    // 출처별 처리 횟수
+} EventLoop;
+
 /* =================================================================
-   [4] Logging Macros
+   [11] C2 Command Ingestion
 ================================================================= */
+
+/**
+ * @brief 수신한 지휘 명령 하나 (C2Command 봉투를 해석한 값)
+ */
+typedef struct QueuedCommand {
+    int32_t             track_id;
+    uint8_t             type;           // C2_CMD_* (packet.h)
+    int32_t             threat;
+    double              lat;            // ADD 투입 위치 [도]
+    double              lon;
+    uint32_t            seq;            // 도착 순번 (같은 표적에 대한 명령의 적용 순서)
+} QueuedCommand;
+
+/**
+ * @brief Command Batch (깨어날 때마다 쌓인 명령을 모두 받아 두는 버퍼)
+ * @note  적용 시 (표적 ID, 도착 순번)으로 정렬하고 중복을 접은 뒤 한 번에 반영합니다 (command.c).
+ */
+typedef struct CommandBatch {
+    QueuedCommand*      items;
+    size_t              count;
+    size_t              capacity;
+    uint32_t            next_seq;
+    uint64_t            received;       // 누적 수신 명령 수
+    uint64_t            malformed;      // 해석하지 못해 버린 데이터그램 수
+    uint64_t            batches;        // 적용한 배치 수
+    size_t              largest;        // 가장 큰 배치의 명령 수
+} CommandBatch;
+
+/**
+ * @brief 배치 하나의 적용 결과
+ */
+typedef struct CommandTally {
+    size_t              kills;          // 요격된 표적
+    size_t              adds;           // 투입된 표적
+    size_t              threats;        // 위협도가 바뀐 표적
+    size_t              duplicates;     // 같은 표적에 겹친 명령이라 접힌 수
+    size_t              rejected;       // 대상이 없거나 이미 있는 등 반영되지 않은 수
+    int32_t             last_id;        // 마지막으로 반영된 명령의 표적 ID (한 건짜리 로그용)
+    uint8_t             last_type;
+} CommandTally;
+
+/* =================================================================
+   [12] Logging Macros
+================================================================= */
+extern bool tmap_log_waypoints;         // 표적 생성/요격 로그 출력 여부 (헤드리스 실행 시 끔)
+
 #define LOG_WAYPOINT(action, target_id, msg) \
-    printf("[WAYPOINT] %-10s | Target ID: %-5d | %s\n", action, target_id, msg)
+    do { \
+        if (tmap_log_waypoints) printf("[WAYPOINT] %-10s | Target ID: %-5d | %s\n", action, target_id, msg); \
+    } while (0)
 
 #endif // COMMON_H
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file    compactor.c
+ * @brief   Tombstone Compaction (Deferred Hard Delete)
+ * @details 요격(KILL)은 실시간 경로에서 묘비만 세우고 궤적 메모리를 반환합니다.
+ *          이 모듈은 그 묘비들을 모아 두었다가, 매 틱의 남는 시간 동안 정해진 시간
+ *          예산 안에서 B-Tree / 해시 인덱스에서 실제로 제거하고 표적 본체를 해제합니다.
+ *          덕분에 장시간 운용해도 트리가 살아있는 표적 수만큼으로 다시 줄어듭니다.
+ */
+
+#include "common.h"
+#include "clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TOMBSTONE_QUEUE_MIN_CAPACITY 256
+#define COMPACT_CLOCK_STRIDE 16         // 시계 확인 간격 (삭제 N건마다 한 번)
+
+extern TacticalTrack* btree_delete(TrackArena* arena, BTreeNode** root, int32_t key);
+extern TacticalTrack* track_index_get(const TrackIndex* idx, int64_t key);
+extern bool track_index_remove(TrackIndex* idx, int64_t key);
+extern void free_track(TacticalTrack* track);
+
+/**
+ * @brief 묘비 큐 메모리 해제
+ */
+void tombstone_queue_free(TombstoneQueue* q) {
+    free(q->ids);
+    q->ids = NULL;
+    q->head = q->count = q->capacity = 0;
+}
+
+/**
+ * @brief 요격된 표적 ID를 물리 삭제 대기열에 추가 [O(1) 분할 상환]
+ */
+bool tombstone_enqueue(TombstoneQueue* q, int32_t id) {
+    if (q->count == q->capacity) {
+        size_t new_cap = q->capacity ? q->capacity * 2 : TOMBSTONE_QUEUE_MIN_CAPACITY;
+        int32_t* ids = (int32_t*)malloc(sizeof(int32_t) * new_cap);
+        if (ids == NULL) {
+            printf("[FATAL ERROR] Memory allocation failed for tombstone queue.\n");
+            return false;
+        }
+        // 원형 버퍼를 펼쳐서 새 버퍼의 앞쪽으로 복사
+        for (size_t i = 0; i < q->count; i++) ids[i] = q->ids[(q->head + i) % q->capacity];
+        free(q->ids);
+        q->ids = ids;
+        q->head = 0;
+        q->capacity = new_cap;
+    }
+    q->ids[(q->head + q->count) % q->capacity] = id;
+    q->count++;
+    return true;
+}
+
+/**
+ * @brief 묘비 표적 하나를 즉시 물리 삭제 (B-Tree, ID 인덱스에서 제거하고 본체 해제)
+ * @return false = 그 ID가 없거나 아직 활성 표적
+ * @note  요격 직후 같은 ID를 다시 투입할 때 씁니다 (deploy_target). 대기열에 남은 ID는
+ *        나중에 compact_tombstones가 꺼낼 때 없거나 활성 표적이므로 그냥 건너뜁니다.
+ */
+bool purge_tombstone(TmapEngine* engine, int32_t id) {
+    TacticalTrack* track = track_index_get(&engine->index, id);
+    if (track == NULL || track->status == TRACK_STATUS_ACTIVE) return false;
+    btree_delete(&engine->arena, &engine->root, id);
+    track_index_remove(&engine->index, id);
+    free_track(track);
+    return true;
+}
+
+/**
+ * @brief 시간 예산 안에서 묘비 표적을 배치로 물리 삭제 (engine의 묘비 큐 → B-Tree, ID 인덱스)
+ * @param budget_ns 이번 틱에 허용된 최대 작업 시간 (0이면 대기열 전체 처리: 헤드리스 전용.
+ *                  실시간 루프는 남은 시간이 0이면 호출하지 않음)
+ * @return 이번 호출에서 제거한 표적 수
+ */
+size_t compact_tombstones(TmapEngine* engine, uint64_t budget_ns) {
+    TombstoneQueue* q = &engine->graveyard;
+    if (q->count == 0) return 0;
+
+    const uint64_t deadline = tmap_now_ns() + budget_ns;
+    size_t purged = 0, visited = 0;
+
+    while (q->count > 0) {
+        int32_t id = q->ids[q->head];
+        q->head = (q->head + 1) % q->capacity;
+        q->count--;
+
+        // 이미 제거되었거나, 같은 ID가 활성 표적으로 다시 등록된 경우는 건너뜀
+        if (purge_tombstone(engine, id)) purged++;
+
+        if (budget_ns != 0 && (++visited % COMPACT_CLOCK_STRIDE) == 0 && tmap_now_ns() >= deadline) break;
+    }
+    return purged;
+}
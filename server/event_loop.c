@@ -0,0 +1,170 @@
+/**
+ * @file    event_loop.c
+ * @brief   Real-Time Event Loop (epoll + timerfd)
+ * @details 실시간 서버의 메인 루프가 무엇 때문에 깨어났는지 알려 줍니다.
+ *          - epoll 경로 (Linux 기본): 명령 소켓, stdin, 틱 마감 timerfd를 epoll 하나로 기다리므로
+ *            요격 명령은 도착 즉시 처리되고 틱 작업은 마감 시각에만 돕니다.
+ *          - polled 경로 (Windows, --event-loop poll): 마감 시각까지 자고 깨어난 뒤 모든 출처를 한 번씩 확인합니다.
+ *            명령은 다음 틱까지 (기본 10 Hz에서 최대 100 ms) 기다립니다.
+ *          틱 마감 시각 계산과 지연 통계는 그대로 tick scheduler가 맡습니다 (scheduler.c).
+ */
+
+#include "common.h"
+#include "clock.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#if EVENT_LOOP_HAS_EPOLL
+    #include <sys/epoll.h>
+    #include <sys/timerfd.h>
+    #include <unistd.h>
+#endif
+
+/* =================================================================
+   [1] Lifecycle & Sources
+================================================================= */
+
+/**
+ * @brief 이벤트 루프 초기화 (틱 출처는 항상 등록됨)
+ * @param polled true면 epoll이 있어도 예전처럼 마감까지 자고 나서 확인
+ * @return false = epoll/timerfd를 만들지 못해 polled 경로로 대체함
+ */
+bool event_loop_init(EventLoop* loop, bool polled) {
+    memset(loop, 0, sizeof(EventLoop));
+    loop->polled = polled || !EVENT_LOOP_HAS_EPOLL;
+    loop->epoll_fd = -1;
+    loop->timer_fd = -1;
+    loop->watched[EVENT_SOURCE_TICK] = true;
+#if EVENT_LOOP_HAS_EPOLL
+    // polled 경로에서도 깨어난 뒤 읽을 것이 있는 출처를 가려내는 데 epoll을 씀 (stdin을 막히지 않게 확인)
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd < 0) {
+        loop->polled = true;
+        return false;
+    }
+    if (loop->polled) return true;
+
+    loop->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = EVENT_SOURCE_TICK;
+    if (loop->timer_fd < 0 || epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->timer_fd, &ev) != 0) {
+        if (loop->timer_fd >= 0) close(loop->timer_fd);
+        loop->timer_fd = -1;
+        loop->polled = true;
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**
+ * @brief 읽을 것이 생기면 루프를 깨울 출처 등록
+ * @param fd 소켓 또는 파일 기술자 (epoll이 없는 플랫폼에서는 쓰지 않고 매 틱 확인 대상으로만 표시)
+ * @return false = 등록 실패 (예: stdin이 일반 파일이라 epoll로 감시할 수 없음)
+ */
+bool event_loop_watch(EventLoop* loop, EventSource source, intptr_t fd) {
+#if EVENT_LOOP_HAS_EPOLL
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = (uint32_t)source;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, (int)fd, &ev) != 0) return false;
+#else
+    (void)fd;
+#endif
+    loop->watched[source] = true;
+    return true;
+}
+
+/**
+ * @brief 출처 감시 해제 (stdin이 닫혀 계속 읽기 가능으로 보이는 경우 등)
+ */
+void event_loop_unwatch(EventLoop* loop, EventSource source, intptr_t fd) {
+#if EVENT_LOOP_HAS_EPOLL
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, (int)fd, NULL);
+#else
+    (void)fd;
+#endif
+    loop->watched[source] = false;
+}
+
+void event_loop_free(EventLoop* loop) {
+#if EVENT_LOOP_HAS_EPOLL
+    if (loop->timer_fd >= 0) close(loop->timer_fd);
+    if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+#endif
+    loop->timer_fd = loop->epoll_fd = -1;
+}
+
+const char* event_loop_backend(const EventLoop* loop) {
+    return loop->polled ? "sleep-and-poll" : "epoll + timerfd";
+}
+
+/* =================================================================
+   [2] Waiting
+================================================================= */
+
+/**
+ * @brief 다음 틱 마감 시각 지정 (단조 시계 절대값, 틱을 처리할 때마다 다시 지정)
+ */
+void event_loop_arm(EventLoop* loop, uint64_t deadline_ns) {
+    loop->deadline_ns = deadline_ns;
+#if EVENT_LOOP_HAS_EPOLL
+    if (loop->timer_fd >= 0) {
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_sec = (time_t)(deadline_ns / 1000000000ull);
+        its.it_value.tv_nsec = (long)(deadline_ns % 1000000000ull);
+        timerfd_settime(loop->timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+    }
+#endif
+}
+
+/**
+ * @brief 출처 하나 이상이 준비될 때까지 대기
+ * @param ready 준비된 출처 (명령 → 콘솔 → 틱 순서, 최대 EVENT_SOURCE_COUNT개)
+ * @return 준비된 출처 수 (epoll 경로에서 시그널로 깨어나면 0일 수 있음)
+ * @note  polled 경로는 항상 마감까지 잔 뒤 틱과 함께 돌려주므로, 명령 처리는 틱 주기에 묶입니다.
+ */
+int event_loop_wait(EventLoop* loop, EventSource ready[EVENT_SOURCE_COUNT]) {
+    bool hit[EVENT_SOURCE_COUNT] = { false };
+#if EVENT_LOOP_HAS_EPOLL
+    struct epoll_event evs[EVENT_SOURCE_COUNT];
+    int n;
+    if (loop->polled) {
+        tmap_sleep_until_ns(loop->deadline_ns);
+        hit[EVENT_SOURCE_TICK] = true;
+        n = epoll_wait(loop->epoll_fd, evs, EVENT_SOURCE_COUNT, 0);
+    } else {
+        n = epoll_wait(loop->epoll_fd, evs, EVENT_SOURCE_COUNT, -1);
+        if (n < 0 && errno != EINTR) {
+            printf("[WARN] epoll_wait failed (errno %d). Falling back to sleep-and-poll.\n", errno);
+            loop->polled = true;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (evs[i].data.u32 < EVENT_SOURCE_COUNT) hit[evs[i].data.u32] = true;
+    }
+    if (!loop->polled && hit[EVENT_SOURCE_TICK]) {
+        uint64_t expirations;       // 읽어서 비워야 다시 준비 상태가 되지 않음
+        if (read(loop->timer_fd, &expirations, sizeof(expirations)) != (ssize_t)sizeof(expirations)) {
+            hit[EVENT_SOURCE_TICK] = false;
+        }
+    }
+#else
+    tmap_sleep_until_ns(loop->deadline_ns);
+    for (int s = 0; s < EVENT_SOURCE_COUNT; s++) hit[s] = true;
+#endif
+
+    int count = 0;
+    for (int s = 0; s < EVENT_SOURCE_COUNT; s++) {
+        if (!hit[s] || !loop->watched[s]) continue;
+        ready[count++] = (EventSource)s;
+        loop->dispatched[s]++;
+    }
+    loop->wakeups++;
+    return count;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file    event_queue.c
+ * @brief   Virtual-Time Event Queue (Binary Min-Heap)
+ * @details 헤드리스 이산 사건 시뮬레이션에서 가상 시각 순으로 이벤트를 꺼내는 우선순위 큐.
+ *          같은 시각이면 명령(ADD/KILL) → 틱 → 브로드캐스트 → 종료 순이고,
+ *          그 안에서는 예약 순서를 지키므로 같은 스크립트는 항상 같은 순서로 실행됩니다.
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define EVENT_QUEUE_MIN_CAPACITY 256
+
+// 같은 시각 안의 처리 순위 (ADD와 KILL은 같은 순위, 스크립트 순서대로)
+static int event_rank(SimEventType type) {
+    return type <= SIM_EVENT_KILL ? 0 : (int)type;
+}
+
+static bool event_before(const SimEvent* a, const SimEvent* b) {
+    if (a->time_ns != b->time_ns) return a->time_ns < b->time_ns;
+    int ra = event_rank(a->type), rb = event_rank(b->type);
+    if (ra != rb) return ra < rb;
+    return a->seq < b->seq;
+}
+
+/**
+ * @brief 큐 메모리 해제
+ */
+void event_queue_free(EventQueue* q) {
+    free(q->heap);
+    q->heap = NULL;
+    q->count = q->capacity = 0;
+    q->next_seq = 0;
+}
+
+/**
+ * @brief 이벤트 예약 [O(log n)]
+ * @note  예약 순번(seq)은 큐가 붙이므로 호출 측 값은 무시됩니다.
+ */
+bool event_queue_push(EventQueue* q, const SimEvent* ev) {
+    if (q->count == q->capacity) {
+        size_t new_cap = q->capacity ? q->capacity * 2 : EVENT_QUEUE_MIN_CAPACITY;
+        SimEvent* heap = (SimEvent*)realloc(q->heap, sizeof(SimEvent) * new_cap);
+        if (heap == NULL) {
+            printf("[FATAL ERROR] Memory allocation failed for event queue.\n");
+            return false;
+        }
+        q->heap = heap;
+        q->capacity = new_cap;
+    }
+
+    // 빈 칸을 위로 올리며 부모가 더 늦으면 끌어내림
+    SimEvent item = *ev;
+    item.seq = q->next_seq++;
+    size_t i = q->count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!event_before(&item, &q->heap[parent])) break;
+        q->heap[i] = q->heap[parent];
+        i = parent;
+    }
+    q->heap[i] = item;
+    return true;
+}
+
+/**
+ * @brief 가장 이른 이벤트를 꺼냄 [O(log n)]
+ * @return 큐가 비어 있으면 false
+ */
+bool event_queue_pop(EventQueue* q, SimEvent* out) {
+    if (q->count == 0) return false;
+    *out = q->heap[0];
+
+    // 마지막 원소를 루트 빈 칸에서부터 내려 보냄
+    SimEvent last = q->heap[--q->count];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= q->count) break;
+        if (child + 1 < q->count && event_before(&q->heap[child + 1], &q->heap[child])) child++;
+        if (!event_before(&q->heap[child], &last)) break;
+        q->heap[i] = q->heap[child];
+        i = child;
+    }
+    if (q->count > 0) q->heap[i] = last;
+    return true;
+}
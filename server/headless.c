@@ -0,0 +1,204 @@
+/**
+ * @file    headless.c
+ * @brief   Headless Fast-Forward Simulation (Discrete-Event Mode)
+ * @details 벽시계 대신 가상 시계와 이벤트 큐로 엔진을 돌립니다. 틱, 브로드캐스트, 스크립트의 ADD/KILL을
+ *          가상 시각 순으로 꺼내 곧바로 실행하므로 2시간 시나리오도 CPU가 허용하는 만큼 빨리 끝납니다.
+ *          콘솔과 소켓은 쓰지 않고, 끝에 시뮬레이션 배속과 궤적/송출 요약값을 출력해 회귀 비교에 씁니다.
+ *          스크립트 형식과 생성 지시문은 scenario.c 머리말에 있습니다.
+ */
+
+#include "common.h"
+#include "clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define HEADLESS_REPORT_NS   600000000000ull    // 진행 상황 출력 간격 (가상 10분)
+#define HEADLESS_FNV_OFFSET  0xCBF29CE484222325ull
+#define HEADLESS_FNV_PRIME   0x100000001B3ull
+
+extern bool deploy_target(TmapEngine* engine, int target_id, int threat_level, double lat, double lon, int timestamp);
+extern bool kill_target(TmapEngine* engine, int target_id);
+extern void simulate_flight(TmapEngine* engine, uint32_t tick, int timestamp);
+extern size_t compact_tombstones(TmapEngine* engine, uint64_t budget_ns);
+extern uint64_t live_table_digest(const LiveTable* live);
+extern bool scenario_load(const char* path, EventQueue* q, uint64_t offset_ns, uint64_t* end_ns);
+extern bool event_queue_push(EventQueue* q, const SimEvent* ev);
+extern bool event_queue_pop(EventQueue* q, SimEvent* out);
+extern void event_queue_free(EventQueue* q);
+extern void wire_encoder_init(WireEncoder* enc, WireMode mode);
+extern size_t wire_broadcast(WireEncoder* enc, const LiveTable* live, uint32_t tick, WireSink sink, void* ctx);
+extern void wire_encoder_free(WireEncoder* enc);
+
+/* =================================================================
+   [1] Event Handlers
+================================================================= */
+
+// 헤드리스 송출 목적지: 데이터그램 바이트열을 요약값에 누적
+static void headless_sink(const void* datagram, size_t len, void* ctx) {
+    HeadlessStats* stats = (HeadlessStats*)ctx;
+    uint64_t h = stats->wire_digest;
+    const unsigned char* bytes = (const unsigned char*)datagram;
+    for (size_t b = 0; b < len; b++) h = (h ^ bytes[b]) * HEADLESS_FNV_PRIME;
+    stats->wire_digest = h;
+    stats->wire_bytes += len;
+}
+
+/**
+ * @brief 헤드리스 브로드캐스트: 실시간 송출과 같은 인코더로 데이터그램을 만들어 바이트열 요약값만 누적
+ */
+static void headless_broadcast(WireEncoder* enc, const LiveTable* live, uint32_t tick, HeadlessStats* stats) {
+    stats->datagrams += wire_broadcast(enc, live, tick, headless_sink, stats);
+    stats->packets += live->count;
+    stats->broadcasts++;
+}
+
+/* =================================================================
+   [2] Event Loop
+================================================================= */
+
+/**
+ * @brief 시나리오 끝 시각을 정하고 종료/틱/브로드캐스트 이벤트를 예약
+ * @param sim_secs  가상 시간 상한 [초] (0이면 스크립트의 END 또는 마지막 이벤트까지)
+ * @param broadcast false면 브로드캐스트 이벤트를 예약하지 않음 (송출 요약값이 필요 없는 일괄 실행)
+ * @return 끝 시각 [ns]. 이벤트도 상한도 없으면 0
+ */
+uint64_t headless_schedule(EventQueue* q, uint64_t script_end_ns, double sim_secs, bool broadcast) {
+    uint64_t end_ns = script_end_ns;
+    if (sim_secs > 0.0 && (end_ns == 0 || (uint64_t)llround(sim_secs * 1e9) < end_ns)) end_ns = (uint64_t)llround(sim_secs * 1e9);
+    if (end_ns == 0) return 0;
+
+    SimEvent ev = { 0 };
+    ev.time_ns = end_ns;
+    ev.type = SIM_EVENT_END;
+    event_queue_push(q, &ev);
+    ev.time_ns = 0;
+    ev.type = SIM_EVENT_TICK;
+    event_queue_push(q, &ev);
+    if (broadcast) {
+        ev.type = SIM_EVENT_BROADCAST;
+        event_queue_push(q, &ev);
+    }
+    return end_ns;
+}
+
+/**
+ * @brief END 이벤트까지 가상 시각 순으로 이벤트를 꺼내 실행
+ * @param hook    이벤트마다 처리 직후 호출 (NULL 가능)
+ * @param verbose true면 가상 10분마다 진행 상황 출력
+ * @return 마지막으로 처리한 이벤트의 가상 시각 [ns]
+ * @note  엔진 상태는 engine만 쓰므로 서로 다른 인스턴스라면 여러 스레드에서 동시에 돌려도 됩니다.
+ *        틱 번호와 가상 시각만으로 진행하므로 같은 스크립트와 씨앗이면 결과가 항상 같습니다.
+ */
+uint64_t headless_execute(TmapEngine* engine, EventQueue* queue, uint64_t period_ns, HeadlessStats* stats,
+                          SimEventHook hook, void* hook_ctx, bool verbose) {
+    uint64_t now_ns = 0;
+    uint64_t next_report = HEADLESS_REPORT_NS;
+    uint32_t sim_tick = 0;
+    uint64_t wall_start = tmap_now_ns();
+    WireEncoder wire;
+    wire_encoder_init(&wire, WIRE_MODE_DELTA);
+
+    SimEvent ev;
+    bool running = true;
+    while (running && event_queue_pop(queue, &ev)) {
+        now_ns = ev.time_ns;
+        int timestamp = (int)(now_ns / 1000000000ull);
+        bool applied = true;
+
+        switch (ev.type) {
+        case SIM_EVENT_ADD:
+            applied = deploy_target(engine, ev.track_id, ev.threat, ev.lat, ev.lon, timestamp);
+            if (applied) {
+                stats->adds++;
+                if (engine->live.count > stats->peak_tracks) stats->peak_tracks = engine->live.count;
+            } else {
+                stats->adds_ignored++;
+            }
+            break;
+        case SIM_EVENT_KILL:
+            applied = kill_target(engine, ev.track_id);
+            if (applied) stats->kills++;
+            else stats->kills_ignored++;
+            break;
+        case SIM_EVENT_TICK:
+            simulate_flight(engine, sim_tick++, timestamp);
+            compact_tombstones(engine, 0);     // 가상 시간에는 예산 없이 모두 정리
+            stats->ticks++;
+            break;
+        case SIM_EVENT_BROADCAST:
+            headless_broadcast(&wire, &engine->live, sim_tick, stats);
+            break;
+        case SIM_EVENT_END:
+            running = false;
+            break;
+        }
+        if (hook != NULL) hook(engine, &ev, applied, hook_ctx);
+
+        // 틱과 브로드캐스트는 한 주기 뒤에 다시 예약 (관찰 함수가 끝난 뒤)
+        if (ev.type == SIM_EVENT_TICK || ev.type == SIM_EVENT_BROADCAST) {
+            ev.time_ns += period_ns;
+            event_queue_push(queue, &ev);
+        }
+
+        if (verbose && now_ns >= next_report) {
+            double wall = (tmap_now_ns() - wall_start) / 1e9;
+            printf("[HEADLESS] t = %7.0f s | active tracks %zu | %.0fx real time\n",
+                   now_ns / 1e9, engine->live.count, wall > 0.0 ? now_ns / 1e9 / wall : 0.0);
+            next_report += HEADLESS_REPORT_NS;
+        }
+    }
+    wire_encoder_free(&wire);
+    return now_ns;
+}
+
+/**
+ * @brief 시나리오 스크립트를 가상 시계로 끝까지 실행
+ * @param tick_hz  가상 틱 주파수 (브로드캐스트도 같은 주기)
+ * @param sim_secs 실행할 가상 시간 상한 [초] (0이면 스크립트의 END 또는 마지막 이벤트까지)
+ * @return 0 = 완료, 1 = 스크립트 오류
+ * @note  저장 파일은 읽거나 쓰지 않고 빈 engine에서 시작합니다.
+ */
+int run_headless(TmapEngine* engine, const char* script_path, int tick_hz, double sim_secs) {
+    EventQueue queue = { 0 };
+    uint64_t end_ns = 0;
+    if (!scenario_load(script_path, &queue, 0, &end_ns)) {
+        event_queue_free(&queue);
+        return 1;
+    }
+    size_t scripted = queue.count;
+    if (tick_hz < 1) tick_hz = 1;
+    const uint64_t period_ns = 1000000000ull / (uint64_t)tick_hz;
+    end_ns = headless_schedule(&queue, end_ns, sim_secs, true);
+    if (end_ns == 0) {
+        printf("[ERROR] Scenario '%s' has no events and no --sim-secs.\n", script_path);
+        event_queue_free(&queue);
+        return 1;
+    }
+
+    printf("[HEADLESS] Scenario '%s': %zu scripted events, %.1f simulated s at %d Hz (virtual clock, no console/network).\n",
+           script_path, scripted, end_ns / 1e9, tick_hz);
+    tmap_log_waypoints = false;
+
+    HeadlessStats stats = { 0 };
+    stats.wire_digest = HEADLESS_FNV_OFFSET;
+    uint64_t wall_start = tmap_now_ns();
+    uint64_t now_ns = headless_execute(engine, &queue, period_ns, &stats, NULL, NULL, true);
+
+    double wall = (tmap_now_ns() - wall_start) / 1e9;
+    double simulated = now_ns / 1e9;
+    printf("[HEADLESS] Complete: %.1f simulated s in %.3f wall s -> %.1f simulated s per wall s\n",
+           simulated, wall, wall > 0.0 ? simulated / wall : 0.0);
+    printf("[HEADLESS] %llu ticks | %llu broadcasts (%llu tracks in %llu datagrams, %.1f MB) | ADD %llu (ignored %llu) | KILL %llu (ignored %llu)\n",
+           (unsigned long long)stats.ticks, (unsigned long long)stats.broadcasts, (unsigned long long)stats.packets,
+           (unsigned long long)stats.datagrams, stats.wire_bytes / (1024.0 * 1024.0), (unsigned long long)stats.adds,
+           (unsigned long long)stats.adds_ignored, (unsigned long long)stats.kills, (unsigned long long)stats.kills_ignored);
+    printf("[HEADLESS] Peak tracks %zu | active at end %zu | trajectory digest 0x%016llx | wire digest 0x%016llx\n",
+           stats.peak_tracks, engine->live.count, (unsigned long long)live_table_digest(&engine->live),
+           (unsigned long long)stats.wire_digest);
+
+    tmap_log_waypoints = true;
+    event_queue_free(&queue);
+    return 0;
+}
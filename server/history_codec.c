@@ -0,0 +1,279 @@
+/**
+ * @file    history_codec.c
+ * @brief   Gorilla-style Trajectory Block Compression
+ * @details 꼬리에서 밀려나 더 이상 바뀌지 않는(봉인된) 궤적 블록을 비트열로 압축합니다.
+ *          - 타임스탬프: 간격의 변화량(delta-of-delta)을 가변 길이 접두 부호로 저장.
+ *            일정 주기로 찍히는 궤적은 점당 1비트로 줄어듭니다.
+ *          - 위도/경도: 직전 값과 XOR한 뒤 앞뒤 0을 뺀 유효 비트만 저장.
+ *            연속된 좌표는 상위 비트(부호, 지수, 상위 가수)가 같아 XOR 결과가 짧습니다.
+ *          손실 없는 압축이며, 복원은 HistoryDecoder로 앞에서부터 한 점씩 스트리밍합니다.
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <string.h>
+
+extern void* pool_alloc(ObjectPool* pool);
+
+#define XOR_WINDOW_NONE 0xFF    // 아직 XOR 유효 비트 창이 정해지지 않음
+
+/* =================================================================
+   [1] Bit Stream
+================================================================= */
+
+typedef struct BitWriter {
+    uint8_t*            buf;
+    size_t              cap_bits;
+    size_t              pos;
+    bool                overflow;
+} BitWriter;
+
+// MSB부터 n비트(n <= 64) 기록
+static void put_bits(BitWriter* w, uint64_t value, int n) {
+    if (w->pos + (size_t)n > w->cap_bits) { w->overflow = true; return; }
+    while (n > 0) {
+        int room = 8 - (int)(w->pos & 7);
+        int take = (n < room) ? n : room;
+        uint8_t chunk = (uint8_t)((value >> (n - take)) & ((1u << take) - 1));
+        w->buf[w->pos >> 3] |= (uint8_t)(chunk << (room - take));
+        w->pos += (size_t)take;
+        n -= take;
+    }
+}
+
+static inline uint64_t load_be64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+// MSB부터 n비트(n <= 64) 읽기. 비트열 뒤에 HISTORY_PACKED_SLACK 바이트 여유가 있어야 함
+static inline uint64_t get_bits(HistoryDecoder* dec, int n) {
+    if (n == 0) return 0;
+    const uint8_t* p = dec->bits + (dec->pos >> 3);
+    int off = (int)(dec->pos & 7);
+    uint64_t value = (load_be64(p) << off) >> (64 - n);
+    if (off + n > 64) value |= (uint64_t)(p[8] >> (72 - off - n));
+    dec->pos += (size_t)n;
+    return value;
+}
+
+static inline uint64_t double_bits(double d) {
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+static inline double bits_double(uint64_t u) {
+    double d;
+    memcpy(&d, &u, sizeof(d));
+    return d;
+}
+
+/* =================================================================
+   [2] Encoder
+================================================================= */
+
+/**
+ * @brief 타임스탬프 delta-of-delta 부호화
+ * @note  '0' = 간격 불변, '10'+7비트, '110'+9비트, '1110'+12비트, '1111'+32비트
+ */
+static void put_timestamp(BitWriter* w, int32_t dod) {
+    if (dod == 0) {
+        put_bits(w, 0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+        put_bits(w, 0x2, 2);
+        put_bits(w, (uint64_t)(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+        put_bits(w, 0x6, 3);
+        put_bits(w, (uint64_t)(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+        put_bits(w, 0xE, 4);
+        put_bits(w, (uint64_t)(dod + 2047), 12);
+    } else {
+        put_bits(w, 0xF, 4);
+        put_bits(w, (uint32_t)dod, 32);
+    }
+}
+
+/**
+ * @brief 좌표 XOR 부호화
+ * @note  '0' = 직전과 동일, '10' = 직전 유효 비트 창 재사용, '11'+5비트 선행 0+6비트 길이 = 새 창
+ */
+static void put_coordinate(BitWriter* w, uint64_t* prev, uint64_t value, uint8_t* lead, uint8_t* trail) {
+    uint64_t x = value ^ *prev;
+    *prev = value;
+    if (x == 0) {
+        put_bits(w, 0, 1);
+        return;
+    }
+
+    int l = __builtin_clzll(x);
+    int t = __builtin_ctzll(x);
+    if (l > 31) l = 31;     // 선행 0 개수는 5비트로 저장
+    if (*lead != XOR_WINDOW_NONE && l >= *lead && t >= *trail) {
+        put_bits(w, 0x2, 2);
+        put_bits(w, x >> *trail, 64 - *lead - *trail);
+        return;
+    }
+
+    int len = 64 - l - t;
+    put_bits(w, 0x3, 2);
+    put_bits(w, (uint64_t)l, 5);
+    put_bits(w, (uint64_t)(len - 1), 6);
+    put_bits(w, x >> t, len);
+    *lead = (uint8_t)l;
+    *trail = (uint8_t)t;
+}
+
+/**
+ * @brief 점 배열을 비트열로 압축
+ * @return 기록한 바이트 수 (cap을 넘으면 0)
+ */
+static size_t encode_points(const HistoryPoint* points, int count, uint8_t* out, size_t cap) {
+    BitWriter w = { out, cap * 8, 0, false };
+    memset(out, 0, cap);
+
+    uint32_t ts = (uint32_t)points[0].timestamp, delta = 0;
+    uint64_t lat = double_bits(points[0].lat), lon = double_bits(points[0].lon);
+    uint8_t lat_lead = XOR_WINDOW_NONE, lat_trail = 0, lon_lead = XOR_WINDOW_NONE, lon_trail = 0;
+    put_bits(&w, ts, 32);
+    put_bits(&w, lat, 64);
+    put_bits(&w, lon, 64);
+
+    for (int i = 1; i < count && !w.overflow; i++) {
+        uint32_t next_delta = (uint32_t)points[i].timestamp - ts;
+        put_timestamp(&w, (int32_t)(next_delta - delta));
+        ts = (uint32_t)points[i].timestamp;
+        delta = next_delta;
+        put_coordinate(&w, &lat, double_bits(points[i].lat), &lat_lead, &lat_trail);
+        put_coordinate(&w, &lon, double_bits(points[i].lon), &lon_lead, &lon_trail);
+    }
+    return w.overflow ? 0 : (w.pos + 7) / 8;
+}
+
+/* =================================================================
+   [3] Decoder
+================================================================= */
+
+/**
+ * @brief 압축 블록 복원 시작 (첫 점부터)
+ */
+void history_decoder_begin(HistoryDecoder* dec, const HistoryBlock* block) {
+    dec->bits = (const uint8_t*)block->points;
+    dec->pos = 0;
+    dec->index = 0;
+    dec->timestamp = 0;
+    dec->delta = 0;
+    dec->lat_bits = 0;
+    dec->lon_bits = 0;
+    dec->lat_lead = dec->lon_lead = XOR_WINDOW_NONE;
+    dec->lat_trail = dec->lon_trail = 0;
+}
+
+static uint64_t get_coordinate(HistoryDecoder* dec, uint64_t prev, uint8_t* lead, uint8_t* trail) {
+    if (get_bits(dec, 1) == 0) return prev;
+    if (get_bits(dec, 1) == 0) {
+        return prev ^ (get_bits(dec, 64 - *lead - *trail) << *trail);
+    }
+    int l = (int)get_bits(dec, 5);
+    int len = (int)get_bits(dec, 6) + 1;
+    *lead = (uint8_t)l;
+    *trail = (uint8_t)(64 - l - len);
+    return prev ^ (get_bits(dec, len) << *trail);
+}
+
+/**
+ * @brief 다음 점 1개 복원 (호출자가 블록의 count를 넘지 않도록 보장)
+ */
+void history_decoder_next(HistoryDecoder* dec, HistoryPoint* out) {
+    if (dec->index++ == 0) {
+        dec->timestamp = (uint32_t)get_bits(dec, 32);
+        dec->lat_bits = get_bits(dec, 64);
+        dec->lon_bits = get_bits(dec, 64);
+    } else {
+        int32_t dod;
+        if (get_bits(dec, 1) == 0)      dod = 0;
+        else if (get_bits(dec, 1) == 0) dod = (int32_t)get_bits(dec, 7) - 63;
+        else if (get_bits(dec, 1) == 0) dod = (int32_t)get_bits(dec, 9) - 255;
+        else if (get_bits(dec, 1) == 0) dod = (int32_t)get_bits(dec, 12) - 2047;
+        else                            dod = (int32_t)(uint32_t)get_bits(dec, 32);
+        dec->delta += (uint32_t)dod;
+        dec->timestamp += dec->delta;
+        dec->lat_bits = get_coordinate(dec, dec->lat_bits, &dec->lat_lead, &dec->lat_trail);
+        dec->lon_bits = get_coordinate(dec, dec->lon_bits, &dec->lon_lead, &dec->lon_trail);
+    }
+    out->lat = bits_double(dec->lat_bits);
+    out->lon = bits_double(dec->lon_bits);
+    out->timestamp = (int)dec->timestamp;
+}
+
+/* =================================================================
+   [4] Block API
+================================================================= */
+
+static inline size_t packed_class(size_t encoded) {
+    return (sizeof(HistoryBlock) + encoded + HISTORY_PACKED_SLACK + HISTORY_PACKED_STEP - 1) / HISTORY_PACKED_STEP;
+}
+
+/**
+ * @brief 블록이 속한 풀 (원본: 첫 블록/일반 블록, 압축: 크기 등급)
+ */
+ObjectPool* history_block_pool(TrackArena* arena, const HistoryBlock* block) {
+    if (block->encoded != 0) return &arena->history_packed[packed_class((size_t)block->encoded) - 1];
+    return (block->capacity == HISTORY_HEAD_POINTS) ? &arena->history_head : &arena->history;
+}
+
+/**
+ * @brief 봉인된 원본 블록의 압축 사본 생성
+ * @return 새 압축 블록 (next = NULL). 압축해도 원본보다 작아지지 않으면 NULL
+ * @note  원본 블록은 건드리지 않으므로 교체와 반환은 호출자가 합니다.
+ */
+HistoryBlock* history_block_pack(TrackArena* arena, const HistoryBlock* raw) {
+    uint8_t scratch[HISTORY_PACKED_CLASSES * HISTORY_PACKED_STEP];
+    if (raw->encoded != 0 || raw->count == 0) return NULL;
+
+    size_t raw_bytes = HISTORY_BLOCK_BYTES((size_t)raw->capacity);
+    size_t encoded = encode_points(raw->points, raw->count, scratch, sizeof(scratch));
+    if (encoded == 0) return NULL;
+    size_t cls = packed_class(encoded);
+    if (cls > HISTORY_PACKED_CLASSES || cls * HISTORY_PACKED_STEP >= raw_bytes) return NULL;
+
+    HistoryBlock* packed = (HistoryBlock*)pool_alloc(&arena->history_packed[cls - 1]);
+    if (packed == NULL) return NULL;
+    packed->next     = NULL;
+    packed->count    = raw->count;
+    packed->capacity = raw->count;
+    packed->start    = raw->start;
+    packed->encoded  = (int)encoded;
+    memcpy(packed->points, scratch, encoded);
+    memset((uint8_t*)packed->points + encoded, 0, HISTORY_PACKED_SLACK);
+    return packed;
+}
+
+/**
+ * @brief 블록 전체(잘린 점 포함)를 점 배열로 복원
+ * @return 복원한 점 수 (block->count)
+ */
+int history_block_unpack(const HistoryBlock* block, HistoryPoint* out) {
+    if (block->encoded == 0) {
+        memcpy(out, block->points, sizeof(HistoryPoint) * (size_t)block->count);
+        return block->count;
+    }
+    HistoryDecoder dec;
+    history_decoder_begin(&dec, block);
+    for (int i = 0; i < block->count; i++) history_decoder_next(&dec, &out[i]);
+    return block->count;
+}
+
+/**
+ * @brief 블록 첫 점(잘린 점 포함)의 타임스탬프 [O(1)]
+ */
+int history_block_first_timestamp(const HistoryBlock* block) {
+    if (block->encoded == 0) return block->points[0].timestamp;
+    const uint8_t* b = (const uint8_t*)block->points;
+    return (int)(((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | (uint32_t)b[3]);
+}
@@ -0,0 +1,358 @@
+/**
+ * @file    kinematics.c
+ * @brief   Vectorized Flight Kinematics Kernel
+ * @details 실시간 표적 테이블의 열 배열을 블록 단위로 받아 한 틱의 운동 상태(위치, 속도 방향, 반사 부호, 위상)를 갱신합니다.
+ *          AVX2(4-wide) / SSE2(2-wide) / 스칼라 커널 중 실행 중인 CPU가 지원하는 가장 넓은 것을 고릅니다.
+ *          세 커널은 같은 연산을 같은 순서로(FMA 없이) 수행하므로 결과가 비트 단위로 같고,
+ *          어떤 장비에서 돌려도 같은 씨앗이면 같은 궤적이 나옵니다.
+ */
+
+#include "common.h"
+#include "rng.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define KIN_X86 1
+    #include <immintrin.h>
+#endif
+
+#define KIN_BATCH        256                    // 난수를 미리 뽑아 두는 행 묶음 크기
+#define KIN_PHASE_STEP   0.275                  // 가감속 위상 증분 [rad/틱]
+#define KIN_NOISE_SCALE  0.00025                // 난기류 최대 흔들림 [도]
+
+// 사인 근사 상수
+#define KIN_INV_TWO_PI   0.15915494309189535
+#define KIN_TWO_PI       6.283185307179586
+#define KIN_HALF_PI      1.5707963267948966
+#define KIN_ROUND_MAGIC  6755399441055744.0     // 2^52 + 2^51: 더했다 빼면 가장 가까운 정수로 반올림
+#define KIN_SIN_C3      -1.6666666666666666e-1  // -1/3!
+#define KIN_SIN_C5       8.3333333333333333e-3  //  1/5!
+#define KIN_SIN_C7      -1.9841269841269841e-4  // -1/7!
+#define KIN_SIN_C9       2.7557319223985891e-6  //  1/9!
+#define KIN_SIN_C11     -2.5052108385441719e-8  // -1/11!
+
+/**
+ * @brief 한 번의 갱신이 적분하는 구간 (stride 틱)
+ * @note  속도 배율 5.5 + 4.5·sin(위상·Δ)를 stride 틱 동안 더한 값은
+ *        5.5·k + 4.5·sin(kΔ/2)/sin(Δ/2)·sin(위상·Δ + (k-1)Δ/2) 이므로 사인 한 번으로 구합니다.
+ *        k = 1이면 각 상수가 정확히 5.5, 4.5, 0이 되어 한 틱 갱신과 비트 단위로 같습니다.
+ */
+typedef struct {
+    uint32_t    stride;             // 적분 틱 수 k
+    double      speed_base;         // 5.5·k
+    double      speed_amp;          // 4.5·sin(kΔ/2)/sin(Δ/2)
+    double      phase_offset;       // (k-1)Δ/2
+} KinematicsSpan;
+
+typedef void (*KinematicsKernel)(LiveTable* live, size_t begin, size_t end, const KinematicsSpan* span,
+                                 const double* noise_lat, const double* noise_lon);
+
+/* =================================================================
+   [1] Scalar Kernel (기준 구현, 모든 CPU)
+================================================================= */
+
+/**
+ * @brief 빠른 사인 근사 (최대 오차 약 6e-8)
+ * @note  2π 단위로 [-π, π]에 접고, sin(π - r) = sin(r)로 [-π/2, π/2]에 다시 접은 뒤
+ *        11차 홀수 다항식을 씁니다. 분기와 libm 호출이 없어 SIMD 커널과 같은 식을 공유합니다.
+ */
+static inline double kin_sin(double x) {
+    double k = (x * KIN_INV_TWO_PI + KIN_ROUND_MAGIC) - KIN_ROUND_MAGIC;
+    double r = x - k * KIN_TWO_PI;
+    double s = KIN_HALF_PI - fabs(fabs(r) - KIN_HALF_PI);
+    s = copysign(s, r);
+
+    double s2 = s * s;
+    double p = KIN_SIN_C11;
+    p = p * s2 + KIN_SIN_C9;
+    p = p * s2 + KIN_SIN_C7;
+    p = p * s2 + KIN_SIN_C5;
+    p = p * s2 + KIN_SIN_C3;
+    return s + s * (s2 * p);
+}
+
+static void kin_rows_scalar(LiveTable* live, size_t begin, size_t end, const KinematicsSpan* span,
+                            const double* noise_lat, const double* noise_lon) {
+    const uint32_t stride = span->stride;
+    for (size_t i = begin; i < end; i++) {
+        double angle = (double)(int32_t)live->phase[i] * KIN_PHASE_STEP + span->phase_offset;
+        double speed = span->speed_base + span->speed_amp * kin_sin(angle);
+        live->phase[i] += stride;
+
+        // 선회: 기본 속도 벡터를 선회율만큼 stride번 회전 (선회율 0이면 cos 1, sin 0으로 값이 그대로 유지)
+        double vel_lat = live->vel_lat[i], vel_lon = live->vel_lon[i];
+        for (uint32_t s = 0; s < stride; s++) {
+            double turned_lat = vel_lat * live->turn_cos[i] - vel_lon * live->turn_sin[i];
+            vel_lon = vel_lat * live->turn_sin[i] + vel_lon * live->turn_cos[i];
+            vel_lat = turned_lat;
+        }
+        live->vel_lat[i] = vel_lat;
+        live->vel_lon[i] = vel_lon;
+
+        double next_lat = live->lat[i] + (vel_lat * speed) * live->dir_lat[i] + noise_lat[i - begin];
+        double next_lon = live->lon[i] + (vel_lon * speed) * live->dir_lon[i] + noise_lon[i - begin];
+
+        // 경계 반사: flip이 -1이면 (d ^ -1) - (-1) = -d
+        int8_t flip_lat = (int8_t)-((next_lat > MAX_LAT) | (next_lat < MIN_LAT));
+        int8_t flip_lon = (int8_t)-((next_lon > MAX_LON) | (next_lon < MIN_LON));
+        live->dir_lat[i] = (int8_t)((live->dir_lat[i] ^ flip_lat) - flip_lat);
+        live->dir_lon[i] = (int8_t)((live->dir_lon[i] ^ flip_lon) - flip_lon);
+
+        live->lat[i] = next_lat;
+        live->lon[i] = next_lon;
+    }
+}
+
+#if defined(KIN_X86)
+
+/* =================================================================
+   [2] SSE2 Kernel (2-wide, x86-64 기본)
+================================================================= */
+
+static inline __m128d kin_sin_sse2(__m128d x) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d magic = _mm_set1_pd(KIN_ROUND_MAGIC);
+    const __m128d half_pi = _mm_set1_pd(KIN_HALF_PI);
+
+    __m128d k = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(x, _mm_set1_pd(KIN_INV_TWO_PI)), magic), magic);
+    __m128d r = _mm_sub_pd(x, _mm_mul_pd(k, _mm_set1_pd(KIN_TWO_PI)));
+    __m128d s = _mm_sub_pd(half_pi, _mm_andnot_pd(sign, _mm_sub_pd(_mm_andnot_pd(sign, r), half_pi)));
+    s = _mm_or_pd(s, _mm_and_pd(r, sign));
+
+    __m128d s2 = _mm_mul_pd(s, s);
+    __m128d p = _mm_set1_pd(KIN_SIN_C11);
+    p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(KIN_SIN_C9));
+    p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(KIN_SIN_C7));
+    p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(KIN_SIN_C5));
+    p = _mm_add_pd(_mm_mul_pd(p, s2), _mm_set1_pd(KIN_SIN_C3));
+    return _mm_add_pd(s, _mm_mul_pd(s, _mm_mul_pd(s2, p)));
+}
+
+// int8 방향 2개 → double 2개 (SSE2에는 부호 확장 명령이 없어 언팩 후 산술 시프트)
+static inline __m128d kin_load_dir2(const int8_t* dir) {
+    int16_t pair;
+    memcpy(&pair, dir, sizeof(pair));
+    __m128i v = _mm_cvtsi32_si128((uint16_t)pair);
+    v = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+    v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    return _mm_cvtepi32_pd(v);
+}
+
+static inline void kin_store_dir2(int8_t* dir, __m128d value) {
+    __m128i v = _mm_cvttpd_epi32(value);
+    v = _mm_packs_epi16(_mm_packs_epi32(v, v), v);
+    int16_t pair = (int16_t)_mm_cvtsi128_si32(v);
+    memcpy(dir, &pair, sizeof(pair));
+}
+
+static inline __m128d kin_axis_sse2(__m128d pos, __m128d vel, __m128d speed, __m128d* dir,
+                                    __m128d noise, double lo, double hi) {
+    __m128d next = _mm_add_pd(_mm_add_pd(pos, _mm_mul_pd(_mm_mul_pd(vel, speed), *dir)), noise);
+    __m128d out = _mm_or_pd(_mm_cmpgt_pd(next, _mm_set1_pd(hi)), _mm_cmplt_pd(next, _mm_set1_pd(lo)));
+    *dir = _mm_xor_pd(*dir, _mm_and_pd(out, _mm_set1_pd(-0.0)));
+    return next;
+}
+
+static void kin_rows_sse2(LiveTable* live, size_t begin, size_t end, const KinematicsSpan* span,
+                          const double* noise_lat, const double* noise_lon) {
+    const uint32_t stride = span->stride;
+    size_t i = begin;
+    for (; i + 2 <= end; i += 2) {
+        __m128i phase = _mm_loadl_epi64((const __m128i*)&live->phase[i]);
+        __m128d angle = _mm_mul_pd(_mm_cvtepi32_pd(phase), _mm_set1_pd(KIN_PHASE_STEP));
+        angle = _mm_add_pd(angle, _mm_set1_pd(span->phase_offset));
+        _mm_storel_epi64((__m128i*)&live->phase[i], _mm_add_epi32(phase, _mm_set1_epi32((int)stride)));
+        __m128d speed = _mm_add_pd(_mm_set1_pd(span->speed_base),
+                                   _mm_mul_pd(_mm_set1_pd(span->speed_amp), kin_sin_sse2(angle)));
+
+        __m128d turned_lat = _mm_loadu_pd(&live->vel_lat[i]);
+        __m128d turned_lon = _mm_loadu_pd(&live->vel_lon[i]);
+        __m128d turn_cos = _mm_loadu_pd(&live->turn_cos[i]);
+        __m128d turn_sin = _mm_loadu_pd(&live->turn_sin[i]);
+        for (uint32_t s = 0; s < stride; s++) {
+            __m128d next_lat = _mm_sub_pd(_mm_mul_pd(turned_lat, turn_cos), _mm_mul_pd(turned_lon, turn_sin));
+            turned_lon = _mm_add_pd(_mm_mul_pd(turned_lat, turn_sin), _mm_mul_pd(turned_lon, turn_cos));
+            turned_lat = next_lat;
+        }
+        _mm_storeu_pd(&live->vel_lat[i], turned_lat);
+        _mm_storeu_pd(&live->vel_lon[i], turned_lon);
+
+        __m128d dir_lat = kin_load_dir2(&live->dir_lat[i]);
+        __m128d dir_lon = kin_load_dir2(&live->dir_lon[i]);
+        __m128d lat = kin_axis_sse2(_mm_loadu_pd(&live->lat[i]), turned_lat, speed,
+                                    &dir_lat, _mm_loadu_pd(&noise_lat[i - begin]), MIN_LAT, MAX_LAT);
+        __m128d lon = kin_axis_sse2(_mm_loadu_pd(&live->lon[i]), turned_lon, speed,
+                                    &dir_lon, _mm_loadu_pd(&noise_lon[i - begin]), MIN_LON, MAX_LON);
+
+        _mm_storeu_pd(&live->lat[i], lat);
+        _mm_storeu_pd(&live->lon[i], lon);
+        kin_store_dir2(&live->dir_lat[i], dir_lat);
+        kin_store_dir2(&live->dir_lon[i], dir_lon);
+    }
+    kin_rows_scalar(live, i, end, span, noise_lat + (i - begin), noise_lon + (i - begin));
+}
+
+/* =================================================================
+   [3] AVX2 Kernel (4-wide, 실행 시 CPU 확인 후 사용)
+================================================================= */
+
+#define KIN_AVX2 __attribute__((target("avx2")))
+
+static inline KIN_AVX2 __m256d kin_sin_avx2(__m256d x) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d magic = _mm256_set1_pd(KIN_ROUND_MAGIC);
+    const __m256d half_pi = _mm256_set1_pd(KIN_HALF_PI);
+
+    __m256d k = _mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(x, _mm256_set1_pd(KIN_INV_TWO_PI)), magic), magic);
+    __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(KIN_TWO_PI)));
+    __m256d s = _mm256_sub_pd(half_pi, _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_andnot_pd(sign, r), half_pi)));
+    s = _mm256_or_pd(s, _mm256_and_pd(r, sign));
+
+    __m256d s2 = _mm256_mul_pd(s, s);
+    __m256d p = _mm256_set1_pd(KIN_SIN_C11);
+    p = _mm256_add_pd(_mm256_mul_pd(p, s2), _mm256_set1_pd(KIN_SIN_C9));
+    p = _mm256_add_pd(_mm256_mul_pd(p, s2), _mm256_set1_pd(KIN_SIN_C7));
+    p = _mm256_add_pd(_mm256_mul_pd(p, s2), _mm256_set1_pd(KIN_SIN_C5));
+    p = _mm256_add_pd(_mm256_mul_pd(p, s2), _mm256_set1_pd(KIN_SIN_C3));
+    return _mm256_add_pd(s, _mm256_mul_pd(s, _mm256_mul_pd(s2, p)));
+}
+
+static inline KIN_AVX2 __m256d kin_load_dir4(const int8_t* dir) {
+    int32_t quad;
+    memcpy(&quad, dir, sizeof(quad));
+    return _mm256_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(quad)));
+}
+
+static inline KIN_AVX2 void kin_store_dir4(int8_t* dir, __m256d value) {
+    __m128i v = _mm256_cvttpd_epi32(value);
+    v = _mm_packs_epi16(_mm_packs_epi32(v, v), v);
+    int32_t quad = _mm_cvtsi128_si32(v);
+    memcpy(dir, &quad, sizeof(quad));
+}
+
+static inline KIN_AVX2 __m256d kin_axis_avx2(__m256d pos, __m256d vel, __m256d speed, __m256d* dir,
+                                             __m256d noise, double lo, double hi) {
+    __m256d next = _mm256_add_pd(_mm256_add_pd(pos, _mm256_mul_pd(_mm256_mul_pd(vel, speed), *dir)), noise);
+    __m256d out = _mm256_or_pd(_mm256_cmp_pd(next, _mm256_set1_pd(hi), _CMP_GT_OQ),
+                               _mm256_cmp_pd(next, _mm256_set1_pd(lo), _CMP_LT_OQ));
+    *dir = _mm256_xor_pd(*dir, _mm256_and_pd(out, _mm256_set1_pd(-0.0)));
+    return next;
+}
+
+static KIN_AVX2 void kin_rows_avx2(LiveTable* live, size_t begin, size_t end, const KinematicsSpan* span,
+                                   const double* noise_lat, const double* noise_lon) {
+    const uint32_t stride = span->stride;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128i phase = _mm_loadu_si128((const __m128i*)&live->phase[i]);
+        __m256d angle = _mm256_mul_pd(_mm256_cvtepi32_pd(phase), _mm256_set1_pd(KIN_PHASE_STEP));
+        angle = _mm256_add_pd(angle, _mm256_set1_pd(span->phase_offset));
+        _mm_storeu_si128((__m128i*)&live->phase[i], _mm_add_epi32(phase, _mm_set1_epi32((int)stride)));
+        __m256d speed = _mm256_add_pd(_mm256_set1_pd(span->speed_base),
+                                      _mm256_mul_pd(_mm256_set1_pd(span->speed_amp), kin_sin_avx2(angle)));
+
+        __m256d turned_lat = _mm256_loadu_pd(&live->vel_lat[i]);
+        __m256d turned_lon = _mm256_loadu_pd(&live->vel_lon[i]);
+        __m256d turn_cos = _mm256_loadu_pd(&live->turn_cos[i]);
+        __m256d turn_sin = _mm256_loadu_pd(&live->turn_sin[i]);
+        for (uint32_t s = 0; s < stride; s++) {
+            __m256d next_lat = _mm256_sub_pd(_mm256_mul_pd(turned_lat, turn_cos), _mm256_mul_pd(turned_lon, turn_sin));
+            turned_lon = _mm256_add_pd(_mm256_mul_pd(turned_lat, turn_sin), _mm256_mul_pd(turned_lon, turn_cos));
+            turned_lat = next_lat;
+        }
+        _mm256_storeu_pd(&live->vel_lat[i], turned_lat);
+        _mm256_storeu_pd(&live->vel_lon[i], turned_lon);
+
+        __m256d dir_lat = kin_load_dir4(&live->dir_lat[i]);
+        __m256d dir_lon = kin_load_dir4(&live->dir_lon[i]);
+        __m256d lat = kin_axis_avx2(_mm256_loadu_pd(&live->lat[i]), turned_lat, speed,
+                                    &dir_lat, _mm256_loadu_pd(&noise_lat[i - begin]), MIN_LAT, MAX_LAT);
+        __m256d lon = kin_axis_avx2(_mm256_loadu_pd(&live->lon[i]), turned_lon, speed,
+                                    &dir_lon, _mm256_loadu_pd(&noise_lon[i - begin]), MIN_LON, MAX_LON);
+
+        _mm256_storeu_pd(&live->lat[i], lat);
+        _mm256_storeu_pd(&live->lon[i], lon);
+        kin_store_dir4(&live->dir_lat[i], dir_lat);
+        kin_store_dir4(&live->dir_lon[i], dir_lon);
+    }
+    kin_rows_scalar(live, i, end, span, noise_lat + (i - begin), noise_lon + (i - begin));
+}
+
+#endif // KIN_X86
+
+/* =================================================================
+   [4] Runtime Dispatch
+================================================================= */
+
+typedef struct {
+    const char*         name;
+    KinematicsKernel    kernel;
+} KinematicsBackend;
+
+// 선호 순서 (넓은 벡터 우선)
+static const KinematicsBackend kin_backends[] = {
+#if defined(KIN_X86)
+    { "avx2", kin_rows_avx2 },
+    { "sse2", kin_rows_sse2 },
+#endif
+    { "scalar", kin_rows_scalar },
+};
+
+static KinematicsKernel kin_kernel = kin_rows_scalar;
+static const char* kin_kernel_name = "scalar";
+
+static bool kin_supported(const char* name) {
+#if defined(KIN_X86)
+    __builtin_cpu_init();
+    if (strcmp(name, "avx2") == 0) return __builtin_cpu_supports("avx2");
+    if (strcmp(name, "sse2") == 0) return __builtin_cpu_supports("sse2");
+#endif
+    return strcmp(name, "scalar") == 0;
+}
+
+/**
+ * @brief 운동 커널 선택
+ * @param name "avx2" / "sse2" / "scalar", NULL이면 이 CPU에서 가장 넓은 커널
+ * @return 선택된 커널 이름 (지원하지 않는 이름이면 NULL, 기존 선택 유지)
+ * @note  틱이 돌지 않을 때(엔진 부팅, 벤치마크 준비) 호출합니다. 호출 전 기본값은 스칼라입니다.
+ */
+const char* kinematics_select(const char* name) {
+    for (size_t i = 0; i < sizeof(kin_backends) / sizeof(kin_backends[0]); i++) {
+        if (name != NULL && strcmp(name, kin_backends[i].name) != 0) continue;
+        if (!kin_supported(kin_backends[i].name)) continue;
+        kin_kernel = kin_backends[i].kernel;
+        kin_kernel_name = kin_backends[i].name;
+        return kin_kernel_name;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 행 [begin, end)의 운동 상태를 stride 틱만큼 갱신 (선회, 위치, 경계 반사, 위상)
+ * @param stride 적분 시간 간격 [틱] (다중 주기 모드에서는 행의 지난 갱신 이후 틱 수). 1이면 기존 한 틱 갱신과 비트 단위로 같음
+ * @note  위치는 stride 틱 동안의 속도 배율 합으로 한 번에 옮기고, 선회는 stride번 회전합니다.
+ *        난기류는 (seed, 표적 ID, tick) 카운터 난수로 KIN_BATCH행씩 미리 뽑은 뒤 커널에 넘기며,
+ *        stride 틱 동안 독립 흔들림이 쌓인 만큼(표준편차 √stride배) 키워서 한 번에 더합니다.
+ *        정수 해시는 스칼라로, 부동소수점 운동 방정식은 선택된 SIMD 커널로 처리합니다.
+ */
+void kinematics_step(LiveTable* live, size_t begin, size_t end, uint32_t stride, uint64_t seed, uint32_t tick) {
+    const double half_step = KIN_PHASE_STEP * 0.5;
+    KinematicsSpan span = { stride, 5.5 * stride, 4.5, 0.0 };
+    if (stride > 1) {
+        span.speed_amp = 4.5 * sin(stride * half_step) / sin(half_step);
+        span.phase_offset = (stride - 1) * half_step;
+    }
+    double scale = KIN_NOISE_SCALE * sqrt((double)stride);
+    double noise_lat[KIN_BATCH], noise_lon[KIN_BATCH];
+    for (size_t batch = begin; batch < end; batch += KIN_BATCH) {
+        size_t stop = batch + KIN_BATCH < end ? batch + KIN_BATCH : end;
+        for (size_t i = batch; i < stop; i++) {
+            uint64_t r = tmap_rng_at(seed, live->id[i], tick);
+            noise_lat[i - batch] = (((uint32_t)r % 100) / 100.0 - 0.5) * scale;
+            noise_lon[i - batch] = (((uint32_t)(r >> 32) % 100) / 100.0 - 0.5) * scale;
+        }
+        kin_kernel(live, batch, stop, &span, noise_lat, noise_lon);
+    }
+}
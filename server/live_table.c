@@ -0,0 +1,199 @@
+/**
+ * @file    live_table.c
+ * @brief   Live Track Table (Structure-of-Arrays Hot State)
+ * @details 매 틱 갱신되는 활성 표적 상태(위치, 속도, 방향, 위협도)를 필드별 연속 배열로 관리합니다.
+ *          표적은 첫 위치가 기록될 때 등록되고, 요격/해제 시 마지막 행과 자리를 바꿔 O(1)로 빠집니다.
+ *          B-Tree, 해시 인덱스, 위협도 인덱스는 계속 TacticalTrack*를 가리키며,
+ *          표적 본체의 live_slot이 이 테이블의 행 번호입니다.
+ */
+
+#include "common.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#define LIVE_TABLE_MIN_CAPACITY 1024   // 첫 등록 시 할당하는 행 수 (빈 테이블은 { 0 }으로 시작)
+
+/* =================================================================
+   [1] Storage
+================================================================= */
+
+// 열 하나를 새 용량으로 재할당 (실패 시 기존 배열 유지)
+#define LIVE_GROW_COLUMN(table, column, capacity)                                        \
+    do {                                                                                 \
+        void* grown = realloc((table)->column, sizeof(*(table)->column) * (capacity));   \
+        if (grown == NULL) return false;                                                 \
+        (table)->column = grown;                                                         \
+    } while (0)
+
+static bool live_table_grow(LiveTable* table) {
+    size_t capacity = table->capacity ? table->capacity * 2 : LIVE_TABLE_MIN_CAPACITY;
+    // 일부 열만 커진 채 실패해도 capacity는 그대로이므로 테이블은 일관된 상태로 남음
+    LIVE_GROW_COLUMN(table, id, capacity);
+    LIVE_GROW_COLUMN(table, lat, capacity);
+    LIVE_GROW_COLUMN(table, lon, capacity);
+    LIVE_GROW_COLUMN(table, vel_lat, capacity);
+    LIVE_GROW_COLUMN(table, vel_lon, capacity);
+    LIVE_GROW_COLUMN(table, turn_cos, capacity);
+    LIVE_GROW_COLUMN(table, turn_sin, capacity);
+    LIVE_GROW_COLUMN(table, dir_lat, capacity);
+    LIVE_GROW_COLUMN(table, dir_lon, capacity);
+    LIVE_GROW_COLUMN(table, phase, capacity);
+    LIVE_GROW_COLUMN(table, threat, capacity);
+    LIVE_GROW_COLUMN(table, last_tick, capacity);
+    LIVE_GROW_COLUMN(table, track, capacity);
+    table->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief 테이블 메모리 해제 (표적 본체는 해제하지 않음)
+ */
+void live_table_free(LiveTable* table) {
+    free(table->id);
+    free(table->lat);
+    free(table->lon);
+    free(table->vel_lat);
+    free(table->vel_lon);
+    free(table->turn_cos);
+    free(table->turn_sin);
+    free(table->dir_lat);
+    free(table->dir_lon);
+    free(table->phase);
+    free(table->threat);
+    free(table->last_tick);
+    free(table->track);
+    *table = (LiveTable){ 0 };
+}
+
+/* =================================================================
+   [2] Membership
+================================================================= */
+
+/**
+ * @brief 표적을 테이블 끝 행에 등록 [분할상환 O(1)]
+ * @note  기동 상태는 표적 본체의 motion 사본에서 가져옵니다. 새 행은 마지막 시뮬레이션 틱에
+ *        갱신한 것으로 보고, 다중 주기 단계와 조각은 다음 틱에 다시 정합니다.
+ * @return 등록한 행 번호 (실패 시 -1)
+ */
+int live_table_add(LiveTable* table, TacticalTrack* track, double lat, double lon) {
+    if (table->count == table->capacity && !live_table_grow(table)) {
+        printf("[FATAL ERROR] Memory allocation failed for live track table.\n");
+        return -1;
+    }
+
+    const TrackMotion* m = &track->motion;
+    size_t slot = table->count++;
+    table->id[slot]       = track->track_id;
+    table->lat[slot]      = lat;
+    table->lon[slot]      = lon;
+    table->vel_lat[slot]  = m->vel_lat;
+    table->vel_lon[slot]  = m->vel_lon;
+    table->turn_cos[slot] = (m->turn != 0.0) ? cos(m->turn) : 1.0;
+    table->turn_sin[slot] = (m->turn != 0.0) ? sin(m->turn) : 0.0;
+    table->dir_lat[slot]  = m->dir_lat;
+    table->dir_lon[slot]  = m->dir_lon;
+    table->phase[slot]    = m->phase;
+    table->threat[slot]   = track->threat_level;
+    table->last_tick[slot] = table->tick;
+    table->track[slot]    = track;
+    table->tiered = false;
+    track->live_slot = (int)slot;
+    return (int)slot;
+}
+
+/**
+ * @brief 테이블 행의 최신 기동 상태를 표적 본체의 motion 사본에 기록 (저장 직전 등)
+ * @note  선회율은 행에서 바뀌지 않으므로 복사하지 않습니다. 미등록 표적이면 아무것도 하지 않습니다.
+ */
+void live_table_sync_motion(const LiveTable* table, TacticalTrack* track) {
+    if (track->live_slot < 0) return;
+    size_t slot = (size_t)track->live_slot;
+    track->motion.vel_lat = table->vel_lat[slot];
+    track->motion.vel_lon = table->vel_lon[slot];
+    track->motion.dir_lat = table->dir_lat[slot];
+    track->motion.dir_lon = table->dir_lon[slot];
+    track->motion.phase   = table->phase[slot];
+}
+
+/**
+ * @brief 표적을 테이블에서 제거 (마지막 행을 빈자리로 옮김) [O(1)]
+ * @note  빠지기 직전의 기동 상태는 표적 본체에 남겨 둡니다.
+ */
+void live_table_remove(LiveTable* table, TacticalTrack* track) {
+    if (track->live_slot < 0) return;
+    live_table_sync_motion(table, track);
+    size_t slot = (size_t)track->live_slot;
+    size_t last = --table->count;
+
+    if (slot != last) {
+        table->id[slot]       = table->id[last];
+        table->lat[slot]      = table->lat[last];
+        table->lon[slot]      = table->lon[last];
+        table->vel_lat[slot]  = table->vel_lat[last];
+        table->vel_lon[slot]  = table->vel_lon[last];
+        table->turn_cos[slot] = table->turn_cos[last];
+        table->turn_sin[slot] = table->turn_sin[last];
+        table->dir_lat[slot]  = table->dir_lat[last];
+        table->dir_lon[slot]  = table->dir_lon[last];
+        table->phase[slot]    = table->phase[last];
+        table->threat[slot]   = table->threat[last];
+        table->last_tick[slot] = table->last_tick[last];
+        table->track[slot]    = table->track[last];
+        table->track[slot]->live_slot = (int)slot;
+    }
+    table->tiered = false;
+    track->live_slot = -1;
+}
+
+// 열 하나에서 두 행의 값을 맞바꿈
+#define LIVE_SWAP_COLUMN(table, column, a, b)                                            \
+    do {                                                                                 \
+        __typeof__(*(table)->column) tmp = (table)->column[a];                           \
+        (table)->column[a] = (table)->column[b];                                         \
+        (table)->column[b] = tmp;                                                        \
+    } while (0)
+
+/**
+ * @brief 두 행의 자리를 맞바꿈 (다중 주기 단계 정렬용) [O(1)]
+ * @note  표적 본체의 live_slot도 함께 고칩니다. 틱이 돌지 않을 때만 호출합니다.
+ */
+void live_table_swap_rows(LiveTable* table, size_t a, size_t b) {
+    if (a == b) return;
+    LIVE_SWAP_COLUMN(table, id, a, b);
+    LIVE_SWAP_COLUMN(table, lat, a, b);
+    LIVE_SWAP_COLUMN(table, lon, a, b);
+    LIVE_SWAP_COLUMN(table, vel_lat, a, b);
+    LIVE_SWAP_COLUMN(table, vel_lon, a, b);
+    LIVE_SWAP_COLUMN(table, turn_cos, a, b);
+    LIVE_SWAP_COLUMN(table, turn_sin, a, b);
+    LIVE_SWAP_COLUMN(table, dir_lat, a, b);
+    LIVE_SWAP_COLUMN(table, dir_lon, a, b);
+    LIVE_SWAP_COLUMN(table, phase, a, b);
+    LIVE_SWAP_COLUMN(table, threat, a, b);
+    LIVE_SWAP_COLUMN(table, last_tick, a, b);
+    LIVE_SWAP_COLUMN(table, track, a, b);
+    table->track[a]->live_slot = (int)a;
+    table->track[b]->live_slot = (int)b;
+}
+
+/* =================================================================
+   [3] Inspection
+================================================================= */
+
+/**
+ * @brief 실시간 표적 테이블의 최종 위치 요약값 (행 순서와 무관한 XOR 해시)
+ * @note  회귀 시나리오와 벤치마크에서 같은 입력이 같은 궤적을 만들었는지 비교할 때 씁니다.
+ */
+uint64_t live_table_digest(const LiveTable* live) {
+    uint64_t digest = 0;
+    for (size_t i = 0; i < live->count; i++) {
+        uint64_t lat_bits, lon_bits;
+        memcpy(&lat_bits, &live->lat[i], sizeof(lat_bits));
+        memcpy(&lon_bits, &live->lon[i], sizeof(lon_bits));
+        digest ^= tmap_rng_mix(tmap_rng_mix(lat_bits ^ (uint64_t)live->id[i]) ^ lon_bits);
+    }
+    return digest;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file    lod.c
+ * @brief   Multi-Rate Level-of-Detail Scheduling
+ * @details 실시간 표적 테이블의 행을 갱신 단계(0 ~ LOD_TIERS-1)와 단계 안의 조각(2^t개) 순으로 모아 두고,
+ *          틱마다 단계마다 차례가 된 조각 하나만 골라 지난 갱신 이후 흐른 틱 수만큼 적분하게 합니다.
+ *          단계는 위협도와 사령부(HQ)까지의 거리로 정하며, 단계별 예산을 넘으면 먼 표적부터 한 단계씩 강등합니다.
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern void live_table_swap_rows(LiveTable* table, size_t a, size_t b);
+
+#define LOD_RANK_LEVELS  256            // 강등 순위 양자화 단계 (0 = 위협도로 고정된 표적)
+#define LOD_RANK_RANGE   0.1            // 순위 1 ~ 255가 덮는 HQ 거리 [도]
+#define LOD_HYSTERESIS   0.1            // 단계를 옮기려면 경계를 반경의 10% 이상 넘어야 함 (경계 부근 반복 이동 방지)
+#define LOD_SLICE_SLACK  8              // 조각이 평균의 1/8을 넘게 차기 전까지는 표적을 제 박자에 둠
+
+/**
+ * @brief 새 엔진의 다중 주기 정책 (기본값: 꺼짐, 켜면 HQ 1.5 / 3 / 5 km 경계, 예산 무제한)
+ */
+const LodPolicy tmap_lod_defaults = { false, 7, { 0.015, 0.03, 0.05 }, { 0, 0, 0 }, 8 };
+
+/* =================================================================
+   [1] Tier Assignment
+================================================================= */
+
+// 거리 단계: 경계 반경에 scale을 곱해 판정
+static uint8_t lod_distance_tier(double dist2, const LodPolicy* policy, double scale) {
+    uint8_t tier = 0;
+    while (tier < LOD_TIERS - 1) {
+        double radius = policy->tier_radius[tier] * scale;
+        if (dist2 < radius * radius) break;
+        tier++;
+    }
+    return tier;
+}
+
+/**
+ * @brief 행의 희망 단계와 강등 순위 (순위가 클수록 먼저 강등)
+ * @param current 지금 단계 (모르면 -1). 경계 부근(±LOD_HYSTERESIS)에서는 지금 단계를 유지합니다.
+ */
+static uint8_t lod_classify(const LiveTable* live, size_t row, const LodPolicy* policy, int current, uint8_t* rank) {
+    double d_lat = live->lat[row] - HQ_LAT;
+    double d_lon = (live->lon[row] - HQ_LON) * LON_SCALE;
+    double dist2 = d_lat * d_lat + d_lon * d_lon;
+
+    if (live->threat[row] >= policy->full_threat) {
+        *rank = 0;
+        return 0;
+    }
+    double scaled = dist2 / (LOD_RANK_RANGE * LOD_RANK_RANGE);     // 제곱 거리로 순위를 매겨 sqrt 생략
+    *rank = (uint8_t)(1 + (scaled >= 1.0 ? LOD_RANK_LEVELS - 2 : (int)(scaled * (LOD_RANK_LEVELS - 2))));
+
+    if (current < 0) return lod_distance_tier(dist2, policy, 1.0);
+    uint8_t inner = lod_distance_tier(dist2, policy, 1.0 + LOD_HYSTERESIS);    // 바깥 단계로 가기 어렵게
+    uint8_t outer = lod_distance_tier(dist2, policy, 1.0 - LOD_HYSTERESIS);    // 안쪽 단계로 가기 어렵게
+    if (current < inner) return inner;
+    if (current > outer) return outer;
+    return (uint8_t)current;
+}
+
+/**
+ * @brief 예산을 넘은 단계에서 순위가 큰(먼) 표적부터 다음 단계로 강등
+ * @note  순위 히스토그램으로 예산 안에 드는 최대 순위를 찾으므로 정렬 없이 O(n)입니다.
+ *        위협도로 고정된 표적(순위 0)도 예산을 넘으면 강등되므로 예산은 엄격한 상한입니다.
+ */
+static void lod_apply_budget(uint8_t* tiers, const uint8_t* ranks, size_t n, uint8_t tier, size_t budget) {
+    size_t hist[LOD_RANK_LEVELS] = { 0 };
+    size_t members = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (tiers[i] == tier) { hist[ranks[i]]++; members++; }
+    }
+    if (members <= budget) return;
+
+    // cutoff 순위까지는 전부 남기고, 경계 순위(cutoff + 1)는 남은 자리만큼 행 순서대로 채움
+    int cutoff = -1;
+    size_t kept = 0;
+    while (cutoff + 1 < LOD_RANK_LEVELS && kept + hist[cutoff + 1] <= budget) kept += hist[++cutoff];
+    size_t room = budget - kept;
+    for (size_t i = 0; i < n; i++) {
+        if (tiers[i] != tier || ranks[i] <= cutoff) continue;
+        if (ranks[i] == cutoff + 1 && room > 0) { room--; continue; }
+        tiers[i] = (uint8_t)(tier + 1);
+    }
+}
+
+/**
+ * @brief 행의 조각 (이번 틱 + 0 ~ 2^t-1 틱 중 첫 갱신 시각)
+ * @param load 단계 t 조각별로 이미 배정한 행 수
+ * @param cap  조각 하나에 둘 행 수 (넘치면 더 이른 조각 중 가장 빈 곳으로)
+ * @note  늦어도 마지막 갱신 후 2^t 틱째에는 갱신되도록 그 안의 조각만 고릅니다.
+ *        단계가 그대로인 표적은 그 시각이 곧 직전 박자라, 조각이 넘치지 않는 한 박자가 바뀌지 않습니다.
+ */
+static uint8_t lod_slice(uint32_t last_tick, uint32_t tick, uint8_t tier, const size_t* load, size_t cap) {
+    uint32_t stride = 1u << tier;
+    int32_t latest = (int32_t)(last_tick - tick) + (int32_t)stride;   // 이번 틱부터 세어 늦어도 몇 틱 뒤
+    if (latest < 0) latest = 0;                                        // 이미 늦음 (빠른 단계로 옮김): 이번 틱
+    if (latest > (int32_t)stride - 1) latest = (int32_t)stride - 1;
+    uint8_t base = (uint8_t)(stride - 1);
+    uint32_t best = (uint32_t)latest;
+    if (load[base + ((tick + best) & (stride - 1))] >= cap) {
+        for (uint32_t k = 0; k < (uint32_t)latest; k++) {
+            if (load[base + ((tick + k) & (stride - 1))] < load[base + ((tick + best) & (stride - 1))]) best = k;
+        }
+    }
+    return (uint8_t)(base + ((tick + best) & (stride - 1)));
+}
+
+/**
+ * @brief 모든 행의 단계와 조각을 다시 정하고 그 순으로 재배치 [O(n)]
+ * @param tick 이번 틱 (아직 갱신 전). 단계 t 조각 s의 행은 tick 이후 (틱 mod 2^t) == s인 틱마다 갱신됩니다.
+ * @note  행 번호만 바뀌고 표적 상태와 마지막 갱신 틱은 행을 따라가므로 궤적과 난수열에는 영향이 없습니다.
+ *        틱이 돌지 않을 때(simulate_flight 진입 직후) 호출합니다.
+ */
+void lod_retier(LiveTable* live, const LodPolicy* policy, uint32_t tick) {
+    size_t n = live->count;
+    bool layout_valid = (live->tiered && n > 0);    // 행 추가/삭제가 없었으면 지금 단계를 앎
+    size_t previous_end[LOD_TIERS];
+    memcpy(previous_end, live->tier_end, sizeof(previous_end));
+    live->tiered = true;
+    for (int t = 0; t < LOD_TIERS; t++) live->tier_end[t] = n;
+    for (int s = 0; s < LOD_SLICES; s++) live->slice_end[s] = n;
+    if (n == 0) return;
+
+    uint8_t* tiers = (uint8_t*)malloc(n * 3);
+    if (tiers == NULL) {
+        // 단계를 못 나누면 전부 단계 0 (매 틱 갱신)으로 둠
+        printf("[WARN] Memory allocation failed for LOD tiers. Updating all tracks every tick.\n");
+        return;
+    }
+    uint8_t* ranks = tiers + n;
+    uint8_t* slices = ranks + n;
+    int current = layout_valid ? 0 : -1;
+    for (size_t i = 0; i < n; i++) {
+        while (layout_valid && i >= previous_end[current]) current++;
+        tiers[i] = lod_classify(live, i, policy, current, &ranks[i]);
+    }
+    for (uint8_t t = 0; t < LOD_TIERS - 1; t++) {
+        if (policy->budget[t] > 0) lod_apply_budget(tiers, ranks, n, t, policy->budget[t]);
+    }
+
+    // 조각 배정: 단계 t의 행을 2^t 조각에 고르게 나눠 틱당 작업량을 평평하게 유지
+    size_t tier_rows[LOD_TIERS] = { 0 };
+    size_t cap[LOD_TIERS];
+    size_t load[LOD_SLICES] = { 0 };
+    for (size_t i = 0; i < n; i++) tier_rows[tiers[i]]++;
+    for (int t = 0; t < LOD_TIERS; t++) {
+        size_t per_slice = tier_rows[t] >> t;
+        cap[t] = per_slice + per_slice / LOD_SLICE_SLACK + 1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        slices[i] = lod_slice(live->last_tick[i], tick, tiers[i], load, cap[tiers[i]]);
+        load[slices[i]]++;
+    }
+
+    // 조각별 구간 경계 후 제자리 버킷 정렬: 자리를 바꿀 때마다 한 행이 최종 구간에 들어감
+    size_t next[LOD_SLICES] = { 0 };
+    size_t end = 0;
+    for (int s = 0; s < LOD_SLICES; s++) {
+        next[s] = end;
+        end += load[s];
+        live->slice_end[s] = end;
+    }
+    for (int t = 0; t < LOD_TIERS; t++) live->tier_end[t] = live->slice_end[(2 << t) - 2];
+    for (uint8_t s = 0; s < LOD_SLICES; s++) {
+        while (next[s] < live->slice_end[s]) {
+            size_t row = next[s];
+            uint8_t home = slices[row];
+            if (home == s) { next[s]++; continue; }
+            while (slices[next[home]] == home) next[home]++;    // 이미 제자리인 행은 건너뜀
+            size_t dest = next[home]++;
+            live_table_swap_rows(live, row, dest);
+            slices[row] = slices[dest];
+            slices[dest] = home;
+        }
+    }
+    free(tiers);
+}
+
+/* =================================================================
+   [2] Per-Tick Selection
+================================================================= */
+
+/**
+ * @brief 이번 틱에 갱신할 행 구간 (단계마다 최대 하나)
+ * @return 구간 수. 다중 주기 모드가 꺼져 있으면 전체 행 1구간 (간격 1)
+ * @note  단계 t의 조각 s는 (틱 mod 2^t) == s인 틱에만 갱신되고, 행은 지난 갱신 이후 흐른 틱 수만큼
+ *        적분합니다 (simulate_flight). 단계와 조각이 그대로인 표적은 정확히 2^t 틱마다 한 번 2^t 틱씩 갱신되며,
+ *        재배정으로 단계나 조각이 바뀐 표적도 마지막 갱신 후 새 단계의 2^t 틱 안에 갱신됩니다.
+ *        따라서 표적마다 적분한 틱 수의 합은 경과 틱 수와 같고, 틱이 끝날 때 차이는 아직 적분하지 않은
+ *        2^t 틱 미만뿐입니다. 표적을 추가/삭제했거나 재배정 주기가 되면 먼저 단계를 다시 정합니다.
+ *        틱 번호가 이어지지 않으면(첫 틱, 틱 번호를 새로 시작) 모든 행을 직전 틱에 갱신한 것으로 맞춥니다.
+ */
+int lod_select(LiveTable* live, const LodPolicy* policy, uint32_t tick, LodRange ranges[LOD_TIERS]) {
+    if (tick != live->tick + 1) {
+        for (size_t i = 0; i < live->count; i++) live->last_tick[i] = tick - 1;
+    }
+    live->tick = tick;
+    if (!policy->enabled) {
+        ranges[0] = (LodRange){ 0, live->count, 1 };
+        return 1;
+    }
+    int interval = policy->retier_ticks > 0 ? policy->retier_ticks : 1;
+    if (!live->tiered || tick % (uint32_t)interval == 0) lod_retier(live, policy, tick);
+
+    int count = 0;
+    for (int t = 0; t < LOD_TIERS; t++) {
+        uint32_t stride = 1u << t;
+        int slice = (int)(stride - 1 + (tick & (stride - 1)));
+        size_t lo = slice > 0 ? live->slice_end[slice - 1] : 0;
+        size_t hi = live->slice_end[slice];
+        if (hi > lo) ranges[count++] = (LodRange){ lo, hi, stride };
+    }
+    return count;
+}
+
+/**
+ * @brief 단계별 표적 수 출력 (콘솔 LOD 명령)
+ */
+void lod_report(const LiveTable* live, const LodPolicy* policy) {
+    if (!policy->enabled) {
+        printf("[LOD] Multi-rate simulation is off. All %zu tracks update every tick.\n", live->count);
+        return;
+    }
+    size_t begin = 0;
+    double work = 0.0;
+    for (int t = 0; t < LOD_TIERS; t++) {
+        size_t rows = live->tier_end[t] - begin;
+        work += (double)rows / (double)(1u << t);
+        printf("[LOD] Tier %d (every %d tick%s): %zu tracks\n", t, 1 << t, t ? "s" : "", rows);
+        begin = live->tier_end[t];
+    }
+    if (begin > 0) printf("[LOD] Updates per tick: %.0f of %zu tracks (%.1fx fewer)\n", work, begin, begin / work);
+}
@@ -1,245 +1,676 @@
 #include "common.h"
+#include "clock.h"
+#include "rng.h"
 #include "../common/packet.h"
+#include "../common/transport.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <conio.h>      
-#include <windows.h>    
+#ifdef _WIN32
+    #include <conio.h>
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
 #include <stdbool.h>
-#include <math.h>
+#include <time.h>
 
 #define SERVER_PORT 8080 // 서버 수신용 포트
 #define CLIENT_PORT 9090 // 클라이언트 송신용 포트
-#define TICK_RATE_MS 100
-#define BASE_LAT 37.500000
-#define BASE_LON 127.000000
+#define TICK_RATE_HZ 10                 // 기본 틱 주파수 (--tick-hz, 최대 100)
 
-#define MIN_LAT 37.450000
-#define MAX_LAT 37.550000
-#define MIN_LON 126.930000
-#define MAX_LON 127.070000
+#define COMPACT_BUDGET_NS 2000000ull    // 틱당 묘비 정리에 쓸 수 있는 최대 시간 (2 ms)
+#define SIM_CHUNK_ROWS 4096             // 작업자가 한 번에 가져가는 표적 행 수
 
-#define MAX_ID_BUFFER 10000
-
-BTreeNode* btree_root = NULL;
-bool server_running = true;
-
-int dir_lat[MAX_ID_BUFFER];
-int dir_lon[MAX_ID_BUFFER];
-
-extern void insert_track(BTreeNode** root, TacticalTrack* track);
-extern TacticalTrack* create_track(int track_id, int threat_level);
+extern void insert_track(TrackArena* arena, BTreeNode** root, TacticalTrack* track);
+extern TacticalTrack* create_track(TmapEngine* engine, int track_id, int threat_level);
 extern void add_history_node(TacticalTrack* track, double lat, double lon, int timestamp);
-extern void broadcast_btree(BTreeNode* node, SOCKET sock, struct sockaddr_in* addr);
+extern void btree_cursor_first(BTreeCursor* cur, BTreeNode* root);
+extern void btree_cursor_seek(BTreeCursor* cur, BTreeNode* root, int32_t id);
+extern void btree_cursor_range(BTreeCursor* cur, BTreeNode* root, int32_t lo, int64_t hi);
+extern TacticalTrack* btree_cursor_next(BTreeCursor* cur);
+extern bool track_index_init(TrackIndex* idx, size_t expected_tracks);
+extern void track_index_free(TrackIndex* idx);
+extern bool track_index_put(TrackIndex* idx, int64_t key, TacticalTrack* track);
+extern TacticalTrack* track_index_get(const TrackIndex* idx, int64_t key);
+extern void intercept_track(TacticalTrack* track);
+extern bool tombstone_enqueue(TombstoneQueue* q, int32_t id);
+extern void tombstone_queue_free(TombstoneQueue* q);
+extern size_t compact_tombstones(TmapEngine* engine, uint64_t budget_ns);
+extern bool purge_tombstone(TmapEngine* engine, int32_t id);
+extern void threat_index_add(ThreatIndex* idx, TacticalTrack* track);
+extern void threat_index_remove(ThreatIndex* idx, TacticalTrack* track);
+extern TacticalTrack* threat_index_top(const ThreatIndex* idx);
+extern void threat_index_free(ThreatIndex* idx, TrackArena* arena);
+extern void scan_high_threat(const ThreatIndex* idx, int threshold);
+extern void live_table_free(LiveTable* table);
+extern bool worker_pool_init(WorkerPool* pool, int thread_count);
+extern void worker_pool_run(WorkerPool* pool, size_t total, size_t chunk, WorkerTask task, void* ctx);
+extern void worker_pool_free(WorkerPool* pool);
+extern void kinematics_step(LiveTable* live, size_t begin, size_t end, uint32_t stride, uint64_t seed, uint32_t tick);
+extern int lod_select(LiveTable* live, const LodPolicy* policy, uint32_t tick, LodRange ranges[LOD_TIERS]);
+extern void lod_report(const LiveTable* live, const LodPolicy* policy);
+extern const char* kinematics_select(const char* name);
+extern void tick_scheduler_init(TickScheduler* sched, int hz, TickPolicy policy);
+extern uint32_t tick_scheduler_begin(TickScheduler* sched);
+extern void tick_scheduler_end(TickScheduler* sched);
+extern uint64_t tick_scheduler_remaining_ns(const TickScheduler* sched);
+extern void tick_scheduler_report(const TickScheduler* sched);
+extern void tmap_arena_init(TrackArena* arena);
+extern void tmap_arena_report(const TrackArena* arena);
+extern void tmap_arena_release(TrackArena* arena);
+extern bool event_loop_init(EventLoop* loop, bool polled);
+extern bool event_loop_watch(EventLoop* loop, EventSource source, intptr_t fd);
+extern void event_loop_unwatch(EventLoop* loop, EventSource source, intptr_t fd);
+extern void event_loop_arm(EventLoop* loop, uint64_t deadline_ns);
+extern int event_loop_wait(EventLoop* loop, EventSource ready[EVENT_SOURCE_COUNT]);
+extern void event_loop_free(EventLoop* loop);
+extern const char* event_loop_backend(const EventLoop* loop);
+extern void command_ingest_datagram(const unsigned char* data, int len, const struct sockaddr_in* from, void* ctx);
+extern CommandTally command_batch_apply(TmapEngine* engine, CommandBatch* batch, int timestamp);
+extern void command_batch_free(CommandBatch* batch);
+extern int run_benchmark(const char* name);
+extern int run_headless(TmapEngine* engine, const char* script_path, int tick_hz, double sim_secs);
+extern int run_monte_carlo(const MonteCarloConfig* config);
+extern bool scenario_load(const char* path, EventQueue* q, uint64_t offset_ns, uint64_t* end_ns);
+extern size_t scenario_apply_due(TmapEngine* engine, EventQueue* q, uint64_t now_ns, int timestamp);
+extern void event_queue_free(EventQueue* q);
+extern void wire_encoder_init(WireEncoder* enc, WireMode mode);
+extern size_t wire_broadcast(WireEncoder* enc, const LiveTable* live, uint32_t tick, WireSink sink, void* ctx);
+extern bool wire_parse_mode(const char* name, WireMode* mode);
+extern void wire_encoder_free(WireEncoder* enc);
+extern void save_single_track(TacticalTrack* track, FILE* fp);
+extern void write_save_header(FILE* fp);
+extern void cold_storage_sink(const TacticalTrack* track, const HistoryPoint* points, int count, void* ctx);
+extern TacticalTrack** load_track_records(TmapEngine* engine, FILE* fp, size_t* out_count);
+extern BTreeNode* btree_bulk_load(TrackArena* arena, TacticalTrack* const* tracks, size_t n);
 
 void save_node_to_binary(BTreeNode* node, FILE* fp) {
-    if (node == NULL) return;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) save_node_to_binary(node->children[i], fp);
-        TacticalTrack* track = node->tracks[i];
-        if (track != NULL) {
-            fwrite(&track->track_id, sizeof(int), 1, fp);
-            fwrite(&track->threat_level, sizeof(int), 1, fp);
-            fwrite(&track->status, sizeof(int), 1, fp);
-            
-            int h_count = 0;
-            HistoryNode* curr = track->history_head;
-            while (curr != NULL) { h_count++; curr = curr->next; }
-            fwrite(&h_count, sizeof(int), 1, fp);
-            
-            curr = track->history_head;
-            while (curr != NULL) {
-                fwrite(&curr->lat, sizeof(double), 1, fp);
-                fwrite(&curr->lon, sizeof(double), 1, fp);
-                int time_dummy = 0; 
-                fwrite(&time_dummy, sizeof(int), 1, fp);
-                curr = curr->next;
-            }
-        }
+    write_save_header(fp);
+    BTreeCursor cur;
+    btree_cursor_first(&cur, node);
+    TacticalTrack* track;
+    while ((track = btree_cursor_next(&cur)) != NULL) {
+        save_single_track(track, fp);
     }
-    if (!node->is_leaf) save_node_to_binary(node->children[node->num_keys], fp);
 }
 
-void load_system_state(BTreeNode** root) {
+void load_system_state(TmapEngine* engine) {
     FILE* fp = fopen("tmap_data.dat", "rb");
     if (fp == NULL) {
         printf("[SYSTEM] No previous database found. Booting fresh instance.\n");
         return;
     }
     printf("[SYSTEM] Loading tactical database from 'tmap_data.dat'...\n");
-    
-    int id, threat, status, count;
-    while (fread(&id, sizeof(int), 1, fp) == 1) {
-        fread(&threat, sizeof(int), 1, fp);
-        fread(&status, sizeof(int), 1, fp);
-        fread(&count, sizeof(int), 1, fp);
-        
-        TacticalTrack* new_track = create_track(id, threat);
-        new_track->status = status;
-        for (int i = 0; i < count; i++) {
-            double lat, lon; int t;
-            fread(&lat, sizeof(double), 1, fp);
-            fread(&lon, sizeof(double), 1, fp);
-            fread(&t, sizeof(int), 1, fp);
-            add_history_node(new_track, lat, lon, t);
-        }
-        insert_track(root, new_track);
-        printf(" -> [RESTORED] Track ID: %04d (Threat: %d)\n", id, threat);
-    }
+    uint64_t started = tmap_now_ns();
+
+    size_t count = 0;
+    TacticalTrack** tracks = load_track_records(engine, fp, &count);
     fclose(fp);
-    printf("[SYSTEM] Database load complete.\n");
+
+    // 저장 파일은 ID 순서이므로 분할 없이 꽉 찬 노드로 한 번에 구축 [O(N)]
+    engine->root = btree_bulk_load(&engine->arena, tracks, count);
+    track_index_free(&engine->index);
+    track_index_init(&engine->index, count);
+    for (size_t i = 0; i < count; i++) {
+        track_index_put(&engine->index, tracks[i]->track_id, tracks[i]);
+        threat_index_add(&engine->threats, tracks[i]);
+        // 이전 세션에서 요격된 표적은 부팅 후 유휴 시간에 정리
+        if (tracks[i]->status != TRACK_STATUS_ACTIVE) tombstone_enqueue(&engine->graveyard, tracks[i]->track_id);
+    }
+    free(tracks);
+
+    printf("[SYSTEM] Database load complete. %zu tracks restored in %.1f ms.\n",
+           count, (tmap_now_ns() - started) / 1e6);
+}
+
+/**
+ * @brief 빈 엔진 인스턴스 준비 (기본 정책: 궤적 무제한 보존, 다중 주기 꺼짐, 직렬 틱)
+ */
+void engine_init(TmapEngine* engine, uint64_t seed) {
+    memset(engine, 0, sizeof(*engine));
+    tmap_arena_init(&engine->arena);
+    track_index_init(&engine->index, 0);
+    engine->lod = tmap_lod_defaults;
+    engine->seed = seed;
+    engine->running = true;
+}
+
+/**
+ * @brief 엔진 종료 시 인덱스를 해제하고 B-Tree 노드, 표적, 궤적을 슬랩 단위로 일괄 반환
+ * @note  노드/표적을 하나씩 순회하며 free하지 않으므로 표적 수와 무관하게 즉시 끝납니다.
+ *        작업자 풀은 호출자 소유이므로 해제하지 않습니다 (먼저 정지시킬 것).
+ */
+void engine_free(TmapEngine* engine) {
+    track_index_free(&engine->index);
+    tombstone_queue_free(&engine->graveyard);
+    threat_index_free(&engine->threats, &engine->arena);
+    live_table_free(&engine->live);
+    tmap_arena_release(&engine->arena);
+    engine->root = NULL;
 }
 
-void free_system_postorder(BTreeNode* node) {
-    if (node == NULL) return;
-    if (!node->is_leaf) {
-        for (int i = 0; i <= node->num_keys; i++) free_system_postorder(node->children[i]);
+/**
+ * @brief 새 표적 투입 (B-Tree, ID 인덱스, 위협도 인덱스에 등록하고 첫 위치 기록)
+ * @return 같은 ID가 활성 표적이거나 메모리가 부족하면 false
+ * @note  요격되어 아직 정리되지 않은 (묘비) 같은 ID는 먼저 물리 삭제하고 새 표적으로 투입합니다.
+ */
+bool deploy_target(TmapEngine* engine, int target_id, int threat_level, double lat, double lon, int timestamp) {
+    TacticalTrack* existing = track_index_get(&engine->index, target_id);
+    if (existing != NULL) {
+        if (existing->status == TRACK_STATUS_ACTIVE) return false;
+        purge_tombstone(engine, target_id);
     }
-    for (int i = 0; i < node->num_keys; i++) {
-        if (node->tracks[i] != NULL) {
-            HistoryNode* curr = node->tracks[i]->history_head;
-            while (curr != NULL) {
-                HistoryNode* temp = curr;
-                curr = curr->next;
-                free(temp); 
-            }
-            node->tracks[i]->history_head = NULL; 
-            free(node->tracks[i]); 
+    TacticalTrack* track = create_track(engine, target_id, threat_level);
+    if (track == NULL) return false;
+
+    add_history_node(track, lat, lon, timestamp);
+    insert_track(&engine->arena, &engine->root, track);
+    track_index_put(&engine->index, target_id, track);
+    threat_index_add(&engine->threats, track);
+    return true;
+}
+
+bool kill_target(TmapEngine* engine, int target_id) {
+    TacticalTrack* track = track_index_get(&engine->index, target_id);
+    if (track == NULL || track->status != TRACK_STATUS_ACTIVE) return false;
+
+    threat_index_remove(&engine->threats, track);
+
+    // 실시간 경로: 묘비만 세우고 궤적 메모리 반환. 트리 재조정은 틱 유휴 시간으로 미룸
+    intercept_track(track);
+    tombstone_enqueue(&engine->graveyard, target_id);
+    return true;
+}
+
+typedef struct {
+    LiveTable*  live;
+    uint64_t    seed;
+    uint32_t    tick;
+    int         timestamp;
+    LodRange    ranges[LOD_TIERS];  // 이번 틱에 갱신할 행 구간 (작업 번호는 구간을 이어 붙인 순서)
+    int         range_count;
+} FlightTick;
+
+/**
+ * @brief 작업 [begin, end)의 한 틱 비행 시뮬레이션 (작업자 한 명이 처리)
+ * @note  작업 번호는 이번 틱 갱신 구간들을 이어 붙인 순서이며, 구간마다 행 번호로 바꿔 처리합니다.
+ *        적분 간격은 행마다 지난 갱신 이후 틱 수(live->last_tick)라 단계를 옮긴 표적도 틱을 빠뜨리거나 겹쳐 세지 않습니다.
+ *        1단계는 실시간 표적 테이블의 열 배열만 SIMD 운동 커널로 갱신하고(포인터 추적 없음),
+ *        2단계에서 새 위치를 각 표적의 궤적에 덧붙입니다.
+ *        행과 그 표적은 이 청크만 만지므로 잠금이 없고, 공유 블록 풀만 풀 자체 잠금을 씁니다.
+ */
+static void simulate_flight_rows(void* ctx, size_t begin, size_t end) {
+    FlightTick* tick = (FlightTick*)ctx;
+    LiveTable* live = tick->live;
+
+    size_t offset = 0;
+    for (int r = 0; r < tick->range_count && offset < end; r++) {
+        const LodRange* range = &tick->ranges[r];
+        size_t size = range->end - range->begin;
+        size_t lo = begin > offset ? begin - offset : 0;
+        size_t hi = end - offset < size ? end - offset : size;
+        offset += size;
+        if (lo >= hi) continue;
+
+        // 1단계: 가감속(사인 파동) + 난기류 + 경계 반사 (kinematics.c)
+        // 행마다 지난 갱신 이후 흐른 틱 수만큼 적분 (단계가 그대로면 구간 전체가 stride로 같아 한 번에 처리)
+        size_t first = range->begin + lo, last = range->begin + hi;
+        for (size_t i = first; i < last; ) {
+            uint32_t elapsed = tick->tick - live->last_tick[i];
+            size_t run = i + 1;
+            while (run < last && tick->tick - live->last_tick[run] == elapsed) run++;
+            kinematics_step(live, i, run, elapsed, tick->seed, tick->tick);
+            i = run;
+        }
+
+        // 2단계: 새 좌표를 궤적에 기록
+        for (size_t i = first; i < last; i++) {
+            live->last_tick[i] = tick->tick;
+            add_history_node(live->track[i], live->lat[i], live->lon[i], tick->timestamp);
         }
     }
-    free(node); 
 }
 
-bool kill_target(BTreeNode* node, int target_id) {
-    if (node == NULL) return false;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf && kill_target(node->children[i], target_id)) return true;
-        TacticalTrack* track = node->tracks[i];
-        if (track != NULL && track->track_id == target_id) {
-            track->status = 0; 
-            return true;
+/**
+ * @brief 한 틱 비행 시뮬레이션 (작업자 풀에 청크로 분배, 전원 완료 후 반환)
+ * @param tick    시뮬레이션 틱 번호 (난수 카운터). 같은 씨앗(engine->seed)과 틱 번호 열이면
+ *                스레드 수, 행 순서와 무관하게 모든 표적의 궤적이 비트 단위로 같습니다.
+ * @note  engine->workers가 NULL이면 호출 스레드에서 직렬 실행합니다.
+ *        실행 중에는 표적 테이블의 행 추가/삭제(ADD, KILL)가 없어야 합니다 (메인 루프에서 순차 호출).
+ *        다중 주기 모드(engine->lod)에서는 이번 틱 차례인 단계 조각만 갱신합니다 (lod.c).
+ */
+void simulate_flight(TmapEngine* engine, uint32_t tick, int timestamp) {
+    FlightTick ctx = { &engine->live, engine->seed, tick, timestamp, { { 0 } }, 0 };
+    ctx.range_count = lod_select(&engine->live, &engine->lod, tick, ctx.ranges);
+
+    size_t total = 0;
+    for (int r = 0; r < ctx.range_count; r++) total += ctx.ranges[r].end - ctx.ranges[r].begin;
+    worker_pool_run(engine->workers, total, SIM_CHUNK_ROWS, simulate_flight_rows, &ctx);
+}
+
+// 실시간 송출 목적지 (WireSink 문맥 = Transport): 송신 대기열에 쌓기만 하고 틱 끝에 한꺼번에 송신
+static void udp_sink(const void* datagram, size_t len, void* ctx) {
+    transport_queue((Transport*)ctx, datagram, len);
+}
+
+/**
+ * @brief 활성 표적의 최신 상태를 UDP로 브로드캐스트 (실시간 표적 테이블 순차 스캔)
+ * @note  기본은 v2 차분 프레임 단위 송출이라 데이터그램 수와 바이트가 표적 수보다 훨씬 적고 (wire.c),
+ *        Linux에서는 그 프레임들을 sendmmsg로 몇 번의 시스템 호출에 보냅니다 (transport.h).
+ */
+void broadcast_live_tracks(WireEncoder* enc, const LiveTable* live, uint32_t tick, Transport* link) {
+    wire_broadcast(enc, live, tick, udp_sink, link);
+    transport_flush(link);
+}
+
+/**
+ * @brief ID 구간 [lo, hi) 표적 목록 출력 (예: 편대 4000~4999 → RANGE 4000 5000)
+ */
+void report_id_range(BTreeNode* root, int lo, int hi) {
+    BTreeCursor cur;
+    btree_cursor_range(&cur, root, lo, hi);
+    TacticalTrack* track;
+    int count = 0;
+    printf("\n[RANGE] Tracks in [%d, %d):\n", lo, hi);
+    while ((track = btree_cursor_next(&cur)) != NULL) {
+        printf("  #%04d | Threat: %2d | %s\n", track->track_id, track->threat_level,
+               track->status == TRACK_STATUS_ACTIVE ? "ACTIVE" : "DESTROYED");
+        count++;
+    }
+    printf("[RANGE] %d track(s).\nT-MAP> ", count);
+}
+
+/**
+ * @brief 실시간 모드에서 시나리오 스크립트를 불러와 지금 시각부터 투입되도록 예약
+ * @param now_ns 시나리오 시계의 현재 시각 (스크립트의 0초 = 지금)
+ */
+bool queue_live_scenario(EventQueue* q, const char* path, uint64_t now_ns) {
+    size_t before = q->count;
+    uint64_t end_ns = 0;
+    bool ok = scenario_load(path, q, now_ns, &end_ns);     // 틀린 줄은 건너뛰고 나머지는 예약
+    if (q->count == before) return false;
+    printf("[SCENARIO] '%s': %zu events queued over the next %.1f s%s.\n", path, q->count - before,
+           (end_ns - now_ns) / 1e9, ok ? "" : " (malformed lines skipped)");
+    return ok;
+}
+
+/* =================================================================
+   Real-Time Loop Handlers (이벤트 루프가 깨운 출처별 처리)
+================================================================= */
+
+/**
+ * @brief 실시간 루프 상태 (명령/콘솔/틱 처리 함수가 공유)
+ */
+typedef struct ServerLoop {
+    TmapEngine*     engine;
+    Transport*      link;
+    WireEncoder*    wire;
+    TickScheduler*  scheduler;
+    EventLoop*      events;
+    CommandBatch    commands;           // 이번에 깨어났을 때 받은 지휘 명령
+    EventQueue      scenario;           // 실시간 시나리오 투입 대기열
+    uint64_t        scenario_origin;    // 시나리오 시계의 0초 (틱 루프 시작 시각)
+    uint32_t        sim_tick;           // 시뮬레이션 틱 번호 (난수 카운터)
+    char            cmd_buf[256];       // 콘솔 입력 중인 줄
+    int             ptr;
+} ServerLoop;
+
+/**
+ * @brief 명령 소켓 처리: 쌓인 지휘 명령을 모두 받아 정렬·중복 제거 후 한 번에 반영
+ */
+static void handle_c2(ServerLoop* s) {
+    transport_drain(s->link, command_ingest_datagram, &s->commands);
+    CommandTally t = command_batch_apply(s->engine, &s->commands, (int)time(NULL));
+    size_t applied = t.kills + t.adds + t.threats;
+    if (applied == 0) return;
+    if (applied == 1 && t.duplicates == 0 && t.rejected == 0) {
+        if (t.last_type == C2_CMD_KILL) {
+            printf("\n[C2 LINK] Target #%04d Destroyed by Client Command!\nT-MAP> ", t.last_id);
+        } else if (t.last_type == C2_CMD_ADD) {
+            printf("\n[C2 LINK] Target #%04d Deployed by Client Command.\nT-MAP> ", t.last_id);
+        } else {
+            TacticalTrack* track = track_index_get(&s->engine->index, t.last_id);
+            printf("\n[C2 LINK] Target #%04d Threat set to %d by Client Command.\nT-MAP> ", t.last_id,
+                   track != NULL ? track->threat_level : 0);
         }
+        return;
     }
-    if (!node->is_leaf) return kill_target(node->children[node->num_keys], target_id);
-    return false;
-}
-
-void simulate_flight(BTreeNode* node) {
-    if (node == NULL) return;
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) simulate_flight(node->children[i]);
-        TacticalTrack* track = node->tracks[i];
-        
-        if (track != NULL && track->status == 1 && track->history_tail != NULL) {
-            int safe_id = track->track_id % MAX_ID_BUFFER;
-            double base_s_lat = ((track->track_id % 5) - 2) * 0.00008;
-            double base_s_lon = ((track->track_id % 7) - 3) * 0.00008;
-            if (base_s_lat == 0 && base_s_lon == 0) { base_s_lat = 0.00006; base_s_lon = 0.00006; }
-
-            // --------------------------------------------------------------
-            // [신규] 1. 사인(Sine) 파동을 이용한 부드러운 가속/감속 엔진
-            // 시간이 지남에 따라 속도가 원래 속도의 0.5배 ~ 1.5배 사이로 변동합니다.
-            // --------------------------------------------------------------
-            double speed_modifier = 5.5 + 4.5 * sin(track->history_count * 0.275);
-            
-            // --------------------------------------------------------------
-            // [신규] 2. 난기류 및 회피 기동 (미세한 좌표 흔들림)
-            // 매 프레임마다 무작위로 미세하게 경로가 틀어집니다.
-            // --------------------------------------------------------------
-            double noise_lat = ((rand() % 100) / 100.0 - 0.5) * 0.00025;
-            double noise_lon = ((rand() % 100) / 100.0 - 0.5) * 0.00025;
-
-            // 최종 이동량 계산 (기본속도 * 변속기어 * 방향) + 노이즈
-            double move_lat = (base_s_lat * speed_modifier) * dir_lat[safe_id] + noise_lat;
-            double move_lon = (base_s_lon * speed_modifier) * dir_lon[safe_id] + noise_lon;
-
-            double next_lat = track->history_tail->lat + move_lat;
-            double next_lon = track->history_tail->lon + move_lon;
-
-            // 바운싱(화면 이탈 방지) 로직
-            if (next_lat > MAX_LAT || next_lat < MIN_LAT) dir_lat[safe_id] *= -1;
-            if (next_lon > MAX_LON || next_lon < MIN_LON) dir_lon[safe_id] *= -1;
-
-            // 새 좌표 기록
-            add_history_node(track, track->history_tail->lat + move_lat, 
-                                    track->history_tail->lon + move_lon, 0);
+    printf("\n[C2 LINK] Command batch: %zu destroyed, %zu deployed, %zu re-rated | %zu duplicate, %zu rejected\nT-MAP> ",
+           t.kills, t.adds, t.threats, t.duplicates, t.rejected);
+}
+
+/**
+ * @brief 콘솔 명령 한 줄 실행
+ */
+static void console_execute(ServerLoop* s, const char* cmd_buf) {
+    TmapEngine* engine = s->engine;
+    int id, threat, lo, hi;
+    char path[200];
+    if (sscanf(cmd_buf, "RANGE %d %d", &lo, &hi) == 2) {
+        report_id_range(engine->root, lo, hi);
+    } else if (sscanf(cmd_buf, "THREAT %d", &threat) == 1) {
+        printf("\n[THREAT] Active tracks with threat >= %d:\n", threat);
+        scan_high_threat(&engine->threats, threat);
+        printf("T-MAP> ");
+    } else if (strcmp(cmd_buf, "TICK") == 0) {
+        printf("\n");
+        tick_scheduler_report(s->scheduler);
+        printf("T-MAP> ");
+    } else if (strcmp(cmd_buf, "LOD") == 0) {
+        printf("\n");
+        lod_report(&engine->live, &engine->lod);
+        printf("T-MAP> ");
+    } else if (strcmp(cmd_buf, "MEM") == 0) {
+        printf("\n");
+        tmap_arena_report(&engine->arena);
+        printf("T-MAP> ");
+    } else if (strcmp(cmd_buf, "TOP") == 0) {
+        TacticalTrack* t = threat_index_top(&engine->threats);
+        if (t == NULL) printf("\n[TOP] No active tracks.\nT-MAP> ");
+        else printf("\n[TOP] Highest threat: Target #%04d (Threat: %d)\nT-MAP> ", t->track_id, t->threat_level);
+    } else if (sscanf(cmd_buf, "SEARCH %d", &id) == 1) {
+        TacticalTrack* t = track_index_get(&engine->index, id);
+        if (t == NULL) printf("\n[SEARCH] Target #%04d not found.\nT-MAP> ", id);
+        else printf("\n[SEARCH] Target #%04d | Threat: %d | %s | %d waypoints\nT-MAP> ", id, t->threat_level,
+                    t->status == TRACK_STATUS_ACTIVE ? "ACTIVE" : "DESTROYED", t->history_count);
+    } else if (sscanf(cmd_buf, "ADD %d %d", &id, &threat) == 2) {
+        TacticalTrack* t = track_index_get(&engine->index, id);
+        if (t != NULL && t->status == TRACK_STATUS_ACTIVE) {
+            printf("\n[SYSTEM] Target #%04d already tracked. Ignored.\nT-MAP> ", id);
+        } else if (deploy_target(engine, id, threat, HQ_LAT, HQ_LON, (int)time(NULL))) {
+            printf("\n[SYSTEM] Target #%04d Deployed (Threat: %d).\nT-MAP> ", id, threat);
         }
+    } else if (sscanf(cmd_buf, "SCENARIO %199s", path) == 1) {
+        printf("\n");
+        queue_live_scenario(&s->scenario, path, tmap_now_ns() - s->scenario_origin);
+        printf("T-MAP> ");
+    } else if (strcmp(cmd_buf, "EXIT") == 0) {
+        engine->running = false;
+    }
+}
+
+/**
+ * @brief 콘솔 입력 문자 하나 처리 (Enter에서 명령 실행)
+ * @param echo true면 직접 화면에 되찍음 (_getch는 에코가 없고, Linux 터미널은 줄 단위로 스스로 에코)
+ */
+static void console_feed(ServerLoop* s, char ch, bool echo) {
+    if (ch == '\r' || ch == '\n') {
+        s->cmd_buf[s->ptr] = '\0';
+        if (s->ptr > 0) console_execute(s, s->cmd_buf);
+        s->ptr = 0; memset(s->cmd_buf, 0, sizeof(s->cmd_buf));
+    } else if (ch == '\b' && s->ptr > 0) {
+        s->ptr--;
+        if (echo) printf("\b \b");
+    } else if (s->ptr < 254) {
+        s->cmd_buf[s->ptr++] = ch;
+        if (echo) printf("%c", ch);
+    }
+}
+
+/**
+ * @brief 콘솔 출처 처리: 지금 읽을 수 있는 입력을 모두 소비
+ */
+static void handle_console(ServerLoop* s) {
+#ifdef _WIN32
+    while (_kbhit()) console_feed(s, (char)_getch(), true);
+#else
+    char buf[256];
+    ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+    if (n <= 0) {
+        // EOF: 계속 읽기 가능으로 보이므로 감시를 끊음 (서버는 명령 소켓과 틱으로 계속 동작)
+        event_loop_unwatch(s->events, EVENT_SOURCE_CONSOLE, STDIN_FILENO);
+        printf("\n[SYSTEM] Console input closed. Engine keeps running on the C2 link.\n");
+        return;
+    }
+    for (ssize_t i = 0; i < n; i++) console_feed(s, buf[i], false);
+#endif
+}
+
+/**
+ * @brief 틱 마감 처리: 시나리오 반영 → 비행 시뮬레이션 → 송출 → 묘비 정리, 다음 마감 예약
+ */
+static void run_tick(ServerLoop* s) {
+    TmapEngine* engine = s->engine;
+    TickScheduler* scheduler = s->scheduler;
+    uint32_t steps = tick_scheduler_begin(scheduler);
+
+    // 시각이 된 시나리오 투입/요격 반영 (틱 시작 전, 행 추가/삭제는 여기서만)
+    if (s->scenario.count > 0) {
+        scenario_apply_due(engine, &s->scenario, tmap_now_ns() - s->scenario_origin, (int)time(NULL));
+        if (s->scenario.count == 0) printf("\n[SCENARIO] All scripted events delivered. Active tracks: %zu\nT-MAP> ", engine->live.count);
+    }
+
+    // 마감을 놓쳤으면 (따라잡기 정책) 밀린 틱을 연달아 실행
+    for (uint32_t step = 0; step < steps; step++) {
+        simulate_flight(engine, s->sim_tick++, (int)time(NULL));
     }
-    if (!node->is_leaf) simulate_flight(node->children[node->num_keys]);
+    // 서버의 최신 데이터를 9090 포트로 쏩니다.
+    broadcast_live_tracks(s->wire, &engine->live, s->sim_tick, s->link);
+
+    // 남는 틱 시간에 묘비 표적을 예산만큼 물리 삭제 (이미 마감을 넘겼으면 건너뜀: 예산 0은 "전부 처리"라서)
+    uint64_t budget = tick_scheduler_remaining_ns(scheduler);
+    if (budget > 0) compact_tombstones(engine, budget < COMPACT_BUDGET_NS ? budget : COMPACT_BUDGET_NS);
+    tick_scheduler_end(scheduler);
+    event_loop_arm(s->events, scheduler->next_deadline);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // 벤치마크 모드: tmap_engine.exe --bench <name>
+    if (argc >= 3 && strcmp(argv[1], "--bench") == 0) {
+        return run_benchmark(argv[2]);
+    }
+
     printf("====================================================\n");
     printf("  T-MAP COMMAND CENTER CORE ENGINE [v10.0 FINAL]\n");
     printf("====================================================\n");
 
-    for(int i = 0; i < MAX_ID_BUFFER; i++) { dir_lat[i] = 1; dir_lon[i] = 1; }
-    load_system_state(&btree_root);
+    // 궤적 보존 정책: --retain-points N, --retain-secs T, --cold-store <file>, --compress-history
+    // 병렬 틱: --threads N (기본 1 = 직렬), 재현용 난수 씨앗: --seed S
+    // 틱 주기: --tick-hz N (1~100), 마감 초과 시 정책: --tick-policy catchup|skip
+    // 다중 주기 시뮬레이션: --lod, 단계별 예산: --lod-budget A,B,C
+    // 가상 시계 고속 실행: --headless <script> [--sim-secs S] (콘솔/네트워크/저장 파일 없이 시나리오만 실행)
+    // 몬테카를로 일괄 실행: --monte-carlo <script> [--runs N] (씨앗만 다른 독립 인스턴스 N개, --threads = 동시 인스턴스 수)
+    // 실시간 모드 시나리오 투입: --scenario <script> (실행 중에는 콘솔 SCENARIO <script>)
+    // 송출 방식: --wire delta|framed|per-track (기본 delta = 양자화 + 키프레임 대비 차분 프레임)
+    // 실시간 루프: --event-loop epoll|poll (기본 epoll = 명령 도착 즉시 처리, poll = 틱마다 확인하는 예전 방식)
+    TmapEngine engine;
+    WorkerPool sim_workers;
+    engine_init(&engine, TMAP_RNG_DEFAULT_SEED);
 
-    WSADATA wsa; WSAStartup(MAKEWORD(2, 2), &wsa);
-    SOCKET server_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    FILE* cold_fp = NULL;
+    const char* headless_script = NULL;
+    const char* monte_carlo_script = NULL;
+    const char* live_script = NULL;
+    int monte_carlo_runs = 100;
+    double sim_secs = 0.0;
+    int sim_threads = 0;            // 0 = 기본값 (실시간/헤드리스는 직렬, 몬테카를로는 전체 코어)
+    int tick_hz = TICK_RATE_HZ;
+    TickPolicy tick_policy = TICK_POLICY_CATCH_UP;
+    WireMode wire_mode = WIRE_MODE_DELTA;
+    bool poll_loop = false;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = (i + 1 < argc);
+        if (has_value && strcmp(argv[i], "--threads") == 0) {
+            sim_threads = atoi(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--tick-hz") == 0) {
+            tick_hz = atoi(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--tick-policy") == 0) {
+            tick_policy = strcmp(argv[++i], "skip") == 0 ? TICK_POLICY_SKIP : TICK_POLICY_CATCH_UP;
+        } else if (strcmp(argv[i], "--lod") == 0) {
+            engine.lod.enabled = true;
+        } else if (has_value && strcmp(argv[i], "--lod-budget") == 0) {
+            // 단계 0, 1, 2의 최대 표적 수 (쉼표 구분, 0 = 무제한). 마지막 단계는 항상 무제한
+            unsigned long long budget[LOD_TIERS - 1] = { 0 };
+            sscanf(argv[++i], "%llu,%llu,%llu", &budget[0], &budget[1], &budget[2]);
+            for (int t = 0; t < LOD_TIERS - 1; t++) engine.lod.budget[t] = (size_t)budget[t];
+            engine.lod.enabled = true;
+        } else if (has_value && strcmp(argv[i], "--headless") == 0) {
+            headless_script = argv[++i];
+        } else if (has_value && strcmp(argv[i], "--monte-carlo") == 0) {
+            monte_carlo_script = argv[++i];
+        } else if (has_value && strcmp(argv[i], "--scenario") == 0) {
+            live_script = argv[++i];
+        } else if (has_value && strcmp(argv[i], "--wire") == 0) {
+            if (!wire_parse_mode(argv[++i], &wire_mode)) printf("[WARN] Unknown wire mode '%s'. Using delta.\n", argv[i]);
+        } else if (has_value && strcmp(argv[i], "--event-loop") == 0) {
+            poll_loop = strcmp(argv[++i], "poll") == 0;
+        } else if (has_value && strcmp(argv[i], "--runs") == 0) {
+            monte_carlo_runs = atoi(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--sim-secs") == 0) {
+            sim_secs = atof(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--seed") == 0) {
+            engine.seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--compress-history") == 0) {
+            engine.retention.compress = true;
+        } else if (has_value && strcmp(argv[i], "--retain-points") == 0) {
+            engine.retention.max_points = atoi(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--retain-secs") == 0) {
+            engine.retention.max_age = atoi(argv[++i]);
+        } else if (has_value && strcmp(argv[i], "--cold-store") == 0) {
+            if (cold_fp != NULL) fclose(cold_fp);
+            cold_fp = fopen(argv[++i], "ab");
+            if (cold_fp == NULL) printf("[ERROR] Cannot open cold store '%s'. Dropping expired waypoints.\n", argv[i]);
+        } else {
+            printf("[WARN] Unknown option '%s' ignored.\n", argv[i]);
+        }
+    }
+    if (cold_fp != NULL) {
+        engine.retention.cold_sink = cold_storage_sink;
+        engine.retention.cold_ctx = cold_fp;
+    }
+    if (engine.retention.max_points > 0 || engine.retention.max_age > 0) {
+        printf("[SYSTEM] History retention: %d points / %d s per track (expired -> %s)\n",
+               engine.retention.max_points, engine.retention.max_age, cold_fp != NULL ? "cold store" : "dropped");
+    }
+    if (engine.retention.compress) printf("[SYSTEM] Sealed trajectory blocks are stored compressed.\n");
+    if (engine.lod.enabled) {
+        printf("[SYSTEM] Multi-rate simulation: far low-threat tracks update every 2/4/8 ticks (tier budgets %zu/%zu/%zu, 0 = unlimited).\n",
+               engine.lod.budget[0], engine.lod.budget[1], engine.lod.budget[2]);
+    }
+    printf("[SYSTEM] Simulation seed: 0x%llx | kinematics kernel: %s\n",
+           (unsigned long long)engine.seed, kinematics_select(NULL));
 
-    // [수정] 서버는 자신의 수신 포트인 8080(SERVER_PORT)을 열고 기다립니다.
-    struct sockaddr_in server_addr;
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(SERVER_PORT);
-    server_addr.sin_addr.s_addr = INADDR_ANY; 
-    bind(server_socket, (struct sockaddr*)&server_addr, sizeof(server_addr));
+    if (monte_carlo_script != NULL) {
+        // 인스턴스마다 자기 엔진을 만들므로 이 엔진과 작업자 풀은 쓰지 않음
+        MonteCarloConfig config = { monte_carlo_script, monte_carlo_runs, sim_threads, tick_hz, sim_secs,
+                                    engine.seed, engine.lod, engine.retention };
+        int rc = run_monte_carlo(&config);
+        engine_free(&engine);
+        if (cold_fp != NULL) fclose(cold_fp);
+        return rc;
+    }
 
-    u_long mode = 1; ioctlsocket(server_socket, FIONBIO, &mode);
+    worker_pool_init(&sim_workers, sim_threads);
+    if (sim_workers.thread_count > 1) printf("[SYSTEM] Flight simulation runs on %d threads.\n", sim_workers.thread_count);
+    engine.workers = &sim_workers;
 
-    // [수정] 서버가 데이터를 쏠 목적지는 클라이언트의 9090(CLIENT_PORT) 입니다.
-    struct sockaddr_in client_dest;
-    client_dest.sin_family = AF_INET;
-    client_dest.sin_port = htons(CLIENT_PORT);
-    client_dest.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (headless_script != NULL) {
+        int rc = run_headless(&engine, headless_script, tick_hz, sim_secs);
+        worker_pool_free(&sim_workers);
+        engine_free(&engine);
+        if (cold_fp != NULL) fclose(cold_fp);
+        return rc;
+    }
 
-    char cmd_buf[256]; int ptr = 0; memset(cmd_buf, 0, 256);
-    printf("\nT-MAP> ");
+    load_system_state(&engine);
 
-    while (server_running) {
-        int target_to_kill;
-        struct sockaddr_in from; int flen = sizeof(from);
-        if (recvfrom(server_socket, (char*)&target_to_kill, sizeof(int), 0, (struct sockaddr*)&from, &flen) > 0) {
-            if (kill_target(btree_root, target_to_kill)) {
-                printf("\n[C2 LINK] Target #%04d Destroyed by Client Command!\nT-MAP> ", target_to_kill);
-            }
-        }
+    // 서버는 자신의 수신 포트인 8080(SERVER_PORT)을 열고, 클라이언트의 9090(CLIENT_PORT)으로 송출합니다.
+    transport_startup();
+    Transport link;
+    if (!transport_open(&link, NULL, SERVER_PORT)) {
+        printf("[FATAL ERROR] Cannot open UDP port %d (already in use?). Shutting down.\n", SERVER_PORT);
+        worker_pool_free(&sim_workers);
+        engine_free(&engine);
+        if (cold_fp != NULL) fclose(cold_fp);
+        transport_cleanup();
+        return 1;
+    }
+    transport_set_peer(&link, "127.0.0.1", CLIENT_PORT);
+    int rcvbuf = 1024 * 1024;       // 여러 콘솔의 명령이 한꺼번에 몰려도 커널이 버리지 않도록 수신 버퍼를 키움
+    setsockopt(link.sock, SOL_SOCKET, SO_RCVBUF, (const char*)&rcvbuf, sizeof(rcvbuf));
+
+    WireEncoder wire;
+    wire_encoder_init(&wire, wire_mode);
+    printf("[SYSTEM] Broadcast: %s via %s\n", wire_mode == WIRE_MODE_DELTA ? "v2 quantized delta frames" :
+           wire_mode == WIRE_MODE_FRAMED ? "v1 MTU-batched frames" : "one datagram per track", transport_backend(&link));
 
-        while (_kbhit()) {
-            char ch = _getch();
-            if (ch == '\r') {
-                cmd_buf[ptr] = '\0';
-                int id, threat;
-                if (sscanf(cmd_buf, "ADD %d %d", &id, &threat) == 2) {
-                    TacticalTrack* nt = create_track(id, threat);
-                    add_history_node(nt, BASE_LAT, BASE_LON, 0);
-                    insert_track(&btree_root, nt);
-                    printf("\n[SYSTEM] Target #%04d Deployed (Threat: %d).\nT-MAP> ", id, threat);
-                } else if (strcmp(cmd_buf, "EXIT") == 0) {
-                    server_running = false;
-                }
-                ptr = 0; memset(cmd_buf, 0, 256);
-            } else if (ch == '\b' && ptr > 0) { 
-                ptr--; printf("\b \b"); 
-            } else if (ptr < 254) { 
-                cmd_buf[ptr++] = ch; printf("%c", ch); 
+    TickScheduler scheduler;
+    tick_scheduler_init(&scheduler, tick_hz, tick_policy);     // 첫 마감 = 지금 (로드 시간은 지연으로 치지 않음)
+    printf("[SYSTEM] Tick rate: %.0f Hz (%s on overrun)\n", 1e9 / (double)scheduler.period_ns,
+           tick_policy == TICK_POLICY_CATCH_UP ? "catch-up" : "skip");
+
+    EventLoop events;
+    if (!event_loop_init(&events, poll_loop)) printf("[WARN] epoll/timerfd unavailable. Using sleep-and-poll loop.\n");
+    event_loop_watch(&events, EVENT_SOURCE_C2, (intptr_t)link.sock);
+#ifdef _WIN32
+    event_loop_watch(&events, EVENT_SOURCE_CONSOLE, 0);        // 매 틱 _kbhit 확인
+#else
+    if (!event_loop_watch(&events, EVENT_SOURCE_CONSOLE, STDIN_FILENO)) {
+        printf("[WARN] Console input cannot be watched (stdin is not a terminal or pipe). Console disabled.\n");
+    }
+#endif
+    printf("[SYSTEM] Event loop: %s (%s)\n", event_loop_backend(&events),
+           events.polled ? "commands checked once per tick" : "commands dispatched on arrival");
+
+    ServerLoop server;
+    memset(&server, 0, sizeof(server));
+    server.engine = &engine;
+    server.link = &link;
+    server.wire = &wire;
+    server.scheduler = &scheduler;
+    server.events = &events;
+    // 시나리오 시계: 0초 = 틱 루프 시작
+    server.scenario_origin = tmap_now_ns();
+    if (live_script != NULL) queue_live_scenario(&server.scenario, live_script, 0);
+    printf("\nT-MAP> ");
+
+    event_loop_arm(&events, scheduler.next_deadline);
+    while (engine.running) {
+        // 명령은 도착하는 대로, 틱은 절대 마감 시각에 (처리 시간과 무관하게 주기 고정)
+        EventSource ready[EVENT_SOURCE_COUNT];
+        int count = event_loop_wait(&events, ready);
+        for (int i = 0; i < count && engine.running; i++) {
+            switch (ready[i]) {
+            case EVENT_SOURCE_C2:
+                handle_c2(&server);
+                break;
+            case EVENT_SOURCE_CONSOLE:
+                handle_console(&server);
+                break;
+            case EVENT_SOURCE_TICK:
+                run_tick(&server);
+                break;
+            default:
+                break;
             }
         }
-
-        simulate_flight(btree_root);
-        // 서버의 최신 데이터를 9090 포트로 쏩니다.
-        broadcast_btree(btree_root, server_socket, &client_dest);
-        
-        Sleep(TICK_RATE_MS);
     }
 
-    printf("\n[SYSTEM] Saving session to 'tmap_data.dat'...\n");
+    worker_pool_free(&sim_workers);
+    event_queue_free(&server.scenario);
+    wire_encoder_free(&wire);
+    printf("\n");
+    tick_scheduler_report(&scheduler);
+    printf("[SYSTEM] Broadcast: %llu datagrams, %.1f MB sent in %llu send calls (%s).\n", (unsigned long long)wire.datagrams,
+           wire.bytes / (1024.0 * 1024.0), (unsigned long long)link.send_calls, transport_backend(&link));
+    printf("[SYSTEM] Event loop (%s): %llu wake-ups | C2 %llu | console %llu | tick %llu\n", event_loop_backend(&events),
+           (unsigned long long)events.wakeups, (unsigned long long)events.dispatched[EVENT_SOURCE_C2],
+           (unsigned long long)events.dispatched[EVENT_SOURCE_CONSOLE], (unsigned long long)events.dispatched[EVENT_SOURCE_TICK]);
+    printf("[SYSTEM] C2 commands: %llu received in %llu batches (largest %zu) | %llu malformed datagrams dropped\n",
+           (unsigned long long)server.commands.received, (unsigned long long)server.commands.batches,
+           server.commands.largest, (unsigned long long)server.commands.malformed);
+    command_batch_free(&server.commands);
+    event_loop_free(&events);
+    printf("[SYSTEM] Saving session to 'tmap_data.dat'...\n");
     FILE* save_fp = fopen("tmap_data.dat", "wb");
-    if (save_fp != NULL) { save_node_to_binary(btree_root, save_fp); fclose(save_fp); }
-    printf("[SYSTEM] Emptying B-Tree (Post-order GC)...\n");
-    free_system_postorder(btree_root);
-    closesocket(server_socket); WSACleanup();
+    if (save_fp != NULL) { save_node_to_binary(engine.root, save_fp); fclose(save_fp); }
+    tmap_arena_report(&engine.arena);
+    printf("[SYSTEM] Emptying B-Tree (Slab Arena Release)...\n");
+    engine_free(&engine);
+    if (cold_fp != NULL) fclose(cold_fp);
+    transport_close(&link);
+    transport_cleanup();
     printf("[SYSTEM] Engine Offline. Goodbye.\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,383 @@
+/**
+ * @file    montecarlo.c
+ * @brief   Parallel Monte Carlo Scenario Runner
+ * @details 같은 헤드리스 시나리오를 씨앗만 바꾼 독립 엔진 인스턴스 수백 개로 돌려 결과 분포를 냅니다.
+ *          인스턴스마다 자기 B-Tree, 인덱스, 실시간 표적 테이블, 슬랩 풀을 가지므로 공유 상태가 없고,
+ *          작업자 풀이 인스턴스 단위로 코어에 나눠 줍니다 (인스턴스 안의 틱은 직렬).
+ *
+ *          교전 모델 (틱마다, 비행 시뮬레이션 직후):
+ *            - HQ 반경 MC_HQ_RADIUS 안에 들어온 표적은 "HQ 도달"로 집계하고 제거
+ *            - 교전 반경 MC_ENGAGE_RADIUS 안의 표적은 틱마다 MC_KILL_CHANCE 확률로 요격
+ *          요격 소요 시간(time-to-intercept)은 투입부터 요격(교전 또는 스크립트 KILL)까지의 가상 시간입니다.
+ */
+
+#include "common.h"
+#include "clock.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+#define MC_HQ_RADIUS        0.005           // HQ 도달 판정 반경 [도] (약 500 m)
+#define MC_ENGAGE_RADIUS    0.03            // 방공 교전 반경 [도] (약 3 km)
+#define MC_KILL_CHANCE      0.01            // 교전 반경 안에서 틱당 요격 확률
+#define MC_ENGAGE_SALT      0xE4A6E3E5ull   // 교전 난수열을 비행 난기류 난수열과 분리
+#define MC_TTI_BIN_SECS     10              // 요격 소요 시간 히스토그램 구간 폭 [초]
+#define MC_TTI_BINS         361             // 0 ~ 3600 s + 마지막 구간은 1시간 이상
+#define MC_DEFAULT_POINTS   600             // 보존 정책 미지정 시 표적당 궤적 상한 (동시 인스턴스 메모리 제한)
+
+extern void engine_init(TmapEngine* engine, uint64_t seed);
+extern void engine_free(TmapEngine* engine);
+extern bool kill_target(TmapEngine* engine, int target_id);
+extern bool scenario_load(const char* path, EventQueue* q, uint64_t offset_ns, uint64_t* end_ns);
+extern uint64_t headless_schedule(EventQueue* q, uint64_t script_end_ns, double sim_secs, bool broadcast);
+extern uint64_t headless_execute(TmapEngine* engine, EventQueue* queue, uint64_t period_ns, HeadlessStats* stats,
+                                 SimEventHook hook, void* hook_ctx, bool verbose);
+extern void event_queue_free(EventQueue* q);
+extern bool worker_pool_init(WorkerPool* pool, int thread_count);
+extern void worker_pool_free(WorkerPool* pool);
+extern void worker_pool_run(WorkerPool* pool, size_t total, size_t chunk, WorkerTask task, void* ctx);
+
+/**
+ * @brief 인스턴스 하나의 결과
+ */
+typedef struct {
+    uint64_t    seed;
+    uint32_t    reached_hq;         // HQ 반경에 들어온 표적 수
+    uint32_t    engaged;            // 교전 모델이 요격한 표적 수
+    uint32_t    scripted_kills;     // 스크립트 KILL로 요격된 표적 수
+    uint32_t    survivors;          // 종료 시 남은 표적 수
+    uint64_t    tti_total_ns;       // 요격 소요 시간 합계
+    uint32_t    tti_hist[MC_TTI_BINS];
+    bool        ok;
+} MonteCarloRun;
+
+/**
+ * @brief 모든 인스턴스가 읽기 전용으로 공유하는 일괄 실행 문맥
+ */
+typedef struct {
+    const MonteCarloConfig* config;
+    const EventQueue*       script;         // 틱/종료 예약까지 마친 원본 큐 (인스턴스마다 복사)
+    const int*              ids;            // 스크립트에 나오는 표적 ID (정렬, 중복 없음)
+    size_t                  id_count;
+    uint64_t                period_ns;
+    MonteCarloRun*          runs;
+} MonteCarloBatch;
+
+/**
+ * @brief 인스턴스 하나의 교전 판정 상태 (관찰 함수 문맥)
+ */
+typedef struct {
+    const MonteCarloBatch*  batch;
+    MonteCarloRun*          run;
+    uint64_t*               add_time_ns;    // ids와 같은 순서의 투입 시각
+    int*                    doomed;         // 이번 틱에 제거할 ID (행 스캔 중에는 테이블을 바꾸지 않음)
+    bool*                   doomed_hit;     // true = 요격, false = HQ 도달
+    size_t                  doomed_cap;
+    uint32_t                tick;
+} MonteCarloProbe;
+
+static int mc_compare_ids(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static size_t mc_id_slot(const MonteCarloBatch* batch, int id) {
+    size_t lo = 0, hi = batch->id_count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (batch->ids[mid] < id) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static int mc_core_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+/* =================================================================
+   [1] Engagement Model
+================================================================= */
+
+static void mc_record_intercept(MonteCarloProbe* probe, int id, uint64_t now_ns) {
+    uint64_t tti = now_ns - probe->add_time_ns[mc_id_slot(probe->batch, id)];
+    uint64_t bin = tti / (MC_TTI_BIN_SECS * 1000000000ull);
+    probe->run->tti_total_ns += tti;
+    probe->run->tti_hist[bin < MC_TTI_BINS - 1 ? bin : MC_TTI_BINS - 1]++;
+}
+
+/**
+ * @brief 이벤트 관찰 함수: 투입 시각 기록, 스크립트 요격 집계, 틱마다 HQ 도달/교전 판정
+ * @note  교전 난수는 (씨앗, 표적 ID, 틱 번호)로만 정하므로 행 순서와 무관하게 재현됩니다.
+ */
+static void mc_observe(TmapEngine* engine, const SimEvent* ev, bool applied, void* ctx) {
+    MonteCarloProbe* probe = (MonteCarloProbe*)ctx;
+    if (ev->type == SIM_EVENT_ADD) {
+        if (applied) probe->add_time_ns[mc_id_slot(probe->batch, ev->track_id)] = ev->time_ns;
+        return;
+    }
+    if (ev->type == SIM_EVENT_KILL) {
+        if (applied) {
+            probe->run->scripted_kills++;
+            mc_record_intercept(probe, ev->track_id, ev->time_ns);
+        }
+        return;
+    }
+    if (ev->type != SIM_EVENT_TICK) return;
+
+    const LiveTable* live = &engine->live;
+    const uint64_t kill_threshold = (uint64_t)(MC_KILL_CHANCE * 18446744073709551616.0);
+    size_t doomed = 0;
+    uint32_t tick = probe->tick++;
+    for (size_t i = 0; i < live->count; i++) {
+        double d_lat = live->lat[i] - HQ_LAT;
+        double d_lon = (live->lon[i] - HQ_LON) * LON_SCALE;
+        double dist2 = d_lat * d_lat + d_lon * d_lon;
+        if (dist2 >= MC_ENGAGE_RADIUS * MC_ENGAGE_RADIUS) continue;
+
+        bool reached = dist2 < MC_HQ_RADIUS * MC_HQ_RADIUS;
+        if (!reached && tmap_rng_at(engine->seed ^ MC_ENGAGE_SALT, live->id[i], tick) >= kill_threshold) continue;
+
+        if (doomed == probe->doomed_cap) {
+            size_t cap = probe->doomed_cap ? probe->doomed_cap * 2 : 64;
+            int* ids = (int*)realloc(probe->doomed, sizeof(int) * cap);
+            if (ids == NULL) break;
+            probe->doomed = ids;
+            bool* hits = (bool*)realloc(probe->doomed_hit, sizeof(bool) * cap);
+            if (hits == NULL) break;
+            probe->doomed_hit = hits;
+            probe->doomed_cap = cap;
+        }
+        probe->doomed[doomed] = live->id[i];
+        probe->doomed_hit[doomed] = !reached;
+        doomed++;
+    }
+
+    // 행 스캔이 끝난 뒤 제거 (제거는 마지막 행을 빈자리로 옮기므로 스캔 중에는 못 함)
+    for (size_t k = 0; k < doomed; k++) {
+        if (!kill_target(engine, probe->doomed[k])) continue;
+        if (probe->doomed_hit[k]) {
+            probe->run->engaged++;
+            mc_record_intercept(probe, probe->doomed[k], ev->time_ns);
+        } else {
+            probe->run->reached_hq++;
+        }
+    }
+}
+
+/* =================================================================
+   [2] Instance Execution
+================================================================= */
+
+/**
+ * @brief 인스턴스 하나를 새 엔진에서 끝까지 실행
+ */
+static void mc_run_instance(const MonteCarloBatch* batch, size_t index) {
+    const MonteCarloConfig* config = batch->config;
+    MonteCarloRun* run = &batch->runs[index];
+    run->seed = tmap_rng_mix(config->base_seed + index);
+
+    TmapEngine engine;
+    engine_init(&engine, run->seed);
+    engine.lod = config->lod;
+    engine.retention = config->retention;
+    engine.retention.cold_sink = NULL;
+    engine.retention.cold_ctx = NULL;
+    if (engine.retention.max_points <= 0 && engine.retention.max_age <= 0) engine.retention.max_points = MC_DEFAULT_POINTS;
+
+    EventQueue queue = *batch->script;
+    queue.heap = (SimEvent*)malloc(sizeof(SimEvent) * (batch->script->capacity ? batch->script->capacity : 1));
+    MonteCarloProbe probe = { batch, run, NULL, NULL, NULL, 0, 0 };
+    probe.add_time_ns = (uint64_t*)calloc(batch->id_count ? batch->id_count : 1, sizeof(uint64_t));
+    if (queue.heap == NULL || probe.add_time_ns == NULL) {
+        printf("[ERROR] Memory allocation failed for Monte Carlo run %zu.\n", index);
+    } else {
+        memcpy(queue.heap, batch->script->heap, sizeof(SimEvent) * batch->script->count);
+        HeadlessStats stats = { 0 };
+        headless_execute(&engine, &queue, batch->period_ns, &stats, mc_observe, &probe, false);
+        run->survivors = (uint32_t)engine.live.count;
+        run->ok = true;
+    }
+
+    free(probe.add_time_ns);
+    free(probe.doomed);
+    free(probe.doomed_hit);
+    event_queue_free(&queue);
+    engine_free(&engine);
+}
+
+static void mc_run_range(void* ctx, size_t begin, size_t end) {
+    const MonteCarloBatch* batch = (const MonteCarloBatch*)ctx;
+    for (size_t i = begin; i < end; i++) mc_run_instance(batch, i);
+}
+
+/* =================================================================
+   [3] Aggregation
+================================================================= */
+
+// 히스토그램에서 q 분위가 속한 구간의 상한 [초]
+static int mc_tti_percentile(const uint64_t* hist, uint64_t total, double q) {
+    uint64_t target = (uint64_t)ceil(q * (double)total);
+    uint64_t seen = 0;
+    for (int b = 0; b < MC_TTI_BINS; b++) {
+        seen += hist[b];
+        if (seen >= target && seen > 0) return (b + 1) * MC_TTI_BIN_SECS;
+    }
+    return MC_TTI_BINS * MC_TTI_BIN_SECS;
+}
+
+/**
+ * @brief 인스턴스 결과를 실행 번호 순으로 합쳐 출력 (스레드 수와 무관하게 같은 출력)
+ */
+static void mc_report(const MonteCarloBatch* batch, double wall) {
+    const MonteCarloConfig* config = batch->config;
+    uint64_t hist[MC_TTI_BINS] = { 0 };
+    uint64_t intercepts = 0, tti_total_ns = 0, engaged = 0, scripted = 0, survivors = 0;
+    double reached_sum = 0.0, reached_sq = 0.0;
+    uint32_t reached_min = UINT32_MAX, reached_max = 0;
+    int completed = 0;
+
+    for (int i = 0; i < config->runs; i++) {
+        const MonteCarloRun* run = &batch->runs[i];
+        if (!run->ok) continue;
+        completed++;
+        reached_sum += run->reached_hq;
+        reached_sq += (double)run->reached_hq * run->reached_hq;
+        if (run->reached_hq < reached_min) reached_min = run->reached_hq;
+        if (run->reached_hq > reached_max) reached_max = run->reached_hq;
+        engaged += run->engaged;
+        scripted += run->scripted_kills;
+        survivors += run->survivors;
+        tti_total_ns += run->tti_total_ns;
+        for (int b = 0; b < MC_TTI_BINS; b++) {
+            hist[b] += run->tti_hist[b];
+            intercepts += run->tti_hist[b];
+        }
+    }
+    if (completed == 0) {
+        printf("[MONTE CARLO] No run completed.\n");
+        return;
+    }
+
+    double mean = reached_sum / completed;
+    double var = reached_sq / completed - mean * mean;
+    printf("[MONTE CARLO] %d/%d runs in %.3f wall s (%.1f runs per wall s)\n",
+           completed, config->runs, wall, wall > 0.0 ? completed / wall : 0.0);
+    printf("[MONTE CARLO] Reached HQ per run: mean %.2f | std %.2f | min %u | max %u\n",
+           mean, var > 0.0 ? sqrt(var) : 0.0, reached_min, reached_max);
+    printf("[MONTE CARLO] Intercepts per run: engaged %.2f | scripted %.2f | survivors at end %.2f\n",
+           (double)engaged / completed, (double)scripted / completed, (double)survivors / completed);
+    if (intercepts == 0) {
+        printf("[MONTE CARLO] No intercepts recorded.\n");
+        return;
+    }
+    printf("[MONTE CARLO] Time to intercept: mean %.1f s | p50 <= %d s | p90 <= %d s | p99 <= %d s (%llu intercepts)\n",
+           tti_total_ns / 1e9 / (double)intercepts, mc_tti_percentile(hist, intercepts, 0.50),
+           mc_tti_percentile(hist, intercepts, 0.90), mc_tti_percentile(hist, intercepts, 0.99),
+           (unsigned long long)intercepts);
+
+    // 1분 단위로 묶어 출력 (10분 이상은 한 줄)
+    printf("  %-14s | %10s | %6s\n", "time to kill", "intercepts", "share");
+    const int per_row = 60 / MC_TTI_BIN_SECS;
+    for (int row = 0; row <= 10; row++) {
+        int first = row * per_row;
+        int last = row < 10 ? first + per_row : MC_TTI_BINS;
+        uint64_t count = 0;
+        for (int b = first; b < last; b++) count += hist[b];
+        char label[24];
+        if (row < 10) snprintf(label, sizeof(label), "%d - %d min", row, row + 1);
+        else snprintf(label, sizeof(label), ">= 10 min");
+        printf("  %-14s | %10llu | %5.1f%%\n", label, (unsigned long long)count, 100.0 * count / intercepts);
+    }
+}
+
+/* =================================================================
+   [4] Entry Point
+================================================================= */
+
+/**
+ * @brief 시나리오를 씨앗만 다른 인스턴스 config->runs개로 병렬 실행하고 분포를 출력
+ * @return 0 = 완료, 1 = 스크립트/설정 오류
+ * @note  인스턴스 i의 씨앗은 mix(base_seed + i)이고 결과는 실행 번호 순으로 합치므로,
+ *        동시 인스턴스 수(config->threads)와 무관하게 출력이 같습니다.
+ */
+int run_monte_carlo(const MonteCarloConfig* config) {
+    if (config->runs < 1) {
+        printf("[ERROR] --runs must be at least 1.\n");
+        return 1;
+    }
+    EventQueue script = { 0 };
+    uint64_t end_ns = 0;
+    if (!scenario_load(config->script, &script, 0, &end_ns)) {
+        event_queue_free(&script);
+        return 1;
+    }
+    end_ns = headless_schedule(&script, end_ns, config->sim_secs, false);
+    if (end_ns == 0) {
+        printf("[ERROR] Scenario '%s' has no events and no --sim-secs.\n", config->script);
+        event_queue_free(&script);
+        return 1;
+    }
+
+    // 투입 시각 표를 인스턴스마다 배열로 두기 위한 ID 목록
+    int* ids = (int*)malloc(sizeof(int) * (script.count ? script.count : 1));
+    MonteCarloRun* runs = (MonteCarloRun*)calloc((size_t)config->runs, sizeof(MonteCarloRun));
+    if (ids == NULL || runs == NULL) {
+        printf("[FATAL ERROR] Memory allocation failed for Monte Carlo batch.\n");
+        free(ids);
+        free(runs);
+        event_queue_free(&script);
+        return 1;
+    }
+    size_t id_count = 0;
+    for (size_t i = 0; i < script.count; i++) {
+        if (script.heap[i].type == SIM_EVENT_ADD) ids[id_count++] = script.heap[i].track_id;
+    }
+    qsort(ids, id_count, sizeof(int), mc_compare_ids);
+    size_t unique = 0;
+    for (size_t i = 0; i < id_count; i++) {
+        if (unique == 0 || ids[unique - 1] != ids[i]) ids[unique++] = ids[i];
+    }
+
+    int tick_hz = config->tick_hz < 1 ? 1 : config->tick_hz;
+    int threads = config->threads > 0 ? config->threads : mc_core_count();
+    if (threads > config->runs) threads = config->runs;
+    MonteCarloBatch batch = { config, &script, ids, unique, 1000000000ull / (uint64_t)tick_hz, runs };
+
+    printf("[MONTE CARLO] Scenario '%s': %d runs x %.1f simulated s at %d Hz on %d thread(s).\n",
+           config->script, config->runs, end_ns / 1e9, tick_hz, threads);
+    printf("[MONTE CARLO] Engagement: HQ radius %.3f deg | engage radius %.3f deg | kill chance %.1f%% per tick\n",
+           MC_HQ_RADIUS, MC_ENGAGE_RADIUS, MC_KILL_CHANCE * 100.0);
+
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    WorkerPool pool;
+    worker_pool_init(&pool, threads);
+    uint64_t wall_start = tmap_now_ns();
+    worker_pool_run(&pool, (size_t)config->runs, 1, mc_run_range, &batch);
+    double wall = (tmap_now_ns() - wall_start) / 1e9;
+    worker_pool_free(&pool);
+    tmap_log_waypoints = log_waypoints;
+
+    mc_report(&batch, wall);
+
+    free(ids);
+    free(runs);
+    event_queue_free(&script);
+    return 0;
+}
@@ -1,9 +1,80 @@
 #include<stdio.h>
+#include <string.h>
 #include "common.h"
+#include "clock.h"
 
-extern TacticalTrack* create_track(int track_id, int threat_level);
+extern TacticalTrack* create_track_quiet(TmapEngine* engine, int track_id, int threat_level);
 extern void add_history_node(TacticalTrack* track, double lat, double lon, int timestamp);
-extern void insert_track(BTreeNode** root, TacticalTrack* track);
+extern void free_track(TacticalTrack* track);
+extern int history_block_unpack(const HistoryBlock* block, HistoryPoint* out);
+extern BTreeNode* btree_bulk_load(TrackArena* arena, TacticalTrack* const* tracks, size_t n);
+extern void btree_cursor_first(BTreeCursor* cur, BTreeNode* root);
+extern TacticalTrack* btree_cursor_next(BTreeCursor* cur);
+extern void live_table_sync_motion(const LiveTable* table, TacticalTrack* track);
+
+// 파일 속 궤적 레코드 1개 크기: lat(double) + lon(double) + timestamp(int), 패딩 없음
+#define HISTORY_RECORD_BYTES (2 * sizeof(double) + sizeof(int))
+
+// 파일 속 기동 상태 레코드 크기: vel_lat, vel_lon, turn(double) + phase(uint32) + dir_lat, dir_lon(int8)
+#define MOTION_RECORD_BYTES (3 * sizeof(double) + sizeof(uint32_t) + 2 * sizeof(int8_t))
+
+// 저장 파일 머리말: 매직 "TMAP" + 형식 버전 (버전 1 = 머리말 없는 초기 형식, 기동 상태 없음)
+#define SAVE_MAGIC   "TMAP"
+#define SAVE_VERSION 2
+
+// 궤적 점 배열을 파일 레코드 형식(패딩 없는 20바이트)으로 변환
+static void pack_history_records(unsigned char* out, const HistoryPoint* points, int count) {
+    for (int i = 0; i < count; i++) {
+        memcpy(out, &points[i].lat, sizeof(double)); out += sizeof(double);
+        memcpy(out, &points[i].lon, sizeof(double)); out += sizeof(double);
+        memcpy(out, &points[i].timestamp, sizeof(int)); out += sizeof(int);
+    }
+}
+
+// 기동 상태를 파일 레코드 형식(패딩 없는 30바이트)으로 변환
+static void pack_motion_record(unsigned char* out, const TrackMotion* m) {
+    memcpy(out, &m->vel_lat, sizeof(double)); out += sizeof(double);
+    memcpy(out, &m->vel_lon, sizeof(double)); out += sizeof(double);
+    memcpy(out, &m->turn, sizeof(double)); out += sizeof(double);
+    memcpy(out, &m->phase, sizeof(uint32_t)); out += sizeof(uint32_t);
+    memcpy(out, &m->dir_lat, sizeof(int8_t)); out += sizeof(int8_t);
+    memcpy(out, &m->dir_lon, sizeof(int8_t));
+}
+
+static void unpack_motion_record(TrackMotion* m, const unsigned char* in) {
+    memcpy(&m->vel_lat, in, sizeof(double)); in += sizeof(double);
+    memcpy(&m->vel_lon, in, sizeof(double)); in += sizeof(double);
+    memcpy(&m->turn, in, sizeof(double)); in += sizeof(double);
+    memcpy(&m->phase, in, sizeof(uint32_t)); in += sizeof(uint32_t);
+    memcpy(&m->dir_lat, in, sizeof(int8_t)); in += sizeof(int8_t);
+    memcpy(&m->dir_lon, in, sizeof(int8_t));
+}
+
+/**
+ * @brief 저장 파일 머리말 기록 (표적 레코드보다 먼저 한 번)
+ */
+void write_save_header(FILE* fp) {
+    uint32_t version = SAVE_VERSION;
+    fwrite(SAVE_MAGIC, 1, 4, fp);
+    fwrite(&version, sizeof(version), 1, fp);
+}
+
+/**
+ * @brief 저장 파일 머리말을 읽어 형식 버전 판별
+ * @return 형식 버전. 머리말이 없으면 초기 형식(1)으로 보고 파일 처음으로 되돌립니다.
+ * @note  초기 형식 파일이 우연히 "TMAP" + 2로 시작하려면 첫 표적의 ID가 0x50414D54이고
+ *        위협도가 2여야 하므로, 실제 저장 파일에서는 구분이 모호해지지 않습니다.
+ */
+static uint32_t read_save_header(FILE* fp) {
+    char magic[4];
+    uint32_t version;
+    if (fread(magic, 1, 4, fp) == 4 && memcmp(magic, SAVE_MAGIC, 4) == 0 &&
+        fread(&version, sizeof(version), 1, fp) == 1 && version >= 2) {
+        return version;
+    }
+    rewind(fp);
+    return 1;
+}
 
 void save_single_track(TacticalTrack* track, FILE* fp) {
     if (track == NULL) return;
@@ -15,28 +86,53 @@ void save_single_track(TacticalTrack* track, FILE* fp) {
     fwrite(&track->status, sizeof(int), 1, fp);
     fwrite(&track->history_count, sizeof(int), 1, fp);
 
-    // 2. 표적의 궤적(Linked List) 순회 및 저장
-    HistoryNode* current = track->history_head;
-    while (current != NULL) {
-        // 좌표와 시간 데이터만 쏙 빼서 저장
-        fwrite(&current->lat, sizeof(double), 1, fp);
-        fwrite(&current->lon, sizeof(double), 1, fp);
-        fwrite(&current->timestamp, sizeof(int), 1, fp);
-        current = current->next;
+    // 2. 기동 상태 (비행 중인 표적은 실시간 표적 테이블의 최신 값을 먼저 가져옴)
+    unsigned char motion[MOTION_RECORD_BYTES];
+    live_table_sync_motion(&track->engine->live, track);
+    pack_motion_record(motion, &track->motion);
+    fwrite(motion, MOTION_RECORD_BYTES, 1, fp);
+
+    // 3. 궤적 블록 단위 저장: 블록의 연속 배열을 파일 레코드 형식으로 한 번에 옮겨 담고
+    //    fwrite 한 번으로 내보냄 (점마다 fwrite 3회 → 블록마다 1회)
+    //    압축 블록은 블록 전체를 먼저 복원한 뒤 같은 경로로 내보냄
+    unsigned char buf[HISTORY_BLOCK_POINTS * HISTORY_RECORD_BYTES];
+    HistoryPoint unpacked[HISTORY_BLOCK_POINTS];
+    for (const HistoryBlock* block = track->history_head; block != NULL; block = block->next) {
+        const HistoryPoint* points = block->points;
+        if (block->encoded != 0) {
+            history_block_unpack(block, unpacked);
+            points = unpacked;
+        }
+        pack_history_records(buf, points + block->start, block->count - block->start);
+        fwrite(buf, HISTORY_RECORD_BYTES, (size_t)(block->count - block->start), fp);
     }
 }
 
-// B-Tree를 재귀적으로 돌면서 모든 표적을 찾아 저장하는 함수
-void traverse_and_save(BTreeNode* node, FILE* fp) {
-    if (node == NULL) return;
+/**
+ * @brief 보존 정책으로 잘려 나간 궤적 블록을 콜드 스토리지 파일 끝에 덧붙이는 HistoryColdSink
+ * @param ctx 추가 모드("ab")로 연 FILE*
+ * @note  레코드 형식: track_id(int) + 점 개수(int) + 궤적 레코드 × 점 개수 (저장 파일과 같은 점 형식)
+ */
+void cold_storage_sink(const TacticalTrack* track, const HistoryPoint* points, int count, void* ctx) {
+    FILE* fp = (FILE*)ctx;
+    unsigned char buf[HISTORY_BLOCK_POINTS * HISTORY_RECORD_BYTES];
+    fwrite(&track->track_id, sizeof(int), 1, fp);
+    fwrite(&count, sizeof(int), 1, fp);
+    for (int done = 0; done < count; done += HISTORY_BLOCK_POINTS) {
+        int n = count - done < HISTORY_BLOCK_POINTS ? count - done : HISTORY_BLOCK_POINTS;
+        pack_history_records(buf, points + done, n);
+        fwrite(buf, HISTORY_RECORD_BYTES, (size_t)n, fp);
+    }
+}
 
-    // 1. 현재 노드의 표적들 저장
-    for (int i = 0; i < node->num_keys; i++) {
-        if (!node->is_leaf) traverse_and_save(node->children[i], fp); // 왼쪽 자식 먼저
-        save_single_track(node->tracks[i], fp);
+// B+Tree 단말 연결 리스트를 따라 모든 표적을 ID 순서대로 저장하는 함수
+void traverse_and_save(BTreeNode* node, FILE* fp) {
+    BTreeCursor cur;
+    btree_cursor_first(&cur, node);
+    TacticalTrack* track;
+    while ((track = btree_cursor_next(&cur)) != NULL) {
+        save_single_track(track, fp);
     }
-    // 2. 마지막 자식 저장
-    if (!node->is_leaf) traverse_and_save(node->children[node->num_keys], fp);
 }
 
 // [메인 저장 함수] 외부에서 호출하는 함수
@@ -48,6 +144,7 @@ void SaveSystem(BTreeNode* root) {
     }
 
     printf("[SYSTEM] Saving data to 'tmap_data.dat'...\n");
+    write_save_header(fp);
     if (root != NULL) {
         traverse_and_save(root, fp);
     }
@@ -61,46 +158,124 @@ void SaveSystem(BTreeNode* root) {
    - 파일의 데이터를 읽어 다시 malloc으로 메모리에 재구축
 ================================================================= */
 
-void LoadSystem(BTreeNode** root) {
-    FILE* fp = fopen("tmap_data.dat", "rb"); // Binary Read 모드
-    if (fp == NULL) {
-        printf("[SYSTEM] No previous data found. Starting fresh.\n");
-        return;
-    }
-
-    printf("[SYSTEM] Loading data from 'tmap_data.dat'...\n");
+static int compare_track_id(const void* a, const void* b) {
+    int x = (*(TacticalTrack* const*)a)->track_id;
+    int y = (*(TacticalTrack* const*)b)->track_id;
+    return (x > y) - (x < y);
+}
 
-    int id, threat, status, count;
-    int loaded_tracks = 0;
+/**
+ * @brief 저장 파일의 모든 표적 레코드를 읽어 ID 오름차순 배열로 반환
+ * @param engine    표적을 복원할 엔진 인스턴스 (아레나와 실시간 표적 테이블)
+ * @param out_count 읽은 표적 수
+ * @return malloc된 표적 포인터 배열 (호출자가 free). 표적이 없으면 NULL
+ * @note  저장은 중위 순회 순서이므로 보통 이미 정렬되어 있어 검사만 O(N)으로 끝납니다.
+ *        정렬이 깨진 파일만 qsort하고, 중복 ID는 나중 레코드를 버립니다.
+ *        머리말 없는 초기 형식 파일은 기동 상태를 ID 기본값으로 채우고 위상만 궤적 길이로 이어 갑니다.
+ */
+TacticalTrack** load_track_records(TmapEngine* engine, FILE* fp, size_t* out_count) {
+    size_t count = 0, capacity = 1024;
+    TacticalTrack** tracks = (TacticalTrack**)malloc(sizeof(TacticalTrack*) * capacity);
+    bool sorted = true;
+    uint32_t version = read_save_header(fp);
+    if (version > SAVE_VERSION) {
+        printf("[ERROR] Save file format v%u is newer than this engine (v%d). Not loaded.\n",
+               (unsigned)version, SAVE_VERSION);
+        free(tracks);
+        *out_count = 0;
+        return NULL;
+    }
 
-    // 파일 끝(EOF)에 도달할 때까지 계속 읽음
-    while (fread(&id, sizeof(int), 1, fp) == 1) {
+    int id, threat, status, history;
+    while (tracks != NULL && fread(&id, sizeof(int), 1, fp) == 1) {
         // 1. 헤더 정보 읽기
-        fread(&threat, sizeof(int), 1, fp);
-        fread(&status, sizeof(int), 1, fp);
-        fread(&count, sizeof(int), 1, fp);
+        if (fread(&threat, sizeof(int), 1, fp) != 1 ||
+            fread(&status, sizeof(int), 1, fp) != 1 ||
+            fread(&history, sizeof(int), 1, fp) != 1) break;
 
         // 2. 표적 객체 메모리 할당 (복원)
-        TacticalTrack* new_track = create_track(id, threat);
-        new_track->status = status; // 저장된 상태(파괴됨/생존함) 복구
-
-        // 3. 궤적 데이터(History) 복원
-        for (int i = 0; i < count; i++) {
-            double lat, lon;
-            int time;
-            fread(&lat, sizeof(double), 1, fp);
-            fread(&lon, sizeof(double), 1, fp);
-            fread(&time, sizeof(int), 1, fp);
-            
-            // O(1) 꼬리 포인터를 이용해 궤적 재연결
-            add_history_node(new_track, lat, lon, time);
+        TacticalTrack* track = create_track_quiet(engine, id, threat);
+        if (track == NULL) break;
+        track->status = status; // 저장된 상태(파괴됨/생존함) 복구
+
+        // 기동 상태 복원 (첫 궤적 점이 들어가며 실시간 표적 테이블에 등록될 때 그대로 옮겨짐)
+        if (version >= 2) {
+            unsigned char motion[MOTION_RECORD_BYTES];
+            if (fread(motion, MOTION_RECORD_BYTES, 1, fp) != 1) { free_track(track); break; }
+            unpack_motion_record(&track->motion, motion);
+        } else {
+            track->motion.phase = (uint32_t)history;
         }
 
-        // 4. B-Tree에 삽입 (인덱싱 복구)
-        insert_track(root, new_track);
-        loaded_tracks++;
+        // 3. 궤적 데이터(History) 복원: 블록 크기만큼 한 번에 읽어 꼬리 블록에 이어 붙임
+        unsigned char buf[HISTORY_BLOCK_POINTS * HISTORY_RECORD_BYTES];
+        for (int done = 0; done < history; ) {
+            int want = history - done;
+            if (want > HISTORY_BLOCK_POINTS) want = HISTORY_BLOCK_POINTS;
+            int got = (int)fread(buf, HISTORY_RECORD_BYTES, (size_t)want, fp);
+            const unsigned char* in = buf;
+            for (int i = 0; i < got; i++) {
+                double lat, lon;
+                int time;
+                memcpy(&lat, in, sizeof(double)); in += sizeof(double);
+                memcpy(&lon, in, sizeof(double)); in += sizeof(double);
+                memcpy(&time, in, sizeof(int)); in += sizeof(int);
+                add_history_node(track, lat, lon, time);
+            }
+            if (got != want) break;
+            done += got;
+        }
+
+        if (count == capacity) {
+            capacity *= 2;
+            TacticalTrack** grown = (TacticalTrack**)realloc(tracks, sizeof(TacticalTrack*) * capacity);
+            if (grown == NULL) { free_track(track); break; }
+            tracks = grown;
+        }
+        if (count > 0 && tracks[count - 1]->track_id >= id) sorted = false;
+        tracks[count++] = track;
+    }
+
+    if (!sorted) {
+        qsort(tracks, count, sizeof(TacticalTrack*), compare_track_id);
+        size_t unique = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (unique > 0 && tracks[unique - 1]->track_id == tracks[i]->track_id) {
+                printf("[WARN] Duplicate Target ID %d in save file. Dropped.\n", tracks[i]->track_id);
+                free_track(tracks[i]);
+                continue;
+            }
+            tracks[unique++] = tracks[i];
+        }
+        count = unique;
     }
 
+    *out_count = count;
+    if (count == 0) {
+        free(tracks);
+        return NULL;
+    }
+    return tracks;
+}
+
+void LoadSystem(TmapEngine* engine, BTreeNode** root) {
+    FILE* fp = fopen("tmap_data.dat", "rb"); // Binary Read 모드
+    if (fp == NULL) {
+        printf("[SYSTEM] No previous data found. Starting fresh.\n");
+        return;
+    }
+
+    printf("[SYSTEM] Loading data from 'tmap_data.dat'...\n");
+    uint64_t started = tmap_now_ns();
+
+    size_t loaded_tracks = 0;
+    TacticalTrack** tracks = load_track_records(engine, fp, &loaded_tracks);
     fclose(fp);
-    printf("[SYSTEM] Load Complete. %d targets restored.\n", loaded_tracks);
+
+    // 4. B-Tree 인덱스 일괄 구축 (상향식 O(N))
+    *root = btree_bulk_load(&engine->arena, tracks, loaded_tracks);
+    free(tracks);
+
+    printf("[SYSTEM] Load Complete. %zu targets restored in %.1f ms.\n",
+           loaded_tracks, (tmap_now_ns() - started) / 1e6);
 }
\ No newline at end of file
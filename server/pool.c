@@ -0,0 +1,212 @@
+/**
+ * @file    pool.c
+ * @brief   Slab / Object Pool Allocator
+ * @details BTreeNode, TacticalTrack, HistoryBlock을 타입별 슬랩에서 꺼내 쓰는 할당기.
+ *          매 틱 표적마다 일어나던 malloc/free를 프리 리스트 push/pop으로 바꾸고,
+ *          궤적 전체 반환은 리스트 연결 한 번(O(1)), 엔진 종료는 슬랩 단위 일괄 해제로 끝냅니다.
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+    #include <malloc.h>     // _aligned_malloc / _aligned_free
+#endif
+
+#define POOL_SLAB_BYTES (64 * 1024)     // 슬랩 1개 크기
+
+// 압축 궤적 블록 크기 등급 풀 (n * HISTORY_PACKED_STEP 바이트)
+#define PACKED_POOL(n) OBJECT_POOL_INIT_SIZED("hist_pack", (n) * HISTORY_PACKED_STEP, \
+                                              sizeof(void*), offsetof(HistoryBlock, next))
+
+/**
+ * @brief 아레나 초기값 (풀 이름, 객체 크기, 정렬, 링크 위치). 엔진 인스턴스마다 복사해 씀
+ */
+static const TrackArena arena_template = {
+    OBJECT_POOL_INIT("btree_node", BTreeNode, CACHE_LINE_SIZE, 0),
+    OBJECT_POOL_INIT("track", TacticalTrack, sizeof(void*), 0),
+    OBJECT_POOL_INIT_SIZED("hist_head", HISTORY_BLOCK_BYTES(HISTORY_HEAD_POINTS),
+                           sizeof(void*), offsetof(HistoryBlock, next)),
+    OBJECT_POOL_INIT_SIZED("hist_block", HISTORY_BLOCK_BYTES(HISTORY_BLOCK_POINTS),
+                           sizeof(void*), offsetof(HistoryBlock, next)),
+    {
+        PACKED_POOL(1),  PACKED_POOL(2),  PACKED_POOL(3),  PACKED_POOL(4),
+        PACKED_POOL(5),  PACKED_POOL(6),  PACKED_POOL(7),  PACKED_POOL(8),
+        PACKED_POOL(9),  PACKED_POOL(10), PACKED_POOL(11), PACKED_POOL(12),
+        PACKED_POOL(13), PACKED_POOL(14), PACKED_POOL(15), PACKED_POOL(16),
+        PACKED_POOL(17), PACKED_POOL(18), PACKED_POOL(19), PACKED_POOL(20),
+        PACKED_POOL(21), PACKED_POOL(22), PACKED_POOL(23), PACKED_POOL(24),
+    },
+};
+
+/**
+ * @brief 빈 아레나 준비 (슬랩은 첫 할당 때 생김)
+ * @note  엔진 인스턴스마다 따로 두므로 인스턴스끼리는 풀 잠금도 공유하지 않습니다.
+ */
+void tmap_arena_init(TrackArena* arena) {
+    *arena = arena_template;
+    ObjectPool* pools[4] = { &arena->nodes, &arena->tracks, &arena->history_head, &arena->history };
+    for (int i = 0; i < 4; i++) pthread_mutex_init(&pools[i]->lock, NULL);
+    for (int i = 0; i < HISTORY_PACKED_CLASSES; i++) pthread_mutex_init(&arena->history_packed[i].lock, NULL);
+}
+
+/* =================================================================
+   [1] Slab Management
+================================================================= */
+
+static inline void** link_of(const ObjectPool* pool, void* obj) {
+    return (void**)((char*)obj + pool->link_offset);
+}
+
+static void* slab_alloc(size_t align, size_t bytes) {
+#ifdef _WIN32
+    return _aligned_malloc(bytes, align);
+#else
+    return aligned_alloc(align, POOL_ROUND_UP(bytes, align));
+#endif
+}
+
+static void slab_free(void* slab) {
+#ifdef _WIN32
+    _aligned_free(slab);
+#else
+    free(slab);
+#endif
+}
+
+/**
+ * @brief 새 슬랩을 할당하고 객체 단위로 잘라 프리 리스트에 연결
+ */
+static bool pool_grow(ObjectPool* pool) {
+    size_t header = POOL_ROUND_UP(sizeof(PoolSlab), pool->align);
+    size_t per_slab = (POOL_SLAB_BYTES - header) / pool->object_size;
+    if (per_slab == 0) per_slab = 1;
+
+    PoolSlab* slab = (PoolSlab*)slab_alloc(pool->align, header + per_slab * pool->object_size);
+    if (slab == NULL) {
+        printf("[FATAL ERROR] Slab allocation failed for pool '%s'.\n", pool->name);
+        return false;
+    }
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->slab_count++;
+    pool->capacity += per_slab;
+
+    // 주소 오름차순으로 꺼내 쓰도록 뒤에서부터 push (순차 할당 시 캐시 친화적)
+    char* base = (char*)slab + header;
+    for (size_t i = per_slab; i-- > 0; ) {
+        void* obj = base + i * pool->object_size;
+        *link_of(pool, obj) = pool->free_list;
+        pool->free_list = obj;
+    }
+    return true;
+}
+
+/* =================================================================
+   [2] Allocation API
+================================================================= */
+
+/**
+ * @brief 객체 1개 할당 [O(1)]
+ * @return 초기화되지 않은 객체 메모리 (실패 시 NULL)
+ */
+void* pool_alloc(ObjectPool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    if (pool->free_list == NULL && !pool_grow(pool)) {
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+    }
+    void* obj = pool->free_list;
+    pool->free_list = *link_of(pool, obj);
+    if (++pool->live > pool->peak) pool->peak = pool->live;
+    pthread_mutex_unlock(&pool->lock);
+    return obj;
+}
+
+/**
+ * @brief 객체 1개 반환 [O(1)]
+ */
+void pool_free(ObjectPool* pool, void* obj) {
+    if (obj == NULL) return;
+    pthread_mutex_lock(&pool->lock);
+    *link_of(pool, obj) = pool->free_list;
+    pool->free_list = obj;
+    pool->live--;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief 링크로 이어진 객체 사슬을 통째로 반환 [O(1)]
+ * @param head  사슬의 첫 객체
+ * @param tail  사슬의 마지막 객체 (link_offset 위치의 포인터로 head부터 이어져 있어야 함)
+ * @param count 사슬에 포함된 객체 수 (통계용)
+ */
+void pool_free_chain(ObjectPool* pool, void* head, void* tail, size_t count) {
+    if (head == NULL) return;
+    pthread_mutex_lock(&pool->lock);
+    *link_of(pool, tail) = pool->free_list;
+    pool->free_list = head;
+    pool->live -= count;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief 풀의 모든 슬랩을 한꺼번에 해제 (객체 단위 순회 없음)
+ * @note  풀에서 나간 모든 객체가 무효가 되므로 엔진 종료 시에만 사용합니다 (작업자 정지 후).
+ */
+void pool_release_all(ObjectPool* pool) {
+    PoolSlab* slab = pool->slabs;
+    while (slab != NULL) {
+        PoolSlab* next = slab->next;
+        slab_free(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->slab_count = 0;
+    pool->capacity = 0;
+    pool->live = 0;
+}
+
+/* =================================================================
+   [3] Statistics
+================================================================= */
+
+/**
+ * @brief 풀 점유율 통계 출력
+ */
+void pool_report(const ObjectPool* pool) {
+    double occupancy = pool->capacity ? 100.0 * (double)pool->live / (double)pool->capacity : 0.0;
+    printf("  %-10s | obj %4zu B | slabs %6zu | live %9zu / %9zu (%5.1f%%) | peak %9zu | %8.1f KiB\n",
+           pool->name, pool->object_size, pool->slab_count, pool->live, pool->capacity, occupancy,
+           pool->peak, (double)pool->slab_count * POOL_SLAB_BYTES / 1024.0);
+}
+
+/**
+ * @brief 엔진 아레나 전체 통계 출력
+ */
+void tmap_arena_report(const TrackArena* arena) {
+    printf("[MEMORY] Slab pool occupancy:\n");
+    pool_report(&arena->nodes);
+    pool_report(&arena->tracks);
+    pool_report(&arena->history_head);
+    pool_report(&arena->history);
+    for (int i = 0; i < HISTORY_PACKED_CLASSES; i++) {
+        if (arena->history_packed[i].slab_count > 0) pool_report(&arena->history_packed[i]);
+    }
+}
+
+/**
+ * @brief 엔진 아레나 일괄 해제 (B-Tree 노드, 표적, 궤적 전부)
+ * @note  풀 잠금도 해제하므로 다시 쓰려면 tmap_arena_init부터 호출합니다.
+ */
+void tmap_arena_release(TrackArena* arena) {
+    ObjectPool* pools[4 + HISTORY_PACKED_CLASSES] = { &arena->nodes, &arena->tracks, &arena->history_head, &arena->history };
+    for (int i = 0; i < HISTORY_PACKED_CLASSES; i++) pools[4 + i] = &arena->history_packed[i];
+    for (int i = 0; i < 4 + HISTORY_PACKED_CLASSES; i++) {
+        pool_release_all(pools[i]);
+        pthread_mutex_destroy(&pools[i]->lock);
+    }
+}
@@ -17,6 +17,7 @@
 typedef struct QuadNode {
     TargetRect boundary;                 // 현재 구역의 위치와 크기 (x, y, width, height)
     TacticalTrack* points[MAX_CAPACITY]; // 이 구역에 있는 드론들 포인터
+    Vector2 positions[MAX_CAPACITY];     // 드론들의 위치 (재분배 시 표적 본체를 다시 읽지 않도록 보관)
     int count;                           // 현재 저장된 드론 수
     
     // 자식 노드 4개 (북서, 북동, 남서, 남동)
@@ -51,18 +52,17 @@ void subdivide(QuadNode* node) {
 }
 
 // 3. 쿼드트리에 드론 위치 삽입 (Insert)
-bool insert_quad(QuadNode* node, TacticalTrack* track) {
-    if (track == NULL || track->history_tail == NULL) return false;
-
-    // 현재 드론의 위치
-    Vector2 point = { (float)track->history_tail->lon, (float)track->history_tail->lat };
+bool insert_quad(QuadNode* node, TacticalTrack* track, Vector2 point) {
+    if (track == NULL) return false;
 
     // 1. 내 구역 범위 밖이면 무시 (common.h에 정의된 함수 사용)
     if (!CheckCollisionPointRect(point, node->boundary)) return false;
 
     // 2. 자리가 남고, 아직 안 쪼개졌으면 -> 그냥 넣음
     if (node->count < MAX_CAPACITY && !node->divided) {
-        node->points[node->count++] = track;
+        node->points[node->count] = track;
+        node->positions[node->count] = point;
+        node->count++;
         return true;
     }
 
@@ -71,19 +71,19 @@ bool insert_quad(QuadNode* node, TacticalTrack* track) {
         subdivide(node);
         // 기존에 있던 애들도 자식들한테 이사 보냄 (Re-distribute)
         for (int i = 0; i < node->count; i++) {
-            insert_quad(node->nw, node->points[i]);
-            insert_quad(node->ne, node->points[i]);
-            insert_quad(node->sw, node->points[i]);
-            insert_quad(node->se, node->points[i]);
+            insert_quad(node->nw, node->points[i], node->positions[i]);
+            insert_quad(node->ne, node->points[i], node->positions[i]);
+            insert_quad(node->sw, node->points[i], node->positions[i]);
+            insert_quad(node->se, node->points[i], node->positions[i]);
         }
         node->count = 0; // 이사는 끝났으니 카운트 초기화
     }
 
     // 4. 자식들 중 맞는 구역에 넣음 (재귀)
-    return insert_quad(node->nw, track) ||
-           insert_quad(node->ne, track) ||
-           insert_quad(node->sw, track) ||
-           insert_quad(node->se, track);
+    return insert_quad(node->nw, track, point) ||
+           insert_quad(node->ne, track, point) ||
+           insert_quad(node->sw, track, point) ||
+           insert_quad(node->se, track, point);
 }
 
 // 4. 시각화 (서버용이므로 주석 처리 유지)
@@ -105,17 +105,10 @@ void FreeQuadtree(QuadNode* node) {
     free(node);
 }
 
-// 6. [헬퍼] B-Tree에 있는 모든 드론을 쿼드트리에 넣기
-void BuildQuadtreeFromBTree(BTreeNode* btree_node, QuadNode* quad_root) {
-    if (btree_node == NULL) return;
-
-    for (int i = 0; i < btree_node->num_keys; i++) {
-        if (!btree_node->is_leaf) BuildQuadtreeFromBTree(btree_node->children[i], quad_root);
-        
-        // 살아있는 드론만 쿼드트리에 등록
-        if (btree_node->tracks[i]->status == 1) { // 1: ACTIVE (보통 common.h에 정의됨)
-            insert_quad(quad_root, btree_node->tracks[i]);
-        }
+// 6. [헬퍼] 살아있는 모든 드론을 쿼드트리에 넣기 (실시간 표적 테이블의 위치 열을 순차 스캔)
+void BuildQuadtreeFromLiveTable(const LiveTable* live, QuadNode* quad_root) {
+    for (size_t i = 0; i < live->count; i++) {
+        Vector2 point = { (float)live->lon[i], (float)live->lat[i] };
+        insert_quad(quad_root, live->track[i], point);
     }
-    if (!btree_node->is_leaf) BuildQuadtreeFromBTree(btree_node->children[btree_node->num_keys], quad_root);
-}
\ No newline at end of file
+}
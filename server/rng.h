@@ -0,0 +1,36 @@
+/**
+ * @file    rng.h
+ * @brief   Counter-Based Random Numbers (SplitMix64)
+ * @details 내부 상태 없이 (씨앗, 표적 ID, 틱 번호)만으로 값을 계산하는 난수.
+ *          같은 입력이면 어느 스레드에서 어떤 순서로 부르든 같은 값이 나오므로,
+ *          병렬 틱에서도 표적별 궤적이 스레드 수나 테이블 행 순서와 무관하게 재현됩니다.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+#define TMAP_RNG_GOLDEN       0x9E3779B97F4A7C15ull    // SplitMix64 카운터 증분 (황금비)
+#define TMAP_RNG_DEFAULT_SEED 0x5EED7A4Dull            // --seed 미지정 시 씨앗
+
+/**
+ * @brief SplitMix64 최종 혼합 함수 (64비트 전단사 해시)
+ */
+static inline uint64_t tmap_rng_mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief 표적 하나의 난수열에서 counter번째 64비트 값
+ * @note  (seed, id)로 SplitMix64 스트림의 시작점을 정하고, 스트림을 counter칸 건너뛴 값을
+ *        순차 생성 없이 바로 계산합니다 [O(1)].
+ */
+static inline uint64_t tmap_rng_at(uint64_t seed, int32_t id, uint64_t counter) {
+    uint64_t key = tmap_rng_mix(seed + TMAP_RNG_GOLDEN * ((uint64_t)(uint32_t)id + 1));
+    return tmap_rng_mix(key + TMAP_RNG_GOLDEN * (counter + 1));
+}
+
+#endif // RNG_H
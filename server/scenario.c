@@ -0,0 +1,352 @@
+/**
+ * @file    scenario.c
+ * @brief   Scenario Scripts and Synthetic Load Generator
+ * @details 시나리오 스크립트를 읽어 가상 시각 순 이벤트(ADD/KILL/END)로 펼칩니다.
+ *          한 줄짜리 생성 지시문(WAVE/SWARM/FORMATION)은 읽는 순간 표적 수만큼의 ADD(와 KILL)로 펼쳐지므로
+ *          100만 대 부하도 몇 줄짜리 파일 하나로 재현됩니다. 생성 난수는 (표적 ID, 항목)으로만 정하므로
+ *          같은 파일은 엔진 씨앗과 무관하게 항상 같은 표적 집합을 만듭니다.
+ *
+ *          형식 (한 줄에 하나, '#' 이후는 주석, 시각은 시나리오 시작 기준 초):
+ *            <sec> ADD <id> <threat> [<lat> <lon>]                      표적 하나 투입 (위치 생략 시 HQ)
+ *            <sec> KILL <id>                                            표적 요격
+ *            <sec> END                                                  시나리오 종료 (없으면 마지막 이벤트 시각)
+ *            <sec> WAVE <first_id> <count> <N|E|S|W|ALL> [opt...]       비행 구역 가장자리에서 파상 투입
+ *            <sec> SWARM <first_id> <count> <lat> <lon> <radius> [opt...]  원(반경 [도]) 안에 무리 투입
+ *            <sec> FORMATION <first_id> <count> <lat> <lon> [opt...]    중심 기준 격자 편대 투입
+ *          생성 옵션 (key=value, 순서 무관):
+ *            rate=R        초당 투입 수 (기본 0 = 전부 <sec>에 동시 투입)
+ *            threat=SPEC   위협도 분포: "7" 고정, "1-10" 균등, "1-4@80,8-10@20" 가중 구간 (기본 1-10)
+ *            kill=A-B      투입 A ~ B초 뒤 요격 (기본: 요격 없음)
+ *            kill-pct=P    kill 대상 비율 [%] (기본 100)
+ *            spacing=D     FORMATION 간격 [도] (기본 0.002)
+ *            cols=C        FORMATION 한 줄 대수 (기본 ceil(sqrt(count)))
+ */
+
+#include "common.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// 가장자리 투입선 (비행 구역 경계에서 여유만큼 안쪽). 기본 투입 위치는 사령부 (HQ_LAT, HQ_LON)
+#define SCENARIO_EDGE_MARGIN    0.002                               // 경계 안쪽 여유 [도] (약 200 m)
+#define SCENARIO_EDGE_NORTH     (MAX_LAT - SCENARIO_EDGE_MARGIN)
+#define SCENARIO_EDGE_SOUTH     (MIN_LAT + SCENARIO_EDGE_MARGIN)
+#define SCENARIO_EDGE_WEST      (MIN_LON + SCENARIO_EDGE_MARGIN)
+#define SCENARIO_EDGE_EAST      (MAX_LON - SCENARIO_EDGE_MARGIN)
+#define SCENARIO_SEED           0x5CE7A410ull       // 생성 난수 씨앗 (엔진 씨앗과 분리)
+#define SCENARIO_THREAT_BANDS   8                   // threat= 가중 구간 최대 수
+#define SCENARIO_MAX_COUNT      10000000            // 지시문 하나가 만들 수 있는 최대 표적 수
+
+extern bool event_queue_push(EventQueue* q, const SimEvent* ev);
+extern bool event_queue_pop(EventQueue* q, SimEvent* out);
+extern bool deploy_target(TmapEngine* engine, int target_id, int threat_level, double lat, double lon, int timestamp);
+extern bool kill_target(TmapEngine* engine, int target_id);
+
+// 생성 난수 항목 (표적 하나에 항목마다 독립된 값)
+enum { GEN_POS_A, GEN_POS_B, GEN_THREAT, GEN_KILL_PICK, GEN_KILL_TIME };
+
+typedef enum { GEN_WAVE, GEN_SWARM, GEN_FORMATION } GenKind;
+
+typedef struct {
+    int         lo, hi, weight;
+} ThreatBand;
+
+/**
+ * @brief 생성 지시문 하나 (배치 모양 + 공통 옵션)
+ */
+typedef struct {
+    GenKind     kind;
+    int         first_id;
+    int         count;
+    char        edge;                   // WAVE: 'N', 'E', 'S', 'W', 'A'(ALL = 네 방향 번갈아)
+    double      lat, lon, radius;       // SWARM/FORMATION 중심, SWARM 반경 [도]
+    double      rate;                   // 초당 투입 수 (0 = 동시)
+    ThreatBand  bands[SCENARIO_THREAT_BANDS];
+    int         band_count;
+    int         weight_total;
+    double      kill_min, kill_max;     // 투입 후 요격까지 [초] (kill_max < 0 = 요격 없음)
+    double      kill_pct;
+    double      spacing;
+    int         cols;
+} GenSpec;
+
+// [0, 1) 균등 난수
+static double gen_unit(int id, int item) {
+    return (double)(tmap_rng_at(SCENARIO_SEED, id, (uint64_t)item) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* =================================================================
+   [1] Generator Options
+================================================================= */
+
+// "1-4@80,8-10@20" / "1-10" / "7"
+static bool parse_threat_spec(const char* spec, GenSpec* gen) {
+    gen->band_count = 0;
+    gen->weight_total = 0;
+    while (*spec != '\0') {
+        if (gen->band_count == SCENARIO_THREAT_BANDS) return false;
+        ThreatBand* band = &gen->bands[gen->band_count];
+        int used = 0;
+        if (sscanf(spec, "%d%n", &band->lo, &used) != 1) return false;
+        spec += used;
+        band->hi = band->lo;
+        if (*spec == '-') {
+            if (sscanf(spec + 1, "%d%n", &band->hi, &used) != 1) return false;
+            spec += 1 + used;
+        }
+        band->weight = 1;
+        if (*spec == '@') {
+            if (sscanf(spec + 1, "%d%n", &band->weight, &used) != 1) return false;
+            spec += 1 + used;
+        }
+        if (band->hi < band->lo || band->weight <= 0) return false;
+        gen->weight_total += band->weight;
+        gen->band_count++;
+        if (*spec == ',') spec++;
+        else if (*spec != '\0') return false;
+    }
+    return gen->band_count > 0;
+}
+
+static bool parse_gen_options(const char* args, GenSpec* gen) {
+    gen->rate = 0.0;
+    gen->bands[0] = (ThreatBand){ 1, 10, 1 };
+    gen->band_count = 1;
+    gen->weight_total = 1;
+    gen->kill_min = gen->kill_max = -1.0;
+    gen->kill_pct = 100.0;
+    gen->spacing = 0.002;
+    gen->cols = 0;
+
+    char token[96];
+    int used = 0;
+    while (sscanf(args, " %95s%n", token, &used) == 1) {
+        args += used;
+        char* value = strchr(token, '=');
+        if (value == NULL) return false;
+        *value++ = '\0';
+        bool ok;
+        if (strcmp(token, "rate") == 0) ok = sscanf(value, "%lf", &gen->rate) == 1 && gen->rate >= 0.0;
+        else if (strcmp(token, "threat") == 0) ok = parse_threat_spec(value, gen);
+        else if (strcmp(token, "kill") == 0) ok = sscanf(value, "%lf-%lf", &gen->kill_min, &gen->kill_max) == 2 &&
+                                                  gen->kill_min >= 0.0 && gen->kill_max >= gen->kill_min;
+        else if (strcmp(token, "kill-pct") == 0) ok = sscanf(value, "%lf", &gen->kill_pct) == 1;
+        else if (strcmp(token, "spacing") == 0) ok = sscanf(value, "%lf", &gen->spacing) == 1 && gen->spacing > 0.0;
+        else if (strcmp(token, "cols") == 0) ok = sscanf(value, "%d", &gen->cols) == 1 && gen->cols > 0;
+        else ok = false;
+        if (!ok) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 생성 지시문의 모양 인자와 옵션을 읽음
+ * @return 인자가 빠졌거나 옵션이 틀리면 false
+ */
+static bool parse_generator(const char* cmd, const char* args, GenSpec* gen) {
+    int used = 0;
+    char edge[8];
+    if (strcmp(cmd, "WAVE") == 0) {
+        gen->kind = GEN_WAVE;
+        if (sscanf(args, "%d %d %7s%n", &gen->first_id, &gen->count, edge, &used) != 3) return false;
+        if (strcmp(edge, "ALL") == 0) gen->edge = 'A';
+        else if (strlen(edge) == 1 && strchr("NESW", edge[0]) != NULL) gen->edge = edge[0];
+        else return false;
+    } else if (strcmp(cmd, "SWARM") == 0) {
+        gen->kind = GEN_SWARM;
+        if (sscanf(args, "%d %d %lf %lf %lf%n", &gen->first_id, &gen->count, &gen->lat, &gen->lon,
+                   &gen->radius, &used) != 5 || gen->radius < 0.0) return false;
+    } else if (strcmp(cmd, "FORMATION") == 0) {
+        gen->kind = GEN_FORMATION;
+        if (sscanf(args, "%d %d %lf %lf%n", &gen->first_id, &gen->count, &gen->lat, &gen->lon, &used) != 4) return false;
+    } else {
+        return false;
+    }
+    if (gen->count < 1 || gen->count > SCENARIO_MAX_COUNT) return false;
+    if (gen->first_id > INT32_MAX - (gen->count - 1)) return false;     // ID 범위 넘침
+    return parse_gen_options(args + used, gen);
+}
+
+/* =================================================================
+   [2] Expansion
+================================================================= */
+
+// 가중 구간을 고른 뒤 구간 안에서 균등 (난수 하나를 두 단계에 나눠 씀)
+static int gen_threat(const GenSpec* gen, int id) {
+    double u = gen_unit(id, GEN_THREAT) * gen->weight_total;
+    for (int b = 0; b < gen->band_count; b++) {
+        const ThreatBand* band = &gen->bands[b];
+        if (u < band->weight || b == gen->band_count - 1) {
+            int span = band->hi - band->lo + 1;
+            int pick = (int)(u / band->weight * span);
+            return band->lo + (pick < span ? pick : span - 1);
+        }
+        u -= band->weight;
+    }
+    return gen->bands[0].lo;
+}
+
+static void gen_position(const GenSpec* gen, int i, int id, double* lat, double* lon) {
+    double a = gen_unit(id, GEN_POS_A);
+    switch (gen->kind) {
+    case GEN_WAVE: {
+        char edge = gen->edge == 'A' ? "NESW"[i % 4] : gen->edge;
+        double along_lat = SCENARIO_EDGE_SOUTH + a * (SCENARIO_EDGE_NORTH - SCENARIO_EDGE_SOUTH);
+        double along_lon = SCENARIO_EDGE_WEST + a * (SCENARIO_EDGE_EAST - SCENARIO_EDGE_WEST);
+        if (edge == 'N')      { *lat = SCENARIO_EDGE_NORTH; *lon = along_lon; }
+        else if (edge == 'S') { *lat = SCENARIO_EDGE_SOUTH; *lon = along_lon; }
+        else if (edge == 'E') { *lat = along_lat; *lon = SCENARIO_EDGE_EAST; }
+        else                  { *lat = along_lat; *lon = SCENARIO_EDGE_WEST; }
+        break;
+    }
+    case GEN_SWARM: {
+        // 원 안 균등 분포: 반경은 sqrt로 보정
+        double r = gen->radius * sqrt(a);
+        double theta = 6.283185307179586 * gen_unit(id, GEN_POS_B);
+        *lat = gen->lat + r * cos(theta);
+        *lon = gen->lon + r * sin(theta) / LON_SCALE;
+        break;
+    }
+    case GEN_FORMATION: {
+        int cols = gen->cols > 0 ? gen->cols : (int)ceil(sqrt((double)gen->count));
+        int rows = (gen->count + cols - 1) / cols;
+        *lat = gen->lat + (i / cols - (rows - 1) / 2.0) * gen->spacing;
+        *lon = gen->lon + (i % cols - (cols - 1) / 2.0) * gen->spacing / LON_SCALE;
+        break;
+    }
+    }
+}
+
+/**
+ * @brief 생성 지시문을 표적마다 ADD(와 선택적으로 KILL) 이벤트로 펼쳐 큐에 예약
+ * @param start_ns 첫 투입 시각
+ * @param last_ns  예약한 가장 늦은 이벤트 시각 (갱신)
+ */
+static bool expand_generator(const GenSpec* gen, uint64_t start_ns, EventQueue* q, uint64_t* last_ns) {
+    for (int i = 0; i < gen->count; i++) {
+        int id = gen->first_id + i;
+        SimEvent ev = { 0 };
+        ev.type = SIM_EVENT_ADD;
+        ev.time_ns = start_ns + (gen->rate > 0.0 ? (uint64_t)llround(i * 1e9 / gen->rate) : 0);
+        ev.track_id = id;
+        ev.threat = gen_threat(gen, id);
+        gen_position(gen, i, id, &ev.lat, &ev.lon);
+        if (!event_queue_push(q, &ev)) return false;
+        if (ev.time_ns > *last_ns) *last_ns = ev.time_ns;
+
+        if (gen->kill_max < 0.0 || gen_unit(id, GEN_KILL_PICK) * 100.0 >= gen->kill_pct) continue;
+        double delay = gen->kill_min + gen_unit(id, GEN_KILL_TIME) * (gen->kill_max - gen->kill_min);
+        SimEvent kill = { 0 };
+        kill.type = SIM_EVENT_KILL;
+        kill.time_ns = ev.time_ns + (uint64_t)llround(delay * 1e9);
+        kill.track_id = id;
+        if (!event_queue_push(q, &kill)) return false;
+        if (kill.time_ns > *last_ns) *last_ns = kill.time_ns;
+    }
+    return true;
+}
+
+/* =================================================================
+   [3] Script Loading
+================================================================= */
+
+/**
+ * @brief 스크립트 파일을 읽어 이벤트를 큐에 예약 (생성 지시문은 표적 단위로 펼침)
+ * @param offset_ns 모든 이벤트 시각에 더할 값 (실행 중에 불러온 시나리오를 지금 시각부터 시작)
+ * @param end_ns    스크립트의 END 시각 (없으면 마지막 이벤트 시각), offset 포함
+ * @return 파일을 못 열거나 형식이 틀린 줄이 있으면 false
+ */
+bool scenario_load(const char* path, EventQueue* q, uint64_t offset_ns, uint64_t* end_ns) {
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL) {
+        printf("[ERROR] Cannot open scenario script '%s'.\n", path);
+        return false;
+    }
+
+    char line[512];
+    int line_no = 0;
+    bool has_end = false;
+    uint64_t last_ns = offset_ns, first_end_ns = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line_no++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        double sec, lat = HQ_LAT, lon = HQ_LON;
+        char cmd[16];
+        int offset = 0;
+        if (sscanf(line, " %lf %15s %n", &sec, cmd, &offset) < 2) {
+            if (strspn(line, " \t\r\n") != strlen(line)) {
+                printf("[ERROR] %s:%d: expected '<seconds> <command> ...'.\n", path, line_no);
+                ok = false;
+            }
+            continue;
+        }
+        if (sec < 0.0) {
+            printf("[ERROR] %s:%d: negative event time.\n", path, line_no);
+            ok = false;
+            continue;
+        }
+
+        SimEvent ev = { 0 };
+        ev.time_ns = offset_ns + (uint64_t)llround(sec * 1e9);
+        const char* args = line + offset;
+        GenSpec gen;
+        if (strcmp(cmd, "ADD") == 0 && sscanf(args, "%d %d %lf %lf", &ev.track_id, &ev.threat, &lat, &lon) >= 2) {
+            ev.type = SIM_EVENT_ADD;
+            ev.lat = lat;
+            ev.lon = lon;
+        } else if (strcmp(cmd, "KILL") == 0 && sscanf(args, "%d", &ev.track_id) == 1) {
+            ev.type = SIM_EVENT_KILL;
+        } else if (strcmp(cmd, "END") == 0) {
+            ev.type = SIM_EVENT_END;
+            if (!has_end || ev.time_ns < first_end_ns) first_end_ns = ev.time_ns;
+            has_end = true;
+        } else if (parse_generator(cmd, args, &gen)) {
+            if (!expand_generator(&gen, ev.time_ns, q, &last_ns)) { ok = false; break; }
+            continue;
+        } else {
+            printf("[ERROR] %s:%d: unknown or malformed command '%s'.\n", path, line_no, cmd);
+            ok = false;
+            continue;
+        }
+        if (!event_queue_push(q, &ev)) { ok = false; break; }
+        if (ev.time_ns > last_ns) last_ns = ev.time_ns;
+    }
+    fclose(fp);
+
+    *end_ns = has_end ? first_end_ns : last_ns;
+    return ok;
+}
+
+/* =================================================================
+   [4] Live Ingestion
+================================================================= */
+
+/**
+ * @brief 실시간 모드: 시각이 된 스크립트 이벤트를 꺼내 엔진에 반영
+ * @param now_ns    시나리오 시계의 현재 시각 (불러온 시점부터 흐른 시간)
+ * @param timestamp 궤적에 기록할 시각
+ * @return 반영한 ADD/KILL 수
+ * @note  END는 실시간 모드에서 무시합니다 (투입된 표적은 계속 비행).
+ *        대량 투입 중에는 표적별 생성 로그를 끕니다.
+ */
+size_t scenario_apply_due(TmapEngine* engine, EventQueue* q, uint64_t now_ns, int timestamp) {
+    size_t applied = 0;
+    bool log_waypoints = tmap_log_waypoints;
+    tmap_log_waypoints = false;
+    while (q->count > 0 && q->heap[0].time_ns <= now_ns) {
+        SimEvent ev;
+        event_queue_pop(q, &ev);
+        if (ev.type == SIM_EVENT_ADD) {
+            if (deploy_target(engine, ev.track_id, ev.threat, ev.lat, ev.lon, timestamp)) applied++;
+        } else if (ev.type == SIM_EVENT_KILL) {
+            if (kill_target(engine, ev.track_id)) applied++;
+        }
+    }
+    tmap_log_waypoints = log_waypoints;
+    return applied;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file    scheduler.c
+ * @brief   Deadline-Driven Fixed-Timestep Tick Scheduler
+ * @details 틱 시작 시각을 단조 시계의 절대 격자(start + k * period)에 고정합니다.
+ *          처리 시간이 얼마이든 다음 틱은 격자 시각에 깨어나므로 주기가 밀리지 않고,
+ *          마감을 놓치면 정책에 따라 밀린 틱을 몰아서 실행하거나 건너뜁니다.
+ *          기상 지연(jitter)과 실제 주기 오차는 히스토그램으로 누적됩니다.
+ */
+
+#include "common.h"
+#include "clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TICK_MAX_HZ         100     // 설정 가능한 최대 틱 주파수
+#define TICK_MAX_CATCH_UP   5       // 따라잡기 정책에서 한 번에 몰아서 실행할 최대 틱 수
+
+// 히스토그램 구간 경계 [us] (마지막 구간은 20 ms 이상)
+static const uint64_t tick_hist_edges_us[TICK_HIST_BUCKETS - 1] = {
+    50, 100, 250, 500, 1000, 2000, 5000, 10000, 20000
+};
+
+static int tick_hist_bucket(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    for (int i = 0; i < TICK_HIST_BUCKETS - 1; i++) {
+        if (us < tick_hist_edges_us[i]) return i;
+    }
+    return TICK_HIST_BUCKETS - 1;
+}
+
+/* =================================================================
+   [1] Scheduling
+================================================================= */
+
+/**
+ * @brief 스케줄러 초기화 (첫 틱은 즉시 시작)
+ * @param hz 틱 주파수 (1 ~ 100 Hz로 제한)
+ */
+void tick_scheduler_init(TickScheduler* sched, int hz, TickPolicy policy) {
+    if (hz < 1) hz = 1;
+    if (hz > TICK_MAX_HZ) hz = TICK_MAX_HZ;
+
+    memset(sched, 0, sizeof(*sched));
+    sched->period_ns = 1000000000ull / (uint64_t)hz;
+    sched->policy = policy;
+    sched->max_catch_up = TICK_MAX_CATCH_UP;
+    sched->next_deadline = tmap_now_ns();
+}
+
+/**
+ * @brief 마감 시각에 깨어난 직후 호출: 지연을 집계하고 이번에 실행할 시뮬레이션 틱 수를 반환
+ * @return 1 이상. 따라잡기 정책에서 마감을 여러 번 놓쳤으면 밀린 만큼 (최대 max_catch_up)
+ * @note  어느 정책이든 다음 마감은 현재 시각 이후의 첫 격자 시각으로 잡으므로,
+ *        한 번 늦어져도 그 뒤의 틱은 원래 위상으로 돌아옵니다.
+ *        대기는 호출 측이 합니다 (tick_scheduler_wait 또는 이벤트 루프의 timerfd).
+ */
+uint32_t tick_scheduler_begin(TickScheduler* sched) {
+    uint64_t now = tmap_now_ns();
+    uint64_t late = now > sched->next_deadline ? now - sched->next_deadline : 0;
+
+    // 통계: 기상 지연, 직전 틱과의 실제 간격 오차
+    sched->jitter_hist[tick_hist_bucket(late)]++;
+    if (late > sched->jitter_max_ns) sched->jitter_max_ns = late;
+    if (sched->last_start != 0) {
+        uint64_t period = now - sched->last_start;
+        uint64_t error = period > sched->period_ns ? period - sched->period_ns : sched->period_ns - period;
+        sched->period_hist[tick_hist_bucket(error)]++;
+    }
+    sched->last_start = now;
+    sched->tick_start = now;
+    sched->wakeups++;
+
+    // 지나간 마감 수 (이번 마감 포함)
+    uint64_t due = 1 + late / sched->period_ns;
+    uint64_t steps = 1;
+    if (sched->policy == TICK_POLICY_CATCH_UP) {
+        steps = due < sched->max_catch_up ? due : sched->max_catch_up;
+    }
+    sched->skipped += due - steps;
+    sched->ticks += steps;
+    sched->next_deadline += due * sched->period_ns;
+    return (uint32_t)steps;
+}
+
+/**
+ * @brief 다음 마감 시각까지 대기한 뒤 tick_scheduler_begin
+ */
+uint32_t tick_scheduler_wait(TickScheduler* sched) {
+    tmap_sleep_until_ns(sched->next_deadline);
+    return tick_scheduler_begin(sched);
+}
+
+/**
+ * @brief 이번 틱 처리 종료 표시 (처리 시간 집계, 다음 마감 초과 여부 판정)
+ */
+void tick_scheduler_end(TickScheduler* sched) {
+    uint64_t now = tmap_now_ns();
+    uint64_t work = now - sched->tick_start;
+    sched->work_total_ns += work;
+    if (work > sched->work_max_ns) sched->work_max_ns = work;
+    if (now > sched->next_deadline) sched->overruns++;
+}
+
+/**
+ * @brief 다음 마감까지 남은 시간 (이미 지났으면 0)
+ * @note  틱 안의 선택적 작업(묘비 정리 등)이 예산을 마감에 맞춰 줄일 때 씁니다.
+ */
+uint64_t tick_scheduler_remaining_ns(const TickScheduler* sched) {
+    uint64_t now = tmap_now_ns();
+    return now < sched->next_deadline ? sched->next_deadline - now : 0;
+}
+
+/* =================================================================
+   [2] Statistics
+================================================================= */
+
+/**
+ * @brief 틱 주기/지연 통계 출력
+ */
+void tick_scheduler_report(const TickScheduler* sched) {
+    uint64_t wakeups = sched->wakeups ? sched->wakeups : 1;
+    printf("[TICK] %.1f Hz (period %.2f ms) | policy %s | ticks %llu in %llu wake-ups | overruns %llu | skipped %llu\n",
+           1e9 / (double)sched->period_ns, sched->period_ns / 1e6,
+           sched->policy == TICK_POLICY_CATCH_UP ? "catch-up" : "skip",
+           (unsigned long long)sched->ticks, (unsigned long long)sched->wakeups,
+           (unsigned long long)sched->overruns, (unsigned long long)sched->skipped);
+    printf("[TICK] work avg %.2f ms / max %.2f ms | wake-up jitter max %.1f us\n",
+           sched->work_total_ns / 1e6 / (double)wakeups, sched->work_max_ns / 1e6, sched->jitter_max_ns / 1e3);
+    printf("  %-12s | %10s | %12s\n", "bucket", "jitter", "period error");
+    for (int i = 0; i < TICK_HIST_BUCKETS; i++) {
+        char label[24];
+        if (i < TICK_HIST_BUCKETS - 1) snprintf(label, sizeof(label), "< %llu us", (unsigned long long)tick_hist_edges_us[i]);
+        else snprintf(label, sizeof(label), ">= %llu us", (unsigned long long)tick_hist_edges_us[i - 1]);
+        printf("  %-12s | %10llu | %12llu\n", label,
+               (unsigned long long)sched->jitter_hist[i], (unsigned long long)sched->period_hist[i]);
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file    threat_index.c
+ * @brief   Threat-Level Secondary Index
+ * @details 위협도 단계별 B+Tree로 구성된 (threat_level, track_id) 2차 인덱스.
+ *          "위협도 N 이상 활성 표적" 조회는 결과 개수 k에 비례하는 O(k + log N),
+ *          "가장 위협적인 활성 표적" 조회는 O(log N)으로 끝나며 저위협 표적 수와 무관합니다.
+ *          표적의 위협도나 상태가 바뀔 때마다 이 모듈의 함수로 동기화해야 합니다.
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+extern bool btree_insert(TrackArena* arena, BTreeNode** root, TacticalTrack* track);
+extern TacticalTrack* btree_delete(TrackArena* arena, BTreeNode** root, int32_t key);
+extern void btree_cursor_first(BTreeCursor* cur, BTreeNode* root);
+extern TacticalTrack* btree_cursor_next(BTreeCursor* cur);
+extern void free_btree_node(TrackArena* arena, BTreeNode* node);
+
+/**
+ * @brief 위협도 값을 인덱스 단계로 변환 (범위 밖 값은 양 끝 단계로 묶음)
+ */
+static inline int threat_bucket(int threat_level) {
+    if (threat_level < 0) return 0;
+    if (threat_level >= THREAT_LEVELS) return THREAT_LEVELS - 1;
+    return threat_level;
+}
+
+/**
+ * @brief 활성 표적을 인덱스에 등록 (파괴된 표적은 무시)
+ * @note  인덱스 노드는 표적이 속한 엔진의 아레나에서 할당합니다.
+ */
+void threat_index_add(ThreatIndex* idx, TacticalTrack* track) {
+    if (track == NULL || track->status != TRACK_STATUS_ACTIVE) return;
+    int b = threat_bucket(track->threat_level);
+    btree_insert(&track->engine->arena, &idx->levels[b], track);
+    idx->nonempty |= 1u << b;
+    idx->count++;
+}
+
+/**
+ * @brief 인덱스에서 표적 제거 (요격, 물리 삭제, 위협도 변경 직전에 호출)
+ */
+void threat_index_remove(ThreatIndex* idx, TacticalTrack* track) {
+    if (track == NULL) return;
+    int b = threat_bucket(track->threat_level);
+    if (btree_delete(&track->engine->arena, &idx->levels[b], track->track_id) == NULL) return;
+    if (idx->levels[b] == NULL) idx->nonempty &= ~(1u << b);
+    idx->count--;
+}
+
+/**
+ * @brief 표적의 위협도를 바꾸고 인덱스 위치를 재조정
+ */
+void threat_index_set_threat(ThreatIndex* idx, TacticalTrack* track, int threat_level) {
+    if (track == NULL) return;
+    threat_index_remove(idx, track);
+    track->threat_level = threat_level;
+    if (track->live_slot >= 0) track->engine->live.threat[track->live_slot] = threat_level;
+    threat_index_add(idx, track);
+}
+
+/**
+ * @brief 가장 위협도가 높은 활성 표적 (같은 단계에서는 가장 작은 ID) [O(log N)]
+ * @return 활성 표적이 없으면 NULL
+ */
+TacticalTrack* threat_index_top(const ThreatIndex* idx) {
+    if (idx->nonempty == 0) return NULL;
+    int b = 31 - __builtin_clz(idx->nonempty);
+    BTreeCursor cur;
+    btree_cursor_first(&cur, idx->levels[b]);
+    return btree_cursor_next(&cur);
+}
+
+/**
+ * @brief 위협도 min_threat 이상 활성 표적 스캔 시작 (높은 위협도부터, 같은 단계는 ID 순)
+ */
+void threat_cursor_begin(ThreatCursor* cur, const ThreatIndex* idx, int min_threat) {
+    cur->index = idx;
+    cur->min_threat = min_threat;
+    cur->level = THREAT_LEVELS;
+    cur->inner.leaf = NULL;
+}
+
+/**
+ * @brief 다음 표적 반환 (더 없으면 NULL)
+ * @note  비어 있는 단계는 비트마스크로 건너뛰므로 빈 단계 순회 비용도 없습니다.
+ */
+TacticalTrack* threat_cursor_next(ThreatCursor* cur) {
+    const int lowest = threat_bucket(cur->min_threat);
+    for (;;) {
+        TacticalTrack* track = btree_cursor_next(&cur->inner);
+        if (track != NULL) {
+            // 마지막 단계(15+)와 음수 단계는 여러 위협도가 섞여 있으므로 실제 값으로 한 번 더 거름
+            if (track->threat_level >= cur->min_threat) return track;
+            continue;
+        }
+
+        // 현재 단계 아래에서 비어 있지 않은 가장 높은 단계로 이동
+        uint32_t below = cur->index->nonempty & ((1u << cur->level) - 1) & ~((1u << lowest) - 1);
+        if (cur->level <= lowest || below == 0) return NULL;
+        cur->level = 31 - __builtin_clz(below);
+        btree_cursor_first(&cur->inner, cur->index->levels[cur->level]);
+    }
+}
+
+/**
+ * @brief 고위험 표적 스캔 [O(k + log N)]
+ */
+void scan_high_threat(const ThreatIndex* idx, int threshold) {
+    ThreatCursor cur;
+    threat_cursor_begin(&cur, idx, threshold);
+    TacticalTrack* track;
+    while ((track = threat_cursor_next(&cur)) != NULL) {
+        printf("  [!] ALERT: Target %d (Threat: %d) detected!\n", 
+               track->track_id, track->threat_level);
+    }
+}
+
+/**
+ * @brief 인덱스 노드 메모리 해제 (표적 본체는 주 B-Tree 소유이므로 해제하지 않음)
+ */
+static void free_threat_level(TrackArena* arena, BTreeNode* node) {
+    if (node == NULL) return;
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->num_keys; i++) free_threat_level(arena, node->children[i]);
+    }
+    free_btree_node(arena, node);
+}
+
+void threat_index_free(ThreatIndex* idx, TrackArena* arena) {
+    for (int b = 0; b < THREAT_LEVELS; b++) {
+        free_threat_level(arena, idx->levels[b]);
+        idx->levels[b] = NULL;
+    }
+    idx->nonempty = 0;
+    idx->count = 0;
+}
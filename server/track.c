@@ -8,11 +8,47 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+extern void* pool_alloc(ObjectPool* pool);
+extern void pool_free(ObjectPool* pool, void* obj);
+extern void pool_free_chain(ObjectPool* pool, void* head, void* tail, size_t count);
+extern ObjectPool* history_block_pool(TrackArena* arena, const HistoryBlock* block);
+extern HistoryBlock* history_block_pack(TrackArena* arena, const HistoryBlock* raw);
+extern int history_block_unpack(const HistoryBlock* block, HistoryPoint* out);
+extern int history_block_first_timestamp(const HistoryBlock* block);
+extern int live_table_add(LiveTable* table, TacticalTrack* track, double lat, double lon);
+extern void live_table_remove(LiveTable* table, TacticalTrack* track);
+
 /**
- * @brief   메모리에서 새로운 전술 표적 객체를 할당하고 초기화합니다.
+ * @brief 표적 생성/요격 로그 출력 여부 (헤드리스 실행 시 끔)
+ */
+bool tmap_log_waypoints = true;
+
+/**
+ * @brief 콜드 스토리지 싱크 직렬화 잠금 (병렬 틱에서 여러 작업자가 블록을 동시에 내보낼 수 있음)
+ */
+static pthread_mutex_t cold_sink_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief   새 표적의 기본 기동 상태 (ID에서 유도한 기본 속도, 양의 방향, 직진)
+ * @note    ID가 음수여도 속도 성분이 같은 범위에 들도록 나머지를 양수로 맞춥니다.
+ */
+static void init_track_motion(TrackMotion* m, int track_id) {
+    unsigned int id = (unsigned int)track_id;
+    m->vel_lat = ((int)(id % 5) - 2) * 0.00008;
+    m->vel_lon = ((int)(id % 7) - 3) * 0.00008;
+    if (m->vel_lat == 0 && m->vel_lon == 0) { m->vel_lat = 0.00006; m->vel_lon = 0.00006; }
+    m->turn    = 0.0;
+    m->phase   = 0;
+    m->dir_lat = 1;
+    m->dir_lon = 1;
+}
+
+/**
+ * @brief   로그 없이 표적 객체를 할당하고 초기화합니다. (대량 적재용)
+ * @note    표적은 engine의 아레나에서 할당되고, 이후 궤적 블록과 실시간 표적 테이블 행도 같은 엔진 것을 씁니다.
  */
-TacticalTrack* create_track(int track_id, int threat_level) {
-    TacticalTrack* new_track = (TacticalTrack*)malloc(sizeof(TacticalTrack));
+TacticalTrack* create_track_quiet(TmapEngine* engine, int track_id, int threat_level) {
+    TacticalTrack* new_track = (TacticalTrack*)pool_alloc(&engine->arena.tracks);
     if (new_track == NULL) {
         printf("[FATAL ERROR] Memory allocation failed for Target ID: %d.\n", track_id);
         return NULL;
@@ -22,36 +58,141 @@ TacticalTrack* create_track(int track_id, int threat_level) {
     new_track->threat_level  = threat_level;
     new_track->status        = TRACK_STATUS_ACTIVE;
     new_track->history_count = 0;
+    new_track->live_slot     = -1;
     new_track->history_head  = NULL;
     new_track->history_tail  = NULL; 
+    new_track->history_link  = &new_track->history_head;
+    new_track->engine        = engine;
+    init_track_motion(&new_track->motion, track_id);
+    return new_track;
+}
+
+/**
+ * @brief   메모리에서 새로운 전술 표적 객체를 할당하고 초기화합니다.
+ */
+TacticalTrack* create_track(TmapEngine* engine, int track_id, int threat_level) {
+    TacticalTrack* new_track = create_track_quiet(engine, track_id, threat_level);
+    if (new_track == NULL) return NULL;
     
     LOG_WAYPOINT("CREATE", track_id, "Memory securely allocated & initialized.");
     return new_track;
 }
 
+/**
+ * @brief   다 잘려 나간 가장 오래된 블록을 콜드 스토리지에 넘기고 풀로 반환합니다.
+ * @note    반환된 블록은 프리 리스트 맨 앞에 놓이므로 곧바로 다음 꼬리 블록으로 재사용됩니다.
+ */
+static void retire_head_block(TacticalTrack* track) {
+    HistoryBlock* head = track->history_head;
+    const HistoryRetention* r = &track->engine->retention;
+    if (r->cold_sink != NULL) {
+        HistoryPoint points[HISTORY_BLOCK_POINTS];
+        const HistoryPoint* expired = head->points;
+        int count = head->count;
+        if (head->encoded != 0) { count = history_block_unpack(head, points); expired = points; }
+
+        pthread_mutex_lock(&cold_sink_lock);
+        r->cold_sink(track, expired, count, r->cold_ctx);
+        pthread_mutex_unlock(&cold_sink_lock);
+    }
+    track->history_head = head->next;
+    if (track->history_link == &head->next) track->history_link = &track->history_head;
+    pool_free(history_block_pool(&track->engine->arena, head), head);
+}
+
+/**
+ * @brief   보존 정책을 넘는 오래된 점을 앞에서부터 잘라냅니다. [점 1개 추가당 분할상환 O(1)]
+ * @note    최신 점은 두 조건 모두에서 항상 살아남으므로 head가 tail인 채로 비는 일은 없습니다.
+ *          압축 블록은 점 단위로 풀지 않고, 다음 블록의 첫 점까지 만료되었을 때 통째로 잘라냅니다.
+ */
+static void apply_retention(TacticalTrack* track) {
+    const HistoryRetention* r = &track->engine->retention;
+    if (r->max_points <= 0 && r->max_age <= 0) return;
+
+    int newest = history_last(track)->timestamp;
+    for (;;) {
+        HistoryBlock* head = track->history_head;
+        bool over_count = (r->max_points > 0 && track->history_count > r->max_points);
+        bool too_old = false;
+        if (r->max_age > 0 && !over_count) {
+            if (head->encoded == 0) {
+                too_old = (newest - head->points[head->start].timestamp > r->max_age);
+            } else if (head->next != NULL && newest - history_block_first_timestamp(head->next) > r->max_age) {
+                track->history_count -= head->count - head->start;
+                head->start = head->count;
+                retire_head_block(track);
+                continue;
+            }
+        }
+        if (!over_count && !too_old) break;
+
+        head->start++;
+        track->history_count--;
+        if (head->start == head->count) retire_head_block(track);
+    }
+}
+
+/**
+ * @brief   가득 찬 꼬리 블록을 압축 블록으로 교체합니다.
+ * @return  이후 꼬리 앞에 놓일 블록 (압축 실패 시 원본 그대로)
+ */
+static HistoryBlock* seal_block(TacticalTrack* track, HistoryBlock* full) {
+    TrackArena* arena = &track->engine->arena;
+    HistoryBlock* packed = history_block_pack(arena, full);
+    if (packed == NULL) return full;
+    *track->history_link = packed;
+    pool_free(history_block_pool(arena, full), full);
+    return packed;
+}
+
 /**
  * @brief   표적의 새로운 위치(궤적)를 기록합니다. [O(1)]
+ * @note    꼬리 블록에 빈 자리가 있으면 배열에 바로 쓰고, 가득 찼을 때만 새 블록을 붙입니다.
+ *          압축 정책이면 밀려난 꼬리 블록을 이때 봉인하여 압축합니다 (128점마다 1회).
  */
 void add_history_node(TacticalTrack* track, double lat, double lon, int timestamp) {
     if (track == NULL || track->status == TRACK_STATUS_DESTROYED) return;
 
-    HistoryNode* new_node = (HistoryNode*)malloc(sizeof(HistoryNode));
-    if (new_node == NULL) return;
+    TmapEngine* engine = track->engine;
+    HistoryBlock* tail = track->history_tail;
+    if (tail == NULL || tail->count == tail->capacity) {
+        bool first = (tail == NULL);
+        HistoryBlock* block = (HistoryBlock*)pool_alloc(first ? &engine->arena.history_head
+                                                              : &engine->arena.history);
+        if (block == NULL) return;
 
-    new_node->lat       = lat;
-    new_node->lon       = lon;
-    new_node->timestamp = timestamp;
-    new_node->next      = NULL;
+        block->next     = NULL;
+        block->count    = 0;
+        block->start    = 0;
+        block->encoded  = 0;
+        block->capacity = first ? HISTORY_HEAD_POINTS : HISTORY_BLOCK_POINTS;
 
-    if (track->history_head == NULL) {
-        track->history_head = new_node;
-        track->history_tail = new_node;
-    } else {
-        track->history_tail->next = new_node;
-        track->history_tail = new_node;
+        if (first) {
+            track->history_head = block;
+            track->history_link = &track->history_head;
+        } else {
+            if (engine->retention.compress) tail = seal_block(track, tail);
+            tail->next = block;
+            track->history_link = &tail->next;
+        }
+        track->history_tail = tail = block;
     }
-    
+
+    HistoryPoint* point = &tail->points[tail->count++];
+    point->lat       = lat;
+    point->lon       = lon;
+    point->timestamp = timestamp;
     track->history_count++;
+
+    // 실시간 표적 테이블의 현재 위치 갱신 (첫 위치가 찍히는 순간 테이블에 등록)
+    if (track->live_slot >= 0) {
+        engine->live.lat[track->live_slot] = lat;
+        engine->live.lon[track->live_slot] = lon;
+    } else {
+        live_table_add(&engine->live, track, lat, lon);
+    }
+
+    apply_retention(track);
     
     // ======== 이 부분을 주석 처리합니다! ========
     // char msg[100];
@@ -61,19 +202,34 @@ void add_history_node(TacticalTrack* track, double lat, double lon, int timestam
 }
 
 /**
- * @brief   표적의 궤적(Linked List) 메모리만 선택적으로 해제합니다.
+ * @brief   표적의 궤적 블록 메모리만 선택적으로 해제합니다. [O(1)]
+ * @details 블록의 next 링크가 곧 풀의 프리 리스트 링크이므로, 블록을 하나씩
+ *          free하지 않고 두 번째 블록~tail 사슬을 프리 리스트 앞에 통째로 이어 붙입니다.
+ *          head 이후 블록은 tail을 빼면 항상 가득 차 있고 잘린 점도 없으므로,
+ *          사슬의 블록 수는 점 개수로 계산됩니다. 남은 궤적은 콜드 스토리지로 넘기지 않습니다.
+ *          압축 정책인 표적은 블록마다 크기 등급 풀이 다르므로 블록 단위로 반환합니다 [O(블록 수)].
  */
 void clear_track_history(TacticalTrack* track) {
-    if (track == NULL) return;
+    if (track == NULL || track->history_head == NULL) return;
 
-    HistoryNode* current = track->history_head;
-    while (current != NULL) {
-        HistoryNode* next_node = current->next;
-        free(current);
-        current = next_node;
+    TrackArena* arena = &track->engine->arena;
+    HistoryBlock* head = track->history_head;
+    if (track->engine->retention.compress) {
+        HistoryBlock* block = head->next;
+        while (block != NULL) {
+            HistoryBlock* next = block->next;
+            pool_free(history_block_pool(arena, block), block);
+            block = next;
+        }
+    } else if (head->next != NULL) {
+        size_t rest = (size_t)(track->history_count - (head->count - head->start));
+        pool_free_chain(&arena->history, head->next, track->history_tail,
+                        (rest + HISTORY_BLOCK_POINTS - 1) / HISTORY_BLOCK_POINTS);
     }
+    pool_free(history_block_pool(arena, head), head);
     track->history_head = NULL;
     track->history_tail = NULL;
+    track->history_link = &track->history_head;
     track->history_count = 0;
 }
 
@@ -83,8 +239,9 @@ void clear_track_history(TacticalTrack* track) {
 void intercept_track(TacticalTrack* track) {
     if (track == NULL || track->status == TRACK_STATUS_DESTROYED) return;
 
-    // 궤적 리스트만 소각
+    // 궤적 리스트만 소각하고 실시간 테이블에서 제외
     clear_track_history(track);
+    live_table_remove(&track->engine->live, track);
 
     // 상태값을 '파괴됨'으로 변경
     track->status = TRACK_STATUS_DESTROYED;
@@ -101,10 +258,8 @@ void free_track(TacticalTrack* track) {
 
     // 1. 남아있는 궤적 메모리 모두 해 de
     clear_track_history(track);
+    live_table_remove(&track->engine->live, track);
 
     // 2. 표적 구조체 본체 해제
-    int id = track->track_id;
-    free(track);
-
-    // printf("[DEBUG] Track %d fully freed from memory.\n", id);
+    pool_free(&track->engine->arena.tracks, track);
 }
\ No newline at end of file
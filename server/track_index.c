@@ -0,0 +1,175 @@
+/**
+ * @file    track_index.c
+ * @brief   O(1) Track ID Hash Index
+ * @details 표적 ID로 TacticalTrack을 즉시 찾기 위한 Robin Hood 오픈 어드레싱 해시 테이블.
+ *          B-Tree는 순서(범위 스캔)를 담당하고, 단건 조회(KILL, SEARCH, 중복 판단)는
+ *          이 인덱스가 담당합니다. B-Tree와 항상 같은 표적 집합을 유지해야 합니다.
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACK_INDEX_MIN_CAPACITY 1024
+#define TRACK_INDEX_MAX_DIST     255    // dist[]가 1바이트이므로 탐사 거리 상한
+
+/* =================================================================
+   [1] Hashing
+================================================================= */
+
+/**
+ * @brief 피보나치(곱셈) 해싱: 상위 비트를 버킷 번호로 사용
+ * @note  연속된 ID(1000, 1001, ...)와 희소한 ID 모두 테이블 전체에 고르게 흩어집니다.
+ */
+static inline size_t home_bucket(const TrackIndex* idx, int64_t key) {
+    return (size_t)(((uint64_t)key * 0x9E3779B97F4A7C15ull) >> idx->shift);
+}
+
+static bool allocate_table(TrackIndex* idx, size_t capacity) {
+    idx->slots = (TrackIndexSlot*)malloc(sizeof(TrackIndexSlot) * capacity);
+    idx->dist  = (uint8_t*)calloc(capacity, sizeof(uint8_t));
+    if (idx->slots == NULL || idx->dist == NULL) {
+        free(idx->slots);
+        free(idx->dist);
+        idx->slots = NULL;
+        idx->dist = NULL;
+        printf("[FATAL ERROR] Memory allocation failed for track index (%zu slots).\n", capacity);
+        return false;
+    }
+    idx->capacity = capacity;
+    idx->count = 0;
+    idx->shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) idx->shift--;
+    return true;
+}
+
+/* =================================================================
+   [2] Lifecycle
+================================================================= */
+
+/**
+ * @brief 인덱스 초기화 (expected_tracks개를 재해싱 없이 담을 수 있는 크기로)
+ */
+bool track_index_init(TrackIndex* idx, size_t expected_tracks) {
+    size_t capacity = TRACK_INDEX_MIN_CAPACITY;
+    while (capacity * 7 / 8 < expected_tracks) capacity <<= 1;
+    return allocate_table(idx, capacity);
+}
+
+/**
+ * @brief 인덱스 메모리 해제 (표적 본체는 해제하지 않음)
+ */
+void track_index_free(TrackIndex* idx) {
+    free(idx->slots);
+    free(idx->dist);
+    memset(idx, 0, sizeof(TrackIndex));
+}
+
+/* =================================================================
+   [3] Operations
+================================================================= */
+
+static bool track_index_grow(TrackIndex* idx);
+
+/**
+ * @brief 표적 등록 (이미 있는 ID면 포인터만 교체)
+ * @note  Robin Hood 규칙: 탐사 중 자기보다 홈에 더 가까운(부유한) 원소를 만나면
+ *        자리를 빼앗고, 밀려난 원소가 계속 탐사를 이어갑니다.
+ */
+bool track_index_put(TrackIndex* idx, int64_t key, TacticalTrack* track) {
+    if (idx->capacity == 0 && !track_index_init(idx, 0)) return false;
+    if ((idx->count + 1) * 8 > idx->capacity * 7 && !track_index_grow(idx)) return false;
+
+    size_t mask = idx->capacity - 1;
+    size_t i = home_bucket(idx, key);
+    TrackIndexSlot carry = { key, track };
+    unsigned d = 1;
+
+    for (;;) {
+        uint8_t m = idx->dist[i];
+        if (m == 0) {
+            idx->slots[i] = carry;
+            idx->dist[i] = (uint8_t)d;
+            idx->count++;
+            return true;
+        }
+        if (m == d && idx->slots[i].key == carry.key) {
+            idx->slots[i].track = carry.track;
+            return true;
+        }
+        if (m < d) {
+            TrackIndexSlot evicted = idx->slots[i];
+            idx->slots[i] = carry;
+            idx->dist[i] = (uint8_t)d;
+            carry = evicted;
+            d = m;
+        }
+        i = (i + 1) & mask;
+        if (++d > TRACK_INDEX_MAX_DIST) {
+            // 극단적인 군집: 테이블을 키우고 밀려난 원소부터 다시 삽입
+            return track_index_grow(idx) && track_index_put(idx, carry.key, carry.track);
+        }
+    }
+}
+
+/**
+ * @brief ID로 표적 조회 [O(1) 평균]
+ * @return 없으면 NULL
+ */
+TacticalTrack* track_index_get(const TrackIndex* idx, int64_t key) {
+    if (idx->count == 0) return NULL;
+    size_t mask = idx->capacity - 1;
+    size_t i = home_bucket(idx, key);
+    for (unsigned d = 1; ; d++) {
+        uint8_t m = idx->dist[i];
+        // 빈 슬롯이거나 더 부유한 원소를 만나면 그 뒤에는 key가 있을 수 없음
+        if (m < d) return NULL;
+        if (m == d && idx->slots[i].key == key) return idx->slots[i].track;
+        i = (i + 1) & mask;
+    }
+}
+
+/**
+ * @brief 표적 등록 해제 (Backward-shift 삭제: 묘비 없이 뒤 원소들을 한 칸씩 당김)
+ * @return 제거했으면 true
+ */
+bool track_index_remove(TrackIndex* idx, int64_t key) {
+    if (idx->count == 0) return false;
+    size_t mask = idx->capacity - 1;
+    size_t i = home_bucket(idx, key);
+    for (unsigned d = 1; ; d++) {
+        uint8_t m = idx->dist[i];
+        if (m < d) return false;
+        if (m == d && idx->slots[i].key == key) break;
+        i = (i + 1) & mask;
+    }
+
+    size_t next = (i + 1) & mask;
+    while (idx->dist[next] > 1) {
+        idx->slots[i] = idx->slots[next];
+        idx->dist[i] = (uint8_t)(idx->dist[next] - 1);
+        i = next;
+        next = (next + 1) & mask;
+    }
+    idx->dist[i] = 0;
+    idx->count--;
+    return true;
+}
+
+/**
+ * @brief 용량 2배 확장 후 전체 재삽입
+ */
+static bool track_index_grow(TrackIndex* idx) {
+    TrackIndex old = *idx;
+    if (!allocate_table(idx, old.capacity * 2)) {
+        *idx = old;
+        return false;
+    }
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.dist[i] != 0) track_index_put(idx, old.slots[i].key, old.slots[i].track);
+    }
+    free(old.slots);
+    free(old.dist);
+    return true;
+}
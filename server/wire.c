@@ -0,0 +1,372 @@
+/**
+ * @file    wire.c
+ * @brief   Track Broadcast Encoding (MTU-Batched Frames, v2 Delta Records)
+ * @details 실시간 표적 테이블을 클라이언트로 보낼 데이터그램으로 만듭니다.
+ *          모든 방식은 한 데이터그램을 MTU(1400 B) 안에 맞추고, 실제 송신은 WireSink가 하므로
+ *          실시간 루프(sendto)와 헤드리스(요약값)가 같은 바이트열을 공유합니다.
+ *
+ *          - v2 (기본): 좌표를 마이크로도 정수로 양자화하고, 마지막 키프레임 대비 바뀐 필드만 varint 차분으로 보냅니다.
+ *            키프레임(기본 10 브로드캐스트마다)은 모든 표적의 기준 상태를 다시 보내 유실된 클라이언트를 복구합니다.
+ *            차분이 직전 틱이 아니라 키프레임 기준이라 어떤 프레임이 유실되어도 다음 프레임은 그대로 해석됩니다.
+ *            레코드 형식은 common/packet.h의 TrackDeltaHeader 설명에 있습니다.
+ *          - v1: TrackFrameHeader 뒤에 TargetPacket을 49개까지 그대로 붙인 프레임 (--wire framed)
+ *          - 표적마다 28바이트 데이터그램 하나 (--wire per-track, 예전 방식)
+ */
+
+#include "common.h"
+#include "../common/packet.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#define WIRE_KEYFRAME_INTERVAL   10     // v2 키프레임 간격 [브로드캐스트 수] (10 Hz에서 1초)
+#define WIRE_REMOVAL_REPEAT      3      // 사라진 표적의 요격 레코드를 최소 몇 번 반복해 보낼지 (유실 대비)
+#define WIRE_BASE_MIN_CAPACITY   1024
+
+/* =================================================================
+   [1] Lifecycle
+================================================================= */
+
+/**
+ * @brief 송출 상태 초기화 (프레임 순번 0부터, v2는 첫 브로드캐스트가 키프레임)
+ */
+void wire_encoder_init(WireEncoder* enc, WireMode mode) {
+    memset(enc, 0, sizeof(WireEncoder));
+    enc->mode = mode;
+    enc->keyframe_interval = WIRE_KEYFRAME_INTERVAL;
+}
+
+/**
+ * @brief v2 기준 상태 테이블 해제
+ */
+void wire_encoder_free(WireEncoder* enc) {
+    free(enc->base);
+    enc->base = NULL;
+    enc->base_capacity = enc->base_count = 0;
+}
+
+/**
+ * @brief --wire 인자 해석 ("delta" | "framed" | "per-track")
+ * @return false = 모르는 이름 (mode는 그대로)
+ */
+bool wire_parse_mode(const char* name, WireMode* mode) {
+    if (strcmp(name, "delta") == 0) *mode = WIRE_MODE_DELTA;
+    else if (strcmp(name, "framed") == 0) *mode = WIRE_MODE_FRAMED;
+    else if (strcmp(name, "per-track") == 0) *mode = WIRE_MODE_PER_TRACK;
+    else return false;
+    return true;
+}
+
+/* =================================================================
+   [2] v1 Frames (TargetPacket Records)
+================================================================= */
+
+// 실시간 표적 테이블 한 행 → TargetPacket (좌표는 예전 송출과 같이 float 정밀도)
+static void wire_fill_record(TargetPacket* pkt, const LiveTable* live, size_t row) {
+    pkt->id = live->id[row];
+    pkt->lat = (float)live->lat[row];
+    pkt->lon = (float)live->lon[row];
+    pkt->threat_level = live->threat[row];
+    pkt->status = TRACK_STATUS_ACTIVE;
+}
+
+static size_t wire_broadcast_per_track(WireEncoder* enc, const LiveTable* live, WireSink sink, void* ctx) {
+    for (size_t i = 0; i < live->count; i++) {
+        TargetPacket pkt;
+        memset(&pkt, 0, sizeof(TargetPacket));
+        wire_fill_record(&pkt, live, i);
+        sink(&pkt, sizeof(TargetPacket), ctx);
+    }
+    enc->bytes += live->count * sizeof(TargetPacket);
+    return live->count;
+}
+
+// 행 순서대로 TRACK_FRAME_MAX_RECORDS개씩 채우고, 틱의 마지막 프레임에 LAST 플래그를 붙임
+static size_t wire_broadcast_framed(WireEncoder* enc, const LiveTable* live, uint32_t tick, WireSink sink, void* ctx) {
+    size_t sent = 0;
+    unsigned char frame[TRACK_FRAME_MTU];
+    TrackFrameHeader header;
+    TargetPacket pkt;
+    for (size_t begin = 0; begin < live->count; begin += TRACK_FRAME_MAX_RECORDS) {
+        size_t n = live->count - begin;
+        if (n > TRACK_FRAME_MAX_RECORDS) n = TRACK_FRAME_MAX_RECORDS;
+
+        memset(&header, 0, sizeof(header));
+        header.magic = TRACK_FRAME_MAGIC;
+        header.version = TRACK_FRAME_VERSION;
+        header.flags = (begin + n == live->count) ? TRACK_FRAME_FLAG_LAST : 0;
+        header.seq = enc->next_seq++;
+        header.tick = tick;
+        header.count = (uint16_t)n;
+        memcpy(frame, &header, sizeof(header));
+        memset(&pkt, 0, sizeof(TargetPacket));
+        for (size_t i = 0; i < n; i++) {
+            wire_fill_record(&pkt, live, begin + i);
+            memcpy(frame + sizeof(TrackFrameHeader) + i * sizeof(TargetPacket), &pkt, sizeof(TargetPacket));
+        }
+
+        size_t len = sizeof(TrackFrameHeader) + n * sizeof(TargetPacket);
+        sink(frame, len, ctx);
+        enc->bytes += len;
+        sent++;
+    }
+    return sent;
+}
+
+/* =================================================================
+   [3] v2 Baseline Table (Track ID → Last Keyframe State)
+================================================================= */
+
+static inline size_t wire_base_home(const WireEncoder* enc, int32_t id) {
+    return (size_t)(((uint64_t)(uint32_t)id * 0x9E3779B97F4A7C15ull) >> enc->base_shift);
+}
+
+// id의 슬롯 또는 (없으면) 들어갈 빈 슬롯 (선형 탐사, 부하율 3/4 이하라 항상 빈 슬롯이 있음)
+static WireBaseline* wire_base_probe(const WireEncoder* enc, int32_t id) {
+    size_t mask = enc->base_capacity - 1;
+    size_t i = wire_base_home(enc, id);
+    while (enc->base[i].seen != 0 && enc->base[i].id != id) i = (i + 1) & mask;
+    return &enc->base[i];
+}
+
+// expected개를 부하율 3/4 이하로 담는 새 테이블로 교체하고, 마지막으로 본 지 max_age 브로드캐스트 이내인 항목만 옮겨 담음
+static bool wire_base_rebuild(WireEncoder* enc, size_t expected, uint32_t stamp, uint32_t max_age) {
+    size_t capacity = WIRE_BASE_MIN_CAPACITY;
+    while (capacity / 4 * 3 < expected) capacity <<= 1;
+    WireBaseline* table = (WireBaseline*)calloc(capacity, sizeof(WireBaseline));
+    if (table == NULL) {
+        printf("[WARN] Memory allocation failed for wire baseline table (%zu slots).\n", capacity);
+        return false;
+    }
+
+    WireBaseline* old = enc->base;
+    size_t old_capacity = enc->base_capacity;
+    enc->base = table;
+    enc->base_capacity = capacity;
+    enc->base_count = 0;
+    enc->base_shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) enc->base_shift--;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        const WireBaseline* e = &old[i];
+        if (e->seen == 0) continue;
+        if (stamp - e->seen > max_age) continue;
+        *wire_base_probe(enc, e->id) = *e;
+        enc->base_count++;
+    }
+    free(old);
+    return true;
+}
+
+/* =================================================================
+   [4] v2 Frame Writer
+================================================================= */
+
+/**
+ * @brief 가변 길이 레코드를 프레임에 채우는 작성기
+ * @note  다 찬 프레임은 바로 보내지 않고 한 개 미뤄 두었다가, 틱이 끝날 때 마지막 프레임에 LAST 플래그를 붙여 보냅니다.
+ */
+typedef struct {
+    WireEncoder*        enc;
+    WireSink            sink;
+    void*               ctx;
+    uint32_t            tick;
+    uint8_t             flags;          // 작성 중인 프레임의 플래그 (KEYFRAME 여부)
+    uint16_t            count;          // 작성 중인 프레임의 레코드 수
+    size_t              len;            // 작성 중인 프레임 길이 (머리 포함)
+    int32_t             prev_id, prev_lat, prev_lon;    // 프레임 안 앞 레코드 값 (프레임마다 0부터)
+    size_t              pending_len;    // 미뤄 둔 프레임 길이 (0 = 없음)
+    size_t              sent;
+    unsigned char       frame[TRACK_FRAME_MTU];
+    unsigned char       pending[TRACK_FRAME_MTU];
+} WireDeltaWriter;
+
+static void wire_writer_send_pending(WireDeltaWriter* w, bool last) {
+    if (w->pending_len == 0) return;
+    if (last) w->pending[offsetof(TrackFrameHeader, flags)] |= TRACK_FRAME_FLAG_LAST;
+    w->sink(w->pending, w->pending_len, w->ctx);
+    w->enc->bytes += w->pending_len;
+    w->sent++;
+    w->pending_len = 0;
+}
+
+static void wire_writer_reset(WireDeltaWriter* w) {
+    w->count = 0;
+    w->len = sizeof(TrackDeltaHeader);
+    w->prev_id = w->prev_lat = w->prev_lon = 0;
+}
+
+// 작성 중인 프레임을 마감해 미뤄 두고 (먼저 미뤄 둔 프레임은 송출) 새 프레임 시작
+static void wire_writer_flush(WireDeltaWriter* w) {
+    if (w->count == 0) return;
+    TrackDeltaHeader header;
+    memset(&header, 0, sizeof(header));
+    header.frame.magic = TRACK_FRAME_MAGIC;
+    header.frame.version = TRACK_FRAME_VERSION_DELTA;
+    header.frame.flags = w->flags;
+    header.frame.seq = w->enc->next_seq++;
+    header.frame.tick = w->tick;
+    header.frame.count = w->count;
+    header.key_epoch = w->enc->key_epoch;
+    memcpy(w->frame, &header, sizeof(header));
+
+    wire_writer_send_pending(w, false);
+    memcpy(w->pending, w->frame, w->len);
+    w->pending_len = w->len;
+    wire_writer_reset(w);
+}
+
+// 레코드 하나를 쓸 자리 확보 (프레임 종류가 바뀌거나 최대 길이 레코드가 안 들어가면 새 프레임)
+static unsigned char* wire_writer_reserve(WireDeltaWriter* w, uint8_t flags) {
+    if (w->flags != flags || w->len + TRACK_DELTA_MAX_RECORD > TRACK_FRAME_MTU) {
+        wire_writer_flush(w);
+        w->flags = flags;
+    }
+    return w->frame + w->len;
+}
+
+static inline int32_t wire_diff(int32_t a, int32_t b) {
+    return (int32_t)((uint32_t)a - (uint32_t)b);       // 2의 보수 wrap (디코더도 wrap으로 더함)
+}
+
+static inline int wire_put_signed(unsigned char* out, int32_t v) {
+    return packet_put_varint(out, packet_zigzag(v));
+}
+
+static inline int32_t wire_quantize(double deg) {
+    return (int32_t)llround(deg * TRACK_COORD_SCALE);
+}
+
+// 키프레임 레코드: [id 차분] [위도 차분] [경도 차분] [위협도] [상태] (차분 = 프레임 안 앞 레코드 대비)
+static void wire_write_keyframe(WireDeltaWriter* w, int32_t id, int32_t lat_q, int32_t lon_q, int32_t threat) {
+    unsigned char* out = wire_writer_reserve(w, TRACK_FRAME_FLAG_KEYFRAME);
+    int n = wire_put_signed(out, wire_diff(id, w->prev_id));
+    n += wire_put_signed(out + n, wire_diff(lat_q, w->prev_lat));
+    n += wire_put_signed(out + n, wire_diff(lon_q, w->prev_lon));
+    n += packet_put_varint(out + n, (uint32_t)threat);
+    out[n++] = TRACK_STATUS_ACTIVE;
+    w->prev_id = id; w->prev_lat = lat_q; w->prev_lon = lon_q;
+    w->len += (size_t)n;
+    w->count++;
+}
+
+// 차분 레코드: [id 차분] [마스크] [마스크 필드...] (좌표는 기준 상태 대비, ABSOLUTE면 절대값)
+static void wire_write_delta(WireDeltaWriter* w, int32_t id, uint8_t mask, int32_t lat, int32_t lon, int32_t threat, uint8_t status) {
+    unsigned char* out = wire_writer_reserve(w, 0);
+    int n = wire_put_signed(out, wire_diff(id, w->prev_id));
+    out[n++] = mask;
+    if (mask & TRACK_DELTA_LAT) n += wire_put_signed(out + n, lat);
+    if (mask & TRACK_DELTA_LON) n += wire_put_signed(out + n, lon);
+    if (mask & TRACK_DELTA_THREAT) n += packet_put_varint(out + n, (uint32_t)threat);
+    if (mask & TRACK_DELTA_STATUS) out[n++] = status;
+    w->prev_id = id;
+    w->len += (size_t)n;
+    w->count++;
+}
+
+/* =================================================================
+   [5] v2 Broadcast
+================================================================= */
+
+/**
+ * @brief v2 송출: 키프레임이면 모든 표적의 기준 상태, 아니면 기준 상태와 다른 필드만
+ * @note  차분 틱에서 기준 상태와 같고 직전에도 같다고 보낸 표적은 레코드를 생략합니다.
+ *        테이블에 남아 있지만 이번에 보이지 않은 표적은 요격 레코드(상태 0)로 알리며,
+ *        다음 키프레임까지 (그리고 최소 WIRE_REMOVAL_REPEAT번) 반복합니다.
+ */
+static size_t wire_broadcast_delta(WireEncoder* enc, const LiveTable* live, uint32_t tick, WireSink sink, void* ctx) {
+    uint32_t stamp = ++enc->broadcasts;     // 이번 브로드캐스트에 본 표적의 seen 값
+    int interval = enc->keyframe_interval > 0 ? enc->keyframe_interval : 1;
+    bool keyframe = (enc->base == NULL || (stamp - 1) % (uint32_t)interval == 0);
+    if (keyframe) {
+        // 키프레임마다 오래전에 사라진 표적을 비움 (직전까지 있던 표적은 남겨야 이번에 사라졌는지 알 수 있음)
+        if (!wire_base_rebuild(enc, live->count + enc->base_count, stamp, WIRE_REMOVAL_REPEAT)) {
+            enc->broadcasts--;
+            return wire_broadcast_framed(enc, live, tick, sink, ctx);      // 기준 상태 없이 v1로 송출
+        }
+        enc->key_epoch++;
+    }
+
+    WireDeltaWriter writer;
+    WireDeltaWriter* w = &writer;
+    w->enc = enc; w->sink = sink; w->ctx = ctx; w->tick = tick;
+    w->flags = keyframe ? TRACK_FRAME_FLAG_KEYFRAME : 0;
+    w->pending_len = 0;
+    w->sent = 0;
+    wire_writer_reset(w);
+
+    bool complete = true;
+    for (size_t i = 0; i < live->count; i++) {
+        if (enc->base_count + 1 > enc->base_capacity / 4 * 3 && !wire_base_rebuild(enc, enc->base_count * 2, stamp, UINT32_MAX)) {
+            complete = false;       // 새 표적용 자리 부족 (경고 출력됨): 나머지 표적은 다음 틱에
+            break;
+        }
+
+        int32_t id = live->id[i];
+        int32_t lat_q = wire_quantize(live->lat[i]);
+        int32_t lon_q = wire_quantize(live->lon[i]);
+        int32_t threat = live->threat[i];
+        WireBaseline* e = wire_base_probe(enc, id);
+        if (e->seen == 0) {
+            e->id = id;
+            enc->base_count++;
+        }
+        bool continuing = (e->seen + 1 == stamp);      // 직전 브로드캐스트에도 있었음 (새 표적이나 되살아난 ID가 아님)
+        e->seen = stamp;
+
+        if (keyframe) {
+            e->lat_q = lat_q; e->lon_q = lon_q; e->threat = threat;
+            e->has_base = true;
+            e->last_mask = 0;
+            wire_write_keyframe(w, id, lat_q, lon_q, threat);
+            continue;
+        }
+        if (!continuing) e->has_base = false;
+        if (!e->has_base) {
+            wire_write_delta(w, id, TRACK_DELTA_ABSOLUTE | TRACK_DELTA_LAT | TRACK_DELTA_LON | TRACK_DELTA_THREAT | TRACK_DELTA_STATUS,
+                             lat_q, lon_q, threat, TRACK_STATUS_ACTIVE);
+            continue;
+        }
+        uint8_t mask = 0;
+        if (lat_q != e->lat_q) mask |= TRACK_DELTA_LAT;
+        if (lon_q != e->lon_q) mask |= TRACK_DELTA_LON;
+        if (threat != e->threat) mask |= TRACK_DELTA_THREAT;
+        if (mask == 0 && e->last_mask == 0) continue;
+        e->last_mask = mask;
+        wire_write_delta(w, id, mask, wire_diff(lat_q, e->lat_q), wire_diff(lon_q, e->lon_q), threat, TRACK_STATUS_ACTIVE);
+    }
+
+    // 테이블에 있지만 이번에 보이지 않은 표적 = 사라짐 (테이블의 표적 ID는 모두 다르므로 수가 같으면 생략)
+    if (complete && enc->base_count > live->count) {
+        for (size_t s = 0; s < enc->base_capacity; s++) {
+            WireBaseline* e = &enc->base[s];
+            if (e->seen == 0 || e->seen == stamp) continue;
+            e->has_base = false;
+            wire_write_delta(w, e->id, TRACK_DELTA_STATUS, 0, 0, 0, 0);     // TargetPacket.status 규약: 0 = 격추됨
+        }
+    }
+
+    wire_writer_flush(w);
+    wire_writer_send_pending(w, true);
+    return w->sent;
+}
+
+/**
+ * @brief 활성 표적 전체를 데이터그램으로 만들어 sink로 넘김 (틱당 한 번)
+ * @param tick 프레임 머리에 적을 시뮬레이션 틱 번호
+ * @return 이번에 만든 데이터그램 수 (보낼 것이 없으면 0)
+ * @note  프레임 버퍼는 스택에 두므로, 표적 수에 비례하는 할당은 v2 기준 상태 테이블 재구축(키프레임마다)뿐입니다.
+ */
+size_t wire_broadcast(WireEncoder* enc, const LiveTable* live, uint32_t tick, WireSink sink, void* ctx) {
+    size_t sent;
+    switch (enc->mode) {
+    case WIRE_MODE_PER_TRACK: sent = wire_broadcast_per_track(enc, live, sink, ctx); break;
+    case WIRE_MODE_FRAMED:    sent = wire_broadcast_framed(enc, live, tick, sink, ctx); break;
+    default:                  sent = wire_broadcast_delta(enc, live, tick, sink, ctx); break;
+    }
+    enc->datagrams += sent;
+    return sent;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file    worker_pool.c
+ * @brief   Worker Pool for the Parallel Simulation Tick
+ * @details 엔진 수명 동안 상주하는 pthread 작업자들이 한 틱의 작업을 청크 단위로 나눠 처리합니다.
+ *          호출 스레드도 청크를 가져가 함께 일하고, 모든 작업자가 끝나야 worker_pool_run이 반환되므로
+ *          호출 측에서는 일반 함수 호출처럼 동작합니다 (fork-join).
+ */
+
+#include "common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* =================================================================
+   [1] Worker Loop
+================================================================= */
+
+/**
+ * @brief 남은 청크가 없을 때까지 가져와 처리
+ */
+static void worker_drain(WorkerPool* pool) {
+    for (;;) {
+        size_t begin = atomic_fetch_add(&pool->next, pool->chunk);
+        if (begin >= pool->total) return;
+        size_t end = begin + pool->chunk < pool->total ? begin + pool->chunk : pool->total;
+        pool->task(pool->ctx, begin, end);
+    }
+}
+
+static void* worker_main(void* arg) {
+    WorkerPool* pool = (WorkerPool*)arg;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stopping && pool->generation == seen) pthread_cond_wait(&pool->start_cv, &pool->lock);
+        if (pool->stopping) break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        worker_drain(pool);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done_cv);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* =================================================================
+   [2] Lifecycle
+================================================================= */
+
+/**
+ * @brief 작업자 thread_count - 1개를 띄움 (호출 스레드가 나머지 하나)
+ * @note  스레드 생성에 실패하면 띄운 만큼만으로 계속 동작합니다 (최소 1 = 직렬).
+ */
+bool worker_pool_init(WorkerPool* pool, int thread_count) {
+    if (thread_count < 1) thread_count = 1;
+
+    pool->threads = NULL;
+    pool->thread_count = 1;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stopping = false;
+    pool->task = NULL;
+    pool->ctx = NULL;
+    pool->total = 0;
+    pool->chunk = 1;
+    atomic_init(&pool->next, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+    if (thread_count == 1) return true;
+
+    pool->threads = (pthread_t*)malloc(sizeof(pthread_t) * (size_t)(thread_count - 1));
+    if (pool->threads == NULL) {
+        printf("[FATAL ERROR] Memory allocation failed for worker pool.\n");
+        return false;
+    }
+    for (int i = 0; i < thread_count - 1; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            printf("[WARN] Worker thread %d failed to start. Running with %d thread(s).\n",
+                   i + 1, pool->thread_count);
+            return false;
+        }
+        pool->thread_count++;
+    }
+    return true;
+}
+
+/**
+ * @brief 작업자를 모두 종료시키고 자원 해제
+ */
+void worker_pool_free(WorkerPool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->start_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->thread_count - 1; i++) pthread_join(pool->threads[i], NULL);
+    free(pool->threads);
+    pool->threads = NULL;
+    pool->thread_count = 1;
+
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_cond_destroy(&pool->start_cv);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+/* =================================================================
+   [3] Dispatch
+================================================================= */
+
+/**
+ * @brief 행 [0, total)을 chunk 크기로 나눠 모든 작업자가 task를 실행하고, 전부 끝나면 반환
+ * @param pool NULL이거나 작업자가 1개면 호출 스레드에서 한 번에 실행
+ * @note  한 청크는 항상 한 작업자만 처리하므로, 행 단위로 상태가 분리된 작업은 잠금이 필요 없습니다.
+ */
+void worker_pool_run(WorkerPool* pool, size_t total, size_t chunk, WorkerTask task, void* ctx) {
+    if (total == 0) return;
+    if (pool == NULL || pool->thread_count <= 1) {
+        // 직렬 실행도 같은 청크 경계로 잘라 스레드 수와 결과를 일치시킴
+        for (size_t begin = 0; begin < total; begin += chunk) {
+            task(ctx, begin, begin + chunk < total ? begin + chunk : total);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->total = total;
+    pool->chunk = chunk;
+    atomic_store(&pool->next, 0);
+    pool->pending = pool->thread_count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    worker_drain(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) pthread_cond_wait(&pool->done_cv, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}